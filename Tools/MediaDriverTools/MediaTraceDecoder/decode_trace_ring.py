@@ -0,0 +1,151 @@
+#
+# Copyright (c) 2022, Intel Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+# Convert the binary file written by the ring buffer trace backend
+# (GFX_MEDIA_TRACE_RING=<path>) into Chrome trace JSON, which can be opened
+# by chrome://tracing or https://ui.perfetto.dev.
+#
+# usage: decode_trace_ring.py <trace file> [-o out.json] [-e mos_os_trace_event.h]
+
+import os, sys, re, json, struct
+import argparse
+
+FILE_MAGIC       = 0x52544D49  # IMTR
+EVENT_MAGIC      = 0x494D5445  # IMTE
+FILE_HEADER_FMT  = '<IHHIIQQQQQQ'
+FILE_HEADER_V2_FMT = FILE_HEADER_FMT + 'Q'
+RECORD_HEADER_FMT = '<QII'
+EVENT_HEADER_FMT = '<III'
+
+EVENT_TYPE_INFO  = 0
+EVENT_TYPE_START = 1
+EVENT_TYPE_END   = 2
+EVENT_TYPE_INFO2 = 3
+
+def load_event_names(header_file):
+    names = {}
+    if not header_file or not os.path.isfile(header_file):
+        return names
+    with open(header_file, 'r', errors='ignore') as fh:
+        text = fh.read()
+    m = re.search(r'typedef\s+enum\s+_MEDIA_EVENT\s*\{(.*?)\}\s*MEDIA_EVENT\s*;', text, re.S)
+    if not m:
+        return names
+    value = -1
+    for line in m.group(1).splitlines():
+        line = line.split('//')[0].strip().rstrip(',')
+        if not line:
+            continue
+        if '=' in line:
+            name, expr = [s.strip() for s in line.split('=', 1)]
+            value = int(expr, 0)
+        else:
+            name = line
+            value += 1
+        names[value] = name
+    return names
+
+def decode(trace_file, event_names):
+    with open(trace_file, 'rb') as fh:
+        data = fh.read()
+
+    hdr_size = struct.calcsize(FILE_HEADER_FMT)
+    if len(data) < hdr_size:
+        raise ValueError('file too small')
+    (magic, version, header_size, pid, _, base_ticks, base_ns,
+     end_ticks, end_ns, data_size, dropped) = struct.unpack_from(FILE_HEADER_FMT, data, 0)
+    if magic != FILE_MAGIC:
+        raise ValueError('not a media trace ring file')
+    ticks_per_sec = 0
+    if version >= 2 and header_size >= struct.calcsize(FILE_HEADER_V2_FMT):
+        ticks_per_sec = struct.unpack_from(FILE_HEADER_V2_FMT, data, 0)[-1]
+
+    # ticks per ns from the TSC/monotonic pairs captured at init and close,
+    # or from the rate measured at init if the file was never finalized
+    if end_ns > base_ns and end_ticks > base_ticks:
+        ticks_per_ns = float(end_ticks - base_ticks) / float(end_ns - base_ns)
+    elif ticks_per_sec:
+        ticks_per_ns = ticks_per_sec / 1e9
+    else:
+        raise ValueError('timestamp rate unknown: file was not finalized and has no tick rate in its header')
+    if data_size == 0:
+        # file not finalized, process did not exit cleanly
+        data_size = len(data) - header_size
+
+    events = []
+    rec_size = struct.calcsize(RECORD_HEADER_FMT)
+    evt_size = struct.calcsize(EVENT_HEADER_FMT)
+    offset = header_size
+    end = min(len(data), header_size + data_size)
+    while offset + rec_size <= end:
+        ticks, tid, size = struct.unpack_from(RECORD_HEADER_FMT, data, offset)
+        if size == 0 and ticks == 0:
+            break
+        payload = data[offset + rec_size:offset + rec_size + size]
+        offset += (rec_size + size + 7) & ~7
+        if len(payload) < evt_size:
+            continue
+        tag, id_size, evt_type = struct.unpack_from(EVENT_HEADER_FMT, payload, 0)
+        if tag != EVENT_MAGIC:
+            continue
+        evt_id = id_size >> 16
+        args = payload[evt_size:evt_size + (id_size & 0xffff)]
+
+        ts_us = (ticks - base_ticks) / ticks_per_ns / 1000.0
+        evt = {
+            'name': event_names.get(evt_id, 'EVENT_%d' % evt_id),
+            'cat':  'media',
+            'pid':  pid,
+            'tid':  tid,
+            'ts':   ts_us,
+        }
+        if evt_type == EVENT_TYPE_START:
+            evt['ph'] = 'B'
+        elif evt_type == EVENT_TYPE_END:
+            evt['ph'] = 'E'
+        else:
+            evt['ph'] = 'i'
+            evt['s'] = 't'
+        if args:
+            evt['args'] = {'type': evt_type, 'data': args.hex()}
+        events.append(evt)
+
+    events.sort(key=lambda e: e['ts'])
+    meta = {'dropped': dropped, 'version': version}
+    return {'traceEvents': events, 'displayTimeUnit': 'ns', 'otherData': meta}
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert media driver ring trace to Chrome trace JSON')
+    parser.add_argument('trace', help='binary trace file written by the driver')
+    parser.add_argument('-o', '--output', help='output json file, default <trace>.json')
+    parser.add_argument('-e', '--events', help='path of mos_os_trace_event.h for event names',
+        default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+            '../../../media_common/agnostic/common/os/mos_os_trace_event.h'))
+    args = parser.parse_args()
+
+    result = decode(args.trace, load_event_names(args.events))
+    output = args.output if args.output else args.trace + '.json'
+    with open(output, 'w') as fh:
+        json.dump(result, fh)
+    print('%d events written to %s, %d dropped' % (len(result['traceEvents']), output, result['otherData']['dropped']))
+
+if __name__ == '__main__':
+    main()
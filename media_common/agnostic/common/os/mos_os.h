@@ -441,6 +441,7 @@ typedef struct _MOS_GFXRES_FLAGS
     int32_t         bFlipChain;
     int32_t         bSVM;
     int32_t         bCacheable;
+    int32_t         bPersistentMap;                                             //!< [in] Linear buffer locked by CPU every frame, kept mapped until free
 } MOS_GFXRES_FLAGS, *PMOS_GFXRES_FLAGS;
 
 //!
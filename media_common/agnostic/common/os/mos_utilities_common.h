@@ -413,6 +413,7 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __VPHAL_DBG_SURF_DUMP_END_FRAME_KEY_NAME_ID,
     __VPHAL_DBG_SURF_DUMPER_ENABLE_PLANE_DUMP,
     __VPHAL_DBG_SURF_DUMP_ENABLE_AUX_DUMP_ID,
+    __VPHAL_DBG_SURF_DUMP_ASYNC_QUEUE_DEPTH_ID,
     __VPHAL_DBG_SURF_DUMPER_RESOURCE_LOCK_ID,
     __VPHAL_DBG_STATE_DUMP_OUTFILE_KEY_NAME_ID,
     __VPHAL_DBG_STATE_DUMP_LOCATION_KEY_NAME_ID,
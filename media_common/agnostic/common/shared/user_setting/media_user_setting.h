@@ -129,6 +129,36 @@ public:
         const Value &customValue = Value(),
         bool useCustomValue = false);
 
+    //!
+    //! \brief    Read value of specific item by interned id
+    //! \param    [out] value
+    //!           The return value of the item
+    //! \param    [in] id
+    //!           Interned id of the item returned by GetSettingId
+    //! \param    [in] customValue
+    //!           The custom value when failed
+    //! \param    [in] useCustomValue
+    //!           Whether use costom value when failed
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if no error, otherwise will return failed reason
+    //!
+    MOS_STATUS Read(Value &value,
+        SettingId id,
+        const Value &customValue = Value(),
+        bool useCustomValue = false);
+
+    //!
+    //! \brief    Get the interned id of specific item
+    //! \details  Hot paths can look the id up once and read by id afterwards
+    //! \param    [in] valueName
+    //!           Name of the item
+    //! \param    [in] group
+    //!           Group of the item
+    //! \return   SettingId
+    //!           id of the item, InvalidSettingId if the item is not registered
+    //!
+    SettingId GetSettingId(const std::string &valueName, const Group &group);
+
     //!
     //! \brief    Write value to specific item
     //! \param    [in] valueName
@@ -236,6 +266,53 @@ inline MOS_STATUS ReadUserSetting(
     return status;
 }
 
+inline MOS_STATUS ReadUserSetting(
+    MediaUserSettingSharedPtr       userSetting,
+    MediaUserSetting::Value         &value,
+    MediaUserSetting::SettingId     id,
+    const MediaUserSetting::Value   &customValue = MediaUserSetting::Value(),
+    bool                            useCustomValue = false)
+{
+    MediaUserSettingSharedPtr  instance = userSetting;
+    if (userSetting == nullptr)
+    {
+        instance = MediaUserSetting::MediaUserSetting::Instance();
+    }
+    auto status = instance->Read(value, id, customValue, useCustomValue);
+    if(status != MOS_STATUS_SUCCESS)
+    {
+        MOS_OS_NORMALMESSAGE("User setting %u read error", id);
+    }
+    return status;
+}
+
+template <typename T>
+inline MOS_STATUS ReadUserSetting(
+    MediaUserSettingSharedPtr userSetting,
+    T                               &value,
+    MediaUserSetting::SettingId     id,
+    const MediaUserSetting::Value   &customValue = MediaUserSetting::Value(),
+    bool                            useCustomValue = false)
+{
+    MediaUserSetting::Value outValue;
+    MOS_STATUS  status = ReadUserSetting(userSetting, outValue, id, customValue, useCustomValue);
+    value = outValue.Get<T>();
+    return status;
+}
+
+inline MediaUserSetting::SettingId GetUserSettingId(
+    MediaUserSettingSharedPtr userSetting,
+    const std::string &valueName,
+    const MediaUserSetting::Group &group)
+{
+    MediaUserSettingSharedPtr instance = userSetting;
+    if (userSetting == nullptr)
+    {
+        instance = MediaUserSetting::MediaUserSetting::Instance();
+    }
+    return instance->GetSettingId(valueName, group);
+}
+
 inline MOS_STATUS WriteUserSetting(
     MediaUserSettingSharedPtr userSetting,
     const std::string &valueName,
@@ -28,6 +28,7 @@
 #define __MEDIA_USER_SETTING_CONFIGURE__H__
 
 #include <string>
+#include <atomic>
 #include "mos_utilities.h"
 #include "media_user_setting_value.h"
 #include "media_user_setting_definition.h"
@@ -123,6 +124,47 @@ public:
         const Value &customValue,
         bool useCustomValue = false);
 
+    //!
+    //! \brief    Read value of specific item by interned id
+    //! \details  The value resolved from the configure file is kept in a snapshot
+    //!           per item and base path, so a read after the first one is an array
+    //!           index. The snapshot is dropped when a value is written, including
+    //!           report writes, or the configure file is refreshed. Values set by
+    //!           environment variables are not kept and are read on every call.
+    //! \param    [out] value
+    //!           The return value of the item
+    //! \param    [in] id
+    //!           Interned id of the item returned by GetSettingId
+    //! \param    [in] customValue
+    //!           The custom value when failed
+    //! \param    [in] useCustomValue
+    //!           Whether use costom value when failed
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if no error,MOS_STATUS_USER_FEATURE_KEY_OPEN_FAILED if user setting is not set, otherwise will return specific failed reason
+    //!
+    MOS_STATUS Read(Value &value,
+        SettingId id,
+        const Value &customValue,
+        bool useCustomValue = false);
+
+    //!
+    //! \brief    Get the interned id of specific item
+    //! \param    [in] itemName
+    //!           Name of the item
+    //! \param    [in] group
+    //!           Group of the item
+    //! \return   SettingId
+    //!           id of the item, InvalidSettingId if the item is not registered
+    //!
+    SettingId GetSettingId(const std::string &itemName, const Group &group);
+
+    //!
+    //! \brief    Reload the configure file and drop the value snapshot
+    //! \details  Keys removed from the file are erased, values written by this
+    //!           process and not present in the file are kept
+    //!
+    void Refresh();
+
     //!
     //! \brief    Write value to specific item
     //! \param    [in] itemName
@@ -154,7 +196,7 @@ public:
     inline bool IsDefinitionExist(const std::string &itemName)
     {
         bool ret = false;
-        for (auto defs : m_definitions)
+        for (auto &defs : m_definitions)
         {
             auto it = defs.find(MakeHash(itemName));
             if (it != defs.end())
@@ -197,13 +239,92 @@ protected:
         return HashFunc(str);
     }
 
+    //!
+    //! \brief    Get the base key path the item is read from
+    //! \param    [in] def
+    //!           Definition of the item
+    //! \return   const char *
+    //!           the state path of the device for state path items, otherwise empty string
+    //!
+    const char *GetBasePath(const Definition &def) const
+    {
+        if (def.UseStatePath() && m_keyPathInfo != nullptr && m_keyPathInfo->Path != nullptr)
+        {
+            return m_keyPathInfo->Path;
+        }
+        return "";
+    }
+
+    //!
+    //! \brief    Resolve the value of specific item from environment and configure file
+    //! \param    [in] def
+    //!           Definition of the item
+    //! \param    [in] basePath
+    //!           Base key path of the item
+    //! \param    [out] value
+    //!           The value of the item if found
+    //! \param    [out] fromEnv
+    //!           Whether the value came from an environment variable
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if found, otherwise failed reason
+    //!
+    MOS_STATUS ReadFromStore(const Definition &def, const char *basePath, Value &value, bool &fromEnv);
+
+    //!
+    //! \brief    Poll the configure file watch and refresh if it changed
+    //!
+    void CheckRefresh();
+
+    //! \brief    Value resolved for one item, tagged with the snapshot generation
+    //!           and the base path it was read from
+    struct CachedValue
+    {
+        MOS_STATUS  status     = MOS_STATUS_SUCCESS;
+        Value       value      = {};
+        uint32_t    generation = 0;
+        std::string basePath   = "";
+    };
+
+    //! \brief    Entry of the interned id table
+    struct SettingSlot
+    {
+        std::shared_ptr<Definition>        def    = nullptr;
+        std::shared_ptr<const CachedValue> cached = nullptr;  //!< accessed with std::atomic_load/atomic_store
+    };
+
+    //!
+    //! \brief    Get the slot of specific id
+    //! \return   SettingSlot *
+    //!           slot of the id, nullptr if id is invalid
+    //!
+    SettingSlot *GetSlot(SettingId id)
+    {
+        if (id >= m_settingNum.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        SettingSlot *chunk = m_slotChunks[id / m_slotChunkSize].load(std::memory_order_acquire);
+        return chunk ? &chunk[id % m_slotChunkSize] : nullptr;
+    }
+
 protected:
+    static const uint32_t m_slotChunkSize        = 256;  //!< slots are allocated in chunks which never move
+    static const uint32_t m_maxSlotChunks        = 64;
+    static const uint32_t m_refreshCheckInterval = 256;  //!< reads between two polls of the file watch
+
     MosMutex m_mutexLock = {}; //!< mutex for protecting definitions
     Definitions m_definitions[Group::MaxCount]{}; //!< definitions of media user setting
     bool m_isDebugMode = false; //!< whether in debug/release-internal mode
     RegBufferMap m_regBufferMap{};
     MOS_USER_FEATURE_KEY_PATH_INFO *m_keyPathInfo = nullptr;
 
+    std::atomic<SettingSlot *> m_slotChunks[m_maxSlotChunks] = {};  //!< id table, indexed by SettingId
+    std::atomic<uint32_t>      m_settingNum{0};                     //!< number of interned ids
+    std::atomic<uint32_t>      m_generation{0};                     //!< snapshot generation, bumped on write and refresh
+    std::atomic<uint32_t>      m_readCount{0};                      //!< reads since creation, paces the file watch poll
+    int32_t                    m_regWatch = -1;                     //!< configure file watch, -1 if refresh is disabled
+    RegBufferMap               m_fileRegMap{};                      //!< configure file content at the last load, kept only with the watch
+
     static const UFKEY_NEXT m_rootKey;
     static const char *m_configPath;
     static const char *m_reportPath;
@@ -33,6 +33,15 @@
 #include "media_user_setting_value.h"
 
 namespace MediaUserSetting {
+
+//!
+//! \brief   Interned handle of a registered user setting item
+//! \details Assigned at registration and valid for the lifetime of the user
+//!          setting instance, reading by id skips the name lookup
+//!
+using SettingId = uint32_t;
+const SettingId InvalidSettingId = 0xFFFFFFFF;
+
 namespace Internal {
 
 class Definition
@@ -129,6 +138,20 @@ public:
     //!           the custom path
     //!
     bool UseStatePath() const { return m_statePath; }
+
+    //!
+    //! \brief    Get the interned id of the definition
+    //! \return   SettingId
+    //!           the id assigned at registration
+    //!
+    SettingId Id() const { return m_id; }
+
+    //!
+    //! \brief    Set the interned id of the definition
+    //! \param    [in] id
+    //!           the id assigned at registration
+    //!
+    void SetId(SettingId id) { m_id = id; }
 private:
     //!
     //! \brief    Set the values of definition
@@ -145,6 +168,7 @@ private:
     std::string m_subPath{};    //!< custome path is a relative path, it could be null
     UFKEY_NEXT m_rootKey{};    //!< root key
     bool m_statePath      = true;    //!< Whether the item read from a specific path
+    SettingId m_id        = InvalidSettingId;  //!< Interned id
 };
 
 using Definitions = std::map<std::size_t, std::shared_ptr<Definition>>;
@@ -3583,6 +3583,7 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
 {
 #if CM_KERNEL_PRINTF_ON
     FILE * streamOutFile = nullptr;
+    char * streamBuffer  = nullptr;
 
     if (filename == nullptr)
     {
@@ -3603,6 +3604,13 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
             CM_ASSERTMESSAGE("Error: Failed to open kernel print dump file.");
             return CM_FAILURE;
         }
+
+        // Write the dump in large chunks rather than one small write per printf record
+        streamBuffer = (char *)MOS_AllocMemory(PRINT_STREAM_BUFFER_SIZE);
+        if (streamBuffer)
+        {
+            setvbuf(streamOutFile, streamBuffer, _IOFBF, PRINT_STREAM_BUFFER_SIZE);
+        }
     }
 
     if( m_printBufferSize == 0 ||
@@ -3611,15 +3619,18 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
         CM_ASSERTMESSAGE("Error: Print buffer is not initialized.");
         if (filename && streamOutFile)
             fclose(streamOutFile);
+        MOS_FreeMemory(streamBuffer);
         return CM_FAILURE;
     }
 
     //Dump memory on the screen.
+    //Format strings are shared by all the buffers, so each of them is only parsed once.
+    PFParser::FormatCache formatCache;
     while(!m_printBufferMems.empty())
     {
         uint8_t *mem = m_printBufferMems.front();
         CmBufferUP *buffer = m_printBufferUPs.front();
-        DumpAllThreadOutput(streamOutFile, mem, m_printBufferSize);
+        DumpAllThreadOutput(streamOutFile, mem, m_printBufferSize, &formatCache);
         m_printBufferMems.pop_front();
         m_printBufferUPs.pop_front();
         DestroyBufferUP(buffer);
@@ -3633,6 +3644,7 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
         fclose(streamOutFile);
         streamOutFile = nullptr;
     }
+    MOS_FreeMemory(streamBuffer);
 
     return CM_SUCCESS;
 #else
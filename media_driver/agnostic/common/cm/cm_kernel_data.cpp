@@ -91,7 +91,8 @@ CmKernelData::CmKernelData(  CmKernelRT* kernel ):
     m_kerneldatasize( 0 ),
     m_kernel(kernel),
     m_refCount(0),
-    m_isInUse(true)
+    m_isInUse(true),
+    m_argSerial(0)
 {
    CmSafeMemSet(&m_halKernelParam, 0, sizeof(CM_HAL_KERNEL_PARAM));
    m_halKernelParam.samplerHeap = MOS_New( std::list<SamplerParam> );
@@ -51,6 +51,8 @@ public:
     bool IsInUse( void );
     uint32_t GetKernelCurbeSize( void );
     int32_t ResetStatus( void );
+    uint32_t GetArgSerial( void ) { return m_argSerial; }
+    void SetArgSerial( uint32_t serial ) { m_argSerial = serial; }
 
 protected:
 
@@ -67,6 +69,9 @@ protected:
     // if it is Ture, it means the task with this kernel is not flushed yet
     bool         m_isInUse;
 
+    // CmKernelRT kernel data serial of the arguments held
+    uint32_t     m_argSerial;
+
 private:
     CmKernelData (const CmKernelData& other);
     CmKernelData& operator= (const CmKernelData& other);
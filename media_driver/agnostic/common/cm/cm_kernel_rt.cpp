@@ -314,6 +314,8 @@ CmKernelRT::CmKernelRT(CmDeviceRT *device,
     m_dirty( CM_KERNEL_DATA_CLEAN ),
     m_lastKernelData( nullptr ),
     m_lastKernelDataSize( 0 ),
+    m_kernelDataSerial( 0 ),
+    m_kernelDataFullSerial( 0 ),
     m_indexInTask(0),
     m_threadSpaceAssociated(false),
     m_perThreadArgExists(false),
@@ -355,6 +357,11 @@ CmKernelRT::CmKernelRT(CmDeviceRT *device,
         m_globalCmIndex[i] = 0;
     }
 
+    for (int i = 0; i < CM_KERNEL_DATA_SPARE_COUNT; i++)
+    {
+        m_spareKernelData[i] = nullptr;
+    }
+
     m_blhwDebugEnable = program->IsHwDebugEnabled();
 
     CmSafeMemSet(m_pKernelPayloadSurfaceArray, 0, sizeof(m_pKernelPayloadSurfaceArray));
@@ -385,6 +392,14 @@ CmKernelRT::~CmKernelRT( void )
         CmKernelData::Destroy( m_lastKernelData );
     }
 
+    for (int i = 0; i < CM_KERNEL_DATA_SPARE_COUNT; i++)
+    {
+        if (m_spareKernelData[i])
+        {
+            CmKernelData::Destroy( m_spareKernelData[i] );
+        }
+    }
+
     if( m_device->CheckGTPinEnabled() && !m_blCreatingGPUCopyKernel)
     {
         MosSafeDeleteArray(m_binary);
@@ -3270,6 +3285,8 @@ int32_t CmKernelRT::DestroyArgs( void )
     m_sizeInPayload = 0;
     m_adjustScoreboardY = 0;
 
+    InvalidateSpareKernelData();
+
     ResetKernelSurfaces();
 
     return CM_SUCCESS;
@@ -3320,6 +3337,8 @@ int32_t CmKernelRT::Reset( void )
 
     m_threadGroupSpace = nullptr;
 
+    InvalidateSpareKernelData();
+
     MosSafeDeleteArray(m_kernelPayloadData);
     m_usKernelPayloadDataSize = 0;
 
@@ -3528,6 +3547,23 @@ int32_t CmKernelRT::CreateKernelData(
         return CM_INVALID_THREAD_SPACE;
     }
 
+    // Record the args changed by this enqueue, and whether anything else changed,
+    // which spare kernel data cannot be patched with
+    m_kernelDataSerial++;
+    for(uint32_t i = 0; i < m_argCount; i++)
+    {
+        if(m_args[i].isDirty)
+        {
+            m_args[i].dirtySerial = m_kernelDataSerial;
+        }
+    }
+    if((m_dirty & ~(CM_KERNEL_DATA_KERNEL_ARG_DIRTY | CM_KERNEL_DATA_THREAD_ARG_DIRTY)) ||
+       (m_threadSpace && m_threadSpace->GetDirtyStatus() != CM_THREAD_SPACE_CLEAN) ||
+       (threadSpace && threadSpace->IsThreadAssociated() && threadSpace->GetDirtyStatus() != CM_THREAD_SPACE_CLEAN))
+    {
+        m_kernelDataFullSerial = m_kernelDataSerial;
+    }
+
     if(m_lastKernelData == nullptr)
     {
         CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
@@ -3556,10 +3592,14 @@ int32_t CmKernelRT::CreateKernelData(
         else
         {
             if(m_lastKernelData->IsInUse())
-            { // Need to Create a new one , if the kernel data is in use
-                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
-                CM_CHK_CMSTATUS_GOTOFINISH(AcquireKernelProgram()); // increase kernel/program's ref count
-                CM_CHK_CMSTATUS_GOTOFINISH(UpdateLastKernelData(kernelData));
+            { // Patch a flushed spare, or create a new one, if the kernel data is in use
+                CM_CHK_CMSTATUS_GOTOFINISH(UpdateSpareKernelData(kernelData, kernelDataSize, threadSpace));
+                if(kernelData == nullptr)
+                {
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
+                    CM_CHK_CMSTATUS_GOTOFINISH(AcquireKernelProgram()); // increase kernel/program's ref count
+                    CM_CHK_CMSTATUS_GOTOFINISH(UpdateLastKernelData(kernelData));
+                }
             }
             else if(threadSpace && threadSpace->IsThreadAssociated() && (threadSpace->GetDirtyStatus() != CM_THREAD_SPACE_CLEAN))
             { // if thread space is assocaited , don't support reuse
@@ -3586,6 +3626,7 @@ int32_t CmKernelRT::CreateKernelData(
         }
     }
 
+    m_lastKernelData->SetArgSerial(m_kernelDataSerial);
     CleanArgDirtyFlag();
     if(threadSpace)
     {
@@ -3624,6 +3665,9 @@ int32_t CmKernelRT::CreateKernelData(
         usedThreadGroupSpace = const_cast<CmThreadGroupSpace*>(threadGroupSpace);
     }
 
+    // Spare kernel data is only patched for thread space enqueues
+    InvalidateSpareKernelData();
+
     if(m_lastKernelData == nullptr)
     {
         CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, usedThreadGroupSpace));
@@ -4938,12 +4982,47 @@ int32_t CmKernelRT::UpdateLastKernelData(
         return CM_NULL_POINTER;
     }
 
+    CSync* kernelLock = m_device->GetProgramKernelLock();
+    CLock locker(*kernelLock);
+
+    // Release spare kernel data which can no longer be patched
+    for(uint32_t i = 0; i < CM_KERNEL_DATA_SPARE_COUNT; i++)
+    {
+        if(m_spareKernelData[i] &&
+           (int32_t)(m_spareKernelData[i]->GetArgSerial() - m_kernelDataFullSerial) < 0)
+        {
+            CmKernelData::Destroy(m_spareKernelData[i]);
+            m_spareKernelData[i] = nullptr;
+        }
+    }
+
+    // Keep the replaced kernel data as spare, in place of the oldest one if all are taken
+    if(m_lastKernelData &&
+       (int32_t)(m_lastKernelData->GetArgSerial() - m_kernelDataFullSerial) >= 0)
+    {
+        uint32_t spareIndex = 0;
+        for(uint32_t i = 0; i < CM_KERNEL_DATA_SPARE_COUNT; i++)
+        {
+            if(m_spareKernelData[i] == nullptr)
+            {
+                spareIndex = i;
+                break;
+            }
+            if((int32_t)(m_spareKernelData[i]->GetArgSerial() - m_spareKernelData[spareIndex]->GetArgSerial()) < 0)
+            {
+                spareIndex = i;
+            }
+        }
+
+        CmKernelData *replacedData = m_spareKernelData[spareIndex];
+        m_spareKernelData[spareIndex] = m_lastKernelData;
+        m_lastKernelData = replacedData;
+    }
+
     if(m_lastKernelData)
     {
         CmKernelData::Destroy(m_lastKernelData); // reduce ref count or delete it
     }
-    CSync* kernelLock = m_device->GetProgramKernelLock();
-    CLock locker(*kernelLock);
     m_lastKernelData = kernelData;
     m_lastKernelData->Acquire();
     m_lastKernelDataSize = m_lastKernelData->GetKernelDataSize();
@@ -4951,6 +5030,93 @@ int32_t CmKernelRT::UpdateLastKernelData(
     return hr;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Patch a flushed spare kernel data with the args changed since it
+//|             was last updated, and make it the last kernel data.
+//| Returns:    Result of the operation. kernelData is nullptr if no spare
+//|             kernel data can be patched.
+//*-----------------------------------------------------------------------------
+int32_t CmKernelRT::UpdateSpareKernelData(
+    CmKernelData* & kernelData,          // out
+    uint32_t& kernelDataSize,            // out
+    const CmThreadSpaceRT* threadSpace)  // in
+{
+    int32_t              hr             = CM_SUCCESS;
+    CmKernelData         *spareData     = nullptr;
+    PCM_HAL_KERNEL_PARAM halKernelParam = nullptr;
+    PCM_HAL_KERNEL_PARAM lastKernelParam = nullptr;
+    bool                 bbReusable     = false;
+    uint32_t             spareIndex     = 0;
+
+    kernelData = nullptr;
+
+    for(spareIndex = 0; spareIndex < CM_KERNEL_DATA_SPARE_COUNT; spareIndex++)
+    {
+        spareData = m_spareKernelData[spareIndex];
+        if(spareData && !spareData->IsInUse() &&
+           (int32_t)(spareData->GetArgSerial() - m_kernelDataFullSerial) >= 0)
+        {
+            break;
+        }
+    }
+    if(spareIndex == CM_KERNEL_DATA_SPARE_COUNT)
+    {
+        return CM_SUCCESS;
+    }
+
+    // Args changed by the enqueues since the spare was last updated
+    for(uint32_t i = 0; i < m_argCount; i++)
+    {
+        if((int32_t)(m_args[i].dirtySerial - spareData->GetArgSerial()) > 0)
+        {
+            m_args[i].isDirty = true;
+        }
+    }
+
+    // Thread args match the last kernel data if this enqueue did not change them,
+    // so the spare can share its batch buffer
+    bbReusable = IsBatchBufferReusable(const_cast<CmThreadSpaceRT *>(threadSpace));
+    CM_CHK_CMSTATUS_GOTOFINISH(UpdateKernelData(spareData, threadSpace));
+    if(bbReusable)
+    {
+        halKernelParam  = spareData->GetHalCmKernelData();
+        lastKernelParam = m_lastKernelData->GetHalCmKernelData();
+        CM_CHK_NULL_GOTOFINISH_CMERROR(halKernelParam);
+        CM_CHK_NULL_GOTOFINISH_CMERROR(lastKernelParam);
+        halKernelParam->kernelId = lastKernelParam->kernelId;
+    }
+
+    {
+        CSync* kernelLock = m_device->GetProgramKernelLock();
+        CLock locker(*kernelLock);
+        m_spareKernelData[spareIndex] = m_lastKernelData;
+        m_lastKernelData = spareData;
+        m_lastKernelDataSize = m_lastKernelData->GetKernelDataSize();
+    }
+
+    kernelData = m_lastKernelData;
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireKernelData(kernelData));
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireKernelProgram()); // increase kernel and program's ref count
+    kernelDataSize = kernelData->GetKernelDataSize();
+
+finish:
+    if(hr != CM_SUCCESS)
+    {
+        // The spare may be partially patched
+        InvalidateSpareKernelData();
+    }
+    return hr;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Prevent spare kernel data from being patched, after a change
+//|             which is not tracked per arg.
+//*-----------------------------------------------------------------------------
+void CmKernelRT::InvalidateSpareKernelData()
+{
+    m_kernelDataFullSerial = m_kernelDataSerial + 1;
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Wrapper of  CmKernelData::Destroy.
 //| Returns:    Result of the operation.
@@ -5166,6 +5332,7 @@ CM_RT_API int32_t CmKernelRT::AssociateThreadSpace(CmThreadSpace *&threadSpace)
     {
         m_threadSpace->SetDirtyStatus( CM_THREAD_SPACE_DATA_DIRTY);
     }
+    InvalidateSpareKernelData();
 
     return CM_SUCCESS;
 }
@@ -5232,6 +5399,7 @@ CM_RT_API int32_t CmKernelRT::DeAssociateThreadSpace(CmThreadSpace * &threadSpac
             return CM_INVALID_ARG_VALUE;
         }
         m_threadSpace = nullptr;
+        InvalidateSpareKernelData();
     }
 
     return CM_SUCCESS;
@@ -31,6 +31,8 @@
 #include "cm_hal.h"
 #include "cm_log.h"
 
+#define CM_KERNEL_DATA_SPARE_COUNT 4  // flushed-out kernel data kept for argument patching
+
 enum SURFACE_KIND
 {
     DATA_PORT_SURF,
@@ -60,6 +62,7 @@ struct CM_ARG
     uint16_t unitOffsetInPayloadOrig; // used to restore unitOffsetInPayload in adding move instruction for CURBE
     bool isDirty;      // used to indicate if its value be changed
     bool isSet;        // used to indicate if this argument is set correctly
+    uint32_t dirtySerial;   // kernel data serial of the enqueue which last saw it dirty
     uint32_t nCustomValue;  // CM defined value for special argument kind
 
     uint32_t aliasIndex;    // CmSurface2D alias index
@@ -89,6 +92,7 @@ struct CM_ARG
         unitOffsetInPayload = 0;
         value = nullptr;
         isDirty = false;
+        dirtySerial = 0;
         isNull = false;
         unitVmeArraySize = 0;
         surfIndex = nullptr;
@@ -364,6 +368,12 @@ protected:
 
     int32_t UpdateLastKernelData(CmKernelData *&kernelData);
 
+    int32_t UpdateSpareKernelData(CmKernelData *&kernelData,
+                                  uint32_t &kernelDataSize,
+                                  const CmThreadSpaceRT *threadSpace);
+
+    void InvalidateSpareKernelData();
+
     int32_t CreateKernelIndirectData(
         PCM_HAL_INDIRECT_DATA_PARAM halIndirectData);
 
@@ -469,6 +479,12 @@ protected:
     CmKernelData *m_lastKernelData;
     uint32_t m_lastKernelDataSize;
 
+    // Kernel data replaced while still in use is kept, and later patched with the
+    // arguments changed since, instead of rebuilding the whole kernel data.
+    CmKernelData *m_spareKernelData[CM_KERNEL_DATA_SPARE_COUNT];
+    uint32_t m_kernelDataSerial;      // incremented by each CreateKernelData
+    uint32_t m_kernelDataFullSerial;  // serial of the last change spare kernel data cannot be patched with
+
     uint32_t m_indexInTask;
     bool m_threadSpaceAssociated;  // Indicates if this kernel is associated the task threadspace
                             // (scoreboard)
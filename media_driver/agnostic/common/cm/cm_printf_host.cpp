@@ -28,6 +28,7 @@
 
 #if CM_KERNEL_PRINTF_ON
 
+#include <string.h>
 #include "cm_debug.h"
 
 void PFParser::getToken(void)
@@ -55,7 +56,11 @@ void PFParser::getToken(void)
                         break;
                     }
                     // This IS %% so take another character off the input
-                    mCurrToken.mTokenString += *mCurrLoc++;
+                    // A trailing % is kept as is, so don't step over the terminator
+                    if (*(mCurrLoc+1) == '%')
+                    {
+                        mCurrToken.mTokenString += *mCurrLoc++;
+                    }
                 }
                 mCurrToken.mTokenString += *mCurrLoc++;
             }
@@ -271,10 +276,84 @@ int PFParser::format(void)
         {
             return directive();
         }
+        else
+        {
+            // Left over from a directive without conversion, e.g. the 'd' of "%h5d"
+            error();
+            getToken();
+        }
     }
     return 0;
 }
 
+void PFParser::compile(const char *input, CompiledFormat &compiled)
+{
+    bool unsupported = mUnsupported;
+    bool err         = mError;
+
+    mInSpec     = false;
+    mCurrToken  = Token();
+    mInputStart = mCurrLoc = input;
+    // Prime the system with the first token
+    getToken();
+    compiled.firstEnd   = mCurrLoc - input;
+    compiled.firstToken = mCurrToken.mTokenType;
+
+    // Every call of format() consumes at least one token until End or Error is reached,
+    // after which it returns 0 without any change
+    while (mCurrToken != Token::End && mCurrToken != Token::Error)
+    {
+        mUnsupported = mError = false;
+
+        Directive directive;
+        directive.numArgs     = format();
+        directive.end         = mCurrLoc - input;
+        directive.nextToken   = mCurrToken.mTokenType;
+        directive.unsupported = mUnsupported;
+        directive.error       = mError;
+        compiled.directives.push_back(directive);
+    }
+
+    mUnsupported = unsupported;
+    mError       = err;
+}
+
+void PFParser::setStart(const char *start)
+{
+    // The format string is not guaranteed to be terminated within its record
+    std::string input(start, strnlen(start, PRINT_FORMAT_STRING_SIZE));
+
+    auto it = mFormatCache->find(input);
+    if (it == mFormatCache->end())
+    {
+        it = mFormatCache->emplace(input, CompiledFormat()).first;
+        compile(it->first.c_str(), it->second);
+    }
+
+    mFormat        = &it->second;
+    mInputBase     = it->first.c_str();
+    mNextDirective = 0;
+    mInputStart    = mInputBase;
+    mCurrLoc       = mInputBase + mFormat->firstEnd;
+    mCurrToken.mTokenType = mFormat->firstToken;
+}
+
+int PFParser::nextDirective(void)
+{
+    if (mFormat == nullptr || mNextDirective >= mFormat->directives.size())
+    {
+        // No format string yet, or End or Error reached
+        return 0;
+    }
+
+    const Directive &directive = mFormat->directives[mNextDirective++];
+    mCurrLoc              = mInputBase + directive.end;
+    mCurrToken.mTokenType = directive.nextToken;
+    mUnsupported         |= directive.unsupported;
+    mError               |= directive.error;
+    return directive.numArgs;
+}
+
 int PFParser::directive(void)
 {
     int numArgs = 0;
@@ -535,7 +614,7 @@ void PFParser::flush(void)
             // Tidy up any remaining characters
             // Any characters that remain to be flushed need to be check for illegal directives (e.g. %n
             // will cause an exception if attempted to be printed with no argument)
-            int numArgs = format();
+            int numArgs = nextDirective();
             if (mUnsupported)
             {
                 CM_PRINTF(mStreamOut,"Unsupported (but valid C++11) format string used : %s", mInputStart);
@@ -570,7 +649,7 @@ PRINT_FMT_STATUS PFParser::GetNextFmtToken(char* tkn, size_t size)
         if (!mArgsExpected)
         {
             // Copy the whole of the format string into the token
-            if ((size_t)(mCurrLoc - mInputStart) <= size)
+            if ((size_t)(mCurrLoc - mInputStart) < size)
             {
                 memcpy(tkn, mInputStart, mCurrLoc - mInputStart);
                 tkn[mCurrLoc - mInputStart] = '\0';
@@ -582,7 +661,7 @@ PRINT_FMT_STATUS PFParser::GetNextFmtToken(char* tkn, size_t size)
         return PF_SUCCESS;
     }
 
-    int numArgs = format();
+    int numArgs = nextDirective();
     switch (numArgs)
     {
     default:
@@ -590,7 +669,7 @@ PRINT_FMT_STATUS PFParser::GetNextFmtToken(char* tkn, size_t size)
     case 0:
     case 1:
         // Copy the whole of the format string into the token
-        if ((size_t)(mCurrLoc - mInputStart) <= size)
+        if ((size_t)(mCurrLoc - mInputStart) < size)
         {
             memcpy(tkn, mInputStart, mCurrLoc - mInputStart);
             tkn[mCurrLoc - mInputStart] = '\0';
@@ -888,10 +967,11 @@ void PFParser::DumpMemory(unsigned char * memory)
     }
 }
 
-void DumpAllThreadOutput(FILE *streamout, unsigned char * dumpMem, size_t buffersize)
+void DumpAllThreadOutput(FILE *streamout, unsigned char * dumpMem, size_t buffersize,
+                         PFParser::FormatCache *formatCache)
 {
     unsigned int off                =   PRINT_BUFFER_HEADER_SIZE;
-    PFParser     pState(streamout);
+    PFParser     pState(streamout, formatCache);
 
     while(1)
     {
@@ -31,6 +31,8 @@
 #if CM_KERNEL_PRINTF_ON
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #define PRINT_HEADER_SIZE 32
 
@@ -68,6 +70,7 @@
 #define PRINT_PAYLOAD_ALIGN         16
 #define PRINT_HEADER_SIZE           32
 #define PRINT_FORMAT_STRING_SIZE    128
+#define PRINT_STREAM_BUFFER_SIZE    (1 << 20)
 #define CM_PRINT_SIZE_WITH_PAYLOAD(msize) (PRINT_HEADER_SIZE + (msize-1) / PRINT_PAYLOAD_ALIGN * PRINT_PAYLOAD_ALIGN + PRINT_PAYLOAD_ALIGN)
 
 /// Structure of header:
@@ -185,18 +188,23 @@ enum  PRINT_FMT_STATUS
 // G_CONV    : 'G'
 // n_CONV    : 'n'
 // p_CONV    : 'p'
+//
+// Each distinct format string is only lexed and parsed once, when it is first seen. The parse
+// is recorded as the list of directives format() returns one by one, and every later record
+// using the same format string replays that list instead of parsing again.
 
 class PFParser
 {
 public:
-    PFParser(FILE* streamout) : mInSpec(false), mInputStart(nullptr), mCurrLoc(nullptr), mArgsExpected(0),
-                 mNumMultArg(0), mUnsupported(false), mError(false), mStreamOut(streamout) {};
-    void setStart(char *start)
-    {
-        mInputStart= mCurrLoc = start;
-        // Prime the system with the first token
-        getToken();
-    }
+    struct CompiledFormat;
+    // Compiled formats keyed by format string, can be shared by the parsers of several buffers
+    typedef std::unordered_map<std::string, CompiledFormat> FormatCache;
+
+    PFParser(FILE* streamout, FormatCache *formatCache = nullptr) : mInSpec(false), mInputStart(nullptr),
+                 mCurrLoc(nullptr), mArgsExpected(0), mNumMultArg(0), mUnsupported(false), mError(false),
+                 mStreamOut(streamout), mFormatCache(formatCache ? formatCache : &mLocalFormatCache),
+                 mFormat(nullptr), mInputBase(nullptr), mNextDirective(0) {};
+    void setStart(const char *start);
     void DumpMemory(unsigned char * memory);
     void flush(void);
 
@@ -232,11 +240,30 @@ private:
         int mTokenInt;
     };
 
+    // Parser state after one call of format() on a format string
+    struct Directive
+    {
+        size_t           end;         // Offset of mCurrLoc
+        Token::TokenType nextToken;   // Type of mCurrToken
+        int              numArgs;     // Value returned by format()
+        bool             unsupported; // format() set mUnsupported
+        bool             error;       // format() set mError
+    };
+
+public:
+    struct CompiledFormat
+    {
+        size_t                 firstEnd;   // Offset of mCurrLoc once primed with the first token
+        Token::TokenType       firstToken; // Type of the first token
+        std::vector<Directive> directives; // Directives until the End or Error token
+    };
+
+private:
     bool     mInSpec;      // Mode for lexer - in spec mode or not
     Token    mCurrToken;   // The currently lexed token
     Token    mPrevToken;   // The previously lexed token
-    char     *mInputStart; // The start of the input string
-    char     *mCurrLoc;    // The current point of processing
+    const char *mInputStart; // The start of the input string
+    const char *mCurrLoc;    // The current point of processing
     int      mArgsExpected; // For multi-arg format directives - how many still to process
     int      mNumMultArg;   // Total number of multi-arg format directives in total
     int      mArgs[2];      // Up to 2 int args can be used in multi-arg format directives
@@ -244,10 +271,17 @@ private:
                             // directives (VS doesn't support them all so we can't print them)
     bool     mError;        // Error in latest parsed format directive
     FILE     *mStreamOut;   // Output stream for kernel print
+    FormatCache    mLocalFormatCache; // Used when no cache is shared with the parser
+    FormatCache    *mFormatCache;     // Compiled formats
+    const CompiledFormat *mFormat;    // Compiled form of the current format string
+    const char     *mInputBase;       // The current format string, owned by mFormatCache
+    size_t         mNextDirective;    // Index of the next directive of mFormat to replay
 
     PRINT_FMT_STATUS GetNextFmtToken(char * tkn, size_t size);
     bool outputToken(const char *tkn, PCM_PRINT_HEADER header);
     void getToken(void);
+    void compile(const char *input, CompiledFormat &compiled);
+    int  nextDirective(void); // Replays format() from the compiled format
     void reset(void)
     {
         mInputStart = mCurrLoc;
@@ -274,6 +308,7 @@ private:
     int  conversion(void);
 };
 
-void DumpAllThreadOutput( FILE *streamout, unsigned char * dumpMem, size_t buffersize);
+void DumpAllThreadOutput( FILE *streamout, unsigned char * dumpMem, size_t buffersize,
+                          PFParser::FormatCache *formatCache = nullptr);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codechal_encode_shared_const_buffer.cpp
+//! \brief    Read only constant buffers shared by all encoders of a device
+//!
+
+#include "codechal_encode_shared_const_buffer.h"
+#include "codechal_encoder_base.h"
+
+std::mutex                                                         CodechalEncodeSharedConstBuffer::m_mutex;
+std::multimap<uint64_t, CodechalEncodeSharedConstBuffer::Entry *>  CodechalEncodeSharedConstBuffer::m_entries;
+
+uint64_t CodechalEncodeSharedConstBuffer::Hash(const uint8_t *data, uint32_t size)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+const MOS_RESOURCE *CodechalEncodeSharedConstBuffer::Acquire(
+    PMOS_INTERFACE osInterface,
+    const void    *data,
+    uint32_t       size,
+    const char    *name)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    if (osInterface == nullptr || data == nullptr || size == 0)
+    {
+        CODECHAL_ENCODE_ASSERTMESSAGE("Invalid shared const buffer parameter.");
+        return nullptr;
+    }
+
+    // resources can only be shared between users of the same device
+    void *device = osInterface->pfnGetGmmClientContext ? osInterface->pfnGetGmmClientContext(osInterface) : nullptr;
+    if (device == nullptr)
+    {
+        device = osInterface;
+    }
+
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint64_t       hash  = Hash(bytes, size);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        Entry *entry = it->second;
+        if (entry->device == device &&
+            entry->data.size() == size &&
+            memcmp(entry->data.data(), bytes, size) == 0)
+        {
+            entry->refCount++;
+            return &entry->resource;
+        }
+    }
+
+    Entry *entry = MOS_New(Entry);
+    if (entry == nullptr)
+    {
+        return nullptr;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(allocParams));
+    allocParams.Type     = MOS_GFXRES_BUFFER;
+    allocParams.TileType = MOS_TILE_LINEAR;
+    allocParams.Format   = Format_Buffer;
+    allocParams.dwBytes  = MOS_ALIGN_CEIL(size, CODECHAL_PAGE_SIZE);
+    allocParams.pBufName = name;
+
+    if (osInterface->pfnAllocateResource(osInterface, &allocParams, &entry->resource) != MOS_STATUS_SUCCESS)
+    {
+        CODECHAL_ENCODE_ASSERTMESSAGE("Failed to allocate '%s'.", name);
+        MOS_Delete(entry);
+        return nullptr;
+    }
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(lockFlags));
+    lockFlags.WriteOnly = 1;
+    uint8_t *lockedData = (uint8_t *)osInterface->pfnLockResource(osInterface, &entry->resource, &lockFlags);
+    if (lockedData == nullptr)
+    {
+        CODECHAL_ENCODE_ASSERTMESSAGE("Failed to lock '%s'.", name);
+        osInterface->pfnFreeResource(osInterface, &entry->resource);
+        MOS_Delete(entry);
+        return nullptr;
+    }
+    MOS_ZeroMemory(lockedData, allocParams.dwBytes);
+    MOS_SecureMemcpy(lockedData, size, bytes, size);
+    osInterface->pfnUnlockResource(osInterface, &entry->resource);
+
+    entry->device   = device;
+    entry->data.assign(bytes, bytes + size);
+    entry->refCount = 1;
+    m_entries.insert(std::make_pair(hash, entry));
+
+    return &entry->resource;
+}
+
+void CodechalEncodeSharedConstBuffer::Release(PMOS_INTERFACE osInterface, const MOS_RESOURCE *resource)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    if (osInterface == nullptr || resource == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+    {
+        Entry *entry = it->second;
+        if (&entry->resource != resource)
+        {
+            continue;
+        }
+        if (--entry->refCount == 0)
+        {
+            // any user of the same device may free it, GPU work still in flight keeps the BO alive
+            osInterface->pfnFreeResource(osInterface, &entry->resource);
+            m_entries.erase(it);
+            MOS_Delete(entry);
+        }
+        return;
+    }
+
+    CODECHAL_ENCODE_ASSERTMESSAGE("Releasing an unknown shared const buffer.");
+}
@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codechal_encode_shared_const_buffer.h
+//! \brief    Read only constant buffers shared by all encoders of a device
+//! \details  Constant tables uploaded by every encode session, e.g. the VDEnc BRC const data,
+//!           are identical for most sessions. Each distinct content is uploaded once per
+//!           device and reference counted, found by a hash of the content.
+//!
+
+#ifndef __CODECHAL_ENCODE_SHARED_CONST_BUFFER_H__
+#define __CODECHAL_ENCODE_SHARED_CONST_BUFFER_H__
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "mos_os.h"
+
+class CodechalEncodeSharedConstBuffer
+{
+public:
+    //!
+    //! \brief    Get a read only buffer holding the given content
+    //! \details  Uploads the content if no buffer of the device holds it yet. The returned
+    //!           resource must never be written, and is valid until the matching Release.
+    //! \param    [in] osInterface
+    //!           OS interface of the caller
+    //! \param    [in] data
+    //!           Content of the buffer
+    //! \param    [in] size
+    //!           Size of the content in bytes
+    //! \param    [in] name
+    //!           Buffer name used on allocation
+    //! \return   const MOS_RESOURCE *
+    //!           Shared buffer, nullptr if failed
+    //!
+    static const MOS_RESOURCE *Acquire(
+        PMOS_INTERFACE osInterface,
+        const void    *data,
+        uint32_t       size,
+        const char    *name);
+
+    //!
+    //! \brief    Drop a reference taken by Acquire, the last one frees the buffer
+    //! \param    [in] osInterface
+    //!           OS interface of the caller
+    //! \param    [in] resource
+    //!           Buffer returned by Acquire, nullptr is ignored
+    //!
+    static void Release(PMOS_INTERFACE osInterface, const MOS_RESOURCE *resource);
+
+protected:
+    struct Entry
+    {
+        void                *device   = nullptr;  //!< GMM client context of the device
+        std::vector<uint8_t> data;                //!< Content, compared on hash match
+        MOS_RESOURCE         resource = {};
+        uint32_t             refCount = 0;
+    };
+
+    static uint64_t Hash(const uint8_t *data, uint32_t size);
+
+    static std::mutex                        m_mutex;
+    static std::multimap<uint64_t, Entry *>  m_entries;  //!< Keyed by content hash
+};
+
+#endif  // __CODECHAL_ENCODE_SHARED_CONST_BUFFER_H__
@@ -3127,7 +3127,8 @@ CodechalVdencAvcState::~CodechalVdencAvcState()
 
     for (uint32_t i = 0; i < CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM; i++)
     {
-        m_osInterface->pfnFreeResource(m_osInterface, &m_resVdencBrcConstDataBuffer[i]);
+        CodechalEncodeSharedConstBuffer::Release(m_osInterface, m_sharedVdencBrcConstDataBuffer[i]);
+        m_sharedVdencBrcConstDataBuffer[i] = nullptr;
     }
 
     m_osInterface->pfnFreeResource(m_osInterface, &m_resVdencBrcHistoryBuffer);
@@ -5397,38 +5398,61 @@ MOS_STATUS CodechalVdencAvcState::SetConstDataHuCBrcUpdate()
     // Set VDENC BRC constant buffer, data remains the same till BRC Init is called
     if (m_brcInit)
     {
-        MOS_LOCK_PARAMS lockFlagsWriteOnly;
         for (uint8_t picType = 0; picType < CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM; picType++)
         {
-            auto hucConstData = (uint8_t*)m_osInterface->pfnLockResource(
-                m_osInterface, &m_resVdencBrcConstDataBuffer[picType], &lockFlagsWriteOnly);
-            CODECHAL_ENCODE_CHK_NULL_RETURN(hucConstData);
-
-            FillHucConstData(hucConstData, picType);
-            m_osInterface->pfnUnlockResource(m_osInterface, &m_resVdencBrcConstDataBuffer[picType]);
+            FillHucConstData(m_vdencBrcConstData[picType].data(), picType);
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(UpdateSharedBrcConstData(picType));
         }
     }
 
     if (m_vdencStaticFrame)
     {
-        MOS_LOCK_PARAMS lockFlagsWriteOnly;
-        auto            hucConstData = (PAVCVdencBRCCostantData)m_osInterface->pfnLockResource(
-            m_osInterface, &m_resVdencBrcConstDataBuffer[GetCurrConstDataBufIdx()], &lockFlagsWriteOnly);
-        CODECHAL_ENCODE_CHK_NULL_RETURN(hucConstData);
+        uint8_t picType      = (uint8_t)GetCurrConstDataBufIdx();
+        CODECHAL_ENCODE_CHK_COND_RETURN(picType >= CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM, "Invalid const data buffer index");
+        auto    hucConstData = (PAVCVdencBRCCostantData)m_vdencBrcConstData[picType].data();
+        bool    changed      = false;
 
         // adjustment due to dirty ROI
         for (int j = 0; j < 42; j++)
         {
-            uint32_t temp                     = AVC_Mode_Cost[1][LutMode_INTRA_16x16][10 + j];
-            temp                              = (uint32_t)(temp * CODECHAL_VDENC_AVC_STATIC_FRAME_INTRACOSTSCLRatioP / 100.0 + 0.5);
-            hucConstData->UPD_P_Intra16x16[j] = Map44LutValue(temp, 0x8f);
+            uint32_t temp = AVC_Mode_Cost[1][LutMode_INTRA_16x16][10 + j];
+            temp          = (uint32_t)(temp * CODECHAL_VDENC_AVC_STATIC_FRAME_INTRACOSTSCLRatioP / 100.0 + 0.5);
+            uint8_t value = Map44LutValue(temp, 0x8f);
+            if (hucConstData->UPD_P_Intra16x16[j] != value)
+            {
+                hucConstData->UPD_P_Intra16x16[j] = value;
+                changed                           = true;
+            }
+        }
+        // the shared buffer is read only, switch to the one holding the adjusted content
+        if (changed)
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(UpdateSharedBrcConstData(picType));
         }
-        m_osInterface->pfnUnlockResource(m_osInterface, &m_resVdencBrcConstDataBuffer[GetCurrConstDataBufIdx()]);
     }
 
     return eStatus;
 }
 
+MOS_STATUS CodechalVdencAvcState::UpdateSharedBrcConstData(uint8_t picType)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    const MOS_RESOURCE *sharedBuffer = CodechalEncodeSharedConstBuffer::Acquire(
+        m_osInterface,
+        m_vdencBrcConstData[picType].data(),
+        (uint32_t)m_vdencBrcConstData[picType].size(),
+        "VDENC BRC Const Data Buffer");
+    CODECHAL_ENCODE_CHK_NULL_RETURN(sharedBuffer);
+
+    CodechalEncodeSharedConstBuffer::Release(m_osInterface, m_sharedVdencBrcConstDataBuffer[picType]);
+    m_sharedVdencBrcConstDataBuffer[picType] = sharedBuffer;
+    // a copy, so per context state the OS layer keeps in the resource is not shared
+    m_resVdencBrcConstDataBuffer[picType]    = *sharedBuffer;
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS CodechalVdencAvcState::InitializePicture(const EncoderParams &params)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
@@ -6857,31 +6881,11 @@ MOS_STATUS CodechalVdencAvcState::AllocateResources()
         }
     }
 
-    // Const Data buffer
-    allocParamsForBufferLinear.dwBytes  = MOS_ALIGN_CEIL(GetBRCCostantDataSize(), CODECHAL_PAGE_SIZE);
-    allocParamsForBufferLinear.pBufName = "VDENC BRC Const Data Buffer";
-    for (uint32_t i = 0; i < CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM; i++)
+    // Const Data buffer, shared with the other encoders holding the same content
+    for (uint8_t i = 0; i < CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM; i++)
     {
-        CODECHAL_ENCODE_CHK_STATUS_MESSAGE_RETURN(m_osInterface->pfnAllocateResource(
-            m_osInterface,
-            &allocParamsForBufferLinear,
-            &m_resVdencBrcConstDataBuffer[i]),
-            "%s: Failed to allocate 's'", __FUNCTION__, allocParamsForBufferLinear.pBufName);
-
-        uint8_t* data = (uint8_t*)m_osInterface->pfnLockResource(
-            m_osInterface,
-            &m_resVdencBrcConstDataBuffer[i],
-            &lockFlagsWriteOnly);
-
-        if (data == nullptr)
-        {
-            CODECHAL_ENCODE_ASSERTMESSAGE("Failed to Lock '%s'", allocParamsForBufferLinear.pBufName);
-            eStatus = MOS_STATUS_UNKNOWN;
-            return eStatus;
-        }
-
-        MOS_ZeroMemory(data, allocParamsForBufferLinear.dwBytes);
-        m_osInterface->pfnUnlockResource(m_osInterface, &m_resVdencBrcConstDataBuffer[i]);
+        m_vdencBrcConstData[i].assign(MOS_ALIGN_CEIL(GetBRCCostantDataSize(), CODECHAL_PAGE_SIZE), 0);
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(UpdateSharedBrcConstData(i));
     }
 
     // BRC history buffer
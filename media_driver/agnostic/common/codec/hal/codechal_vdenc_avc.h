@@ -29,6 +29,7 @@
 #define __CODECHAL_VDENC_AVC_H__
 
 #include "codechal_encode_avc_base.h"
+#include "codechal_encode_shared_const_buffer.h"
 #define CODECHAL_VDENC_AVC_MMIO_MFX_LRA_0_VMC240    0xF5F0EF00
 #define CODECHAL_VDENC_AVC_MMIO_MFX_LRA_1_VMC240    0xFFFBFAF6
 #define CODECHAL_VDENC_AVC_MMIO_MFX_LRA_2_VMC240    0x000002D3
@@ -689,6 +690,17 @@ public:
     //!
     MOS_STATUS SetConstDataHuCBrcUpdate();
 
+    //!
+    //! \brief    Point the BRC const data buffer of a frame type to the shared buffer holding its CPU copy
+    //!
+    //! \param    [in] picType
+    //!           Frame type index of the buffer
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS UpdateSharedBrcConstData(uint8_t picType);
+
     //!
     //! \brief    VDENC Compute BRC Init QP..
     //! \param    [in] seqParams
@@ -1043,7 +1055,9 @@ protected:
     MOS_RESOURCE m_resVdencBrcUpdateDmemBuffer[CODECHAL_ENCODE_RECYCLED_BUFFER_NUM][CODECHAL_VDENC_BRC_NUM_OF_PASSES];  //!< Brc Update DMEM Buffer Array.
     MOS_RESOURCE m_resVdencBrcInitDmemBuffer[CODECHAL_ENCODE_RECYCLED_BUFFER_NUM];                                      //!< Brc Init DMEM Buffer Array.
     MOS_RESOURCE m_resVdencBrcImageStatesReadBuffer[CODECHAL_ENCODE_RECYCLED_BUFFER_NUM];                               //!< Read-only VDENC+PAK IMG STATE buffer.
-    MOS_RESOURCE m_resVdencBrcConstDataBuffer[CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM];                              //!< BRC Const Data Buffer for each frame type.
+    MOS_RESOURCE m_resVdencBrcConstDataBuffer[CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM];                              //!< BRC Const Data Buffer for each frame type, copy of the shared buffer.
+    const MOS_RESOURCE  *m_sharedVdencBrcConstDataBuffer[CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM] = {};               //!< Shared buffer holding m_vdencBrcConstData.
+    std::vector<uint8_t> m_vdencBrcConstData[CODECHAL_ENCODE_VDENC_BRC_CONST_BUFFER_NUM];                                //!< CPU copy of the BRC Const Data for each frame type.
     MOS_RESOURCE m_resVdencBrcHistoryBuffer;                                                                            //!< BRC History Buffer.
     MOS_RESOURCE m_resVdencBrcRoiBuffer[CODECHAL_ENCODE_RECYCLED_BUFFER_NUM];                                           //!< BRC ROI Buffer.
     MOS_RESOURCE m_resVdencBrcDbgBuffer;                                                                                //!< BRC Debug Buffer.
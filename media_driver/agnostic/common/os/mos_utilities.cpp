@@ -2975,6 +2975,15 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_VALUE_TYPE_UINT32,
         "0",
         "VP Surface dump aux data enable"),
+    MOS_DECLARE_UF_KEY(__VPHAL_DBG_SURF_DUMP_ASYNC_QUEUE_DEPTH_ID,
+        "asyncDumpQueueDepth",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "VP",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_UINT32,
+        "0",
+        "VP Surface dump max queued writes of the background writer, 0 writes synchronously"),
     MOS_DECLARE_UF_KEY(__VPHAL_DBG_SURF_DUMPER_RESOURCE_LOCK_ID,
         "SurfaceDumperResourceLockError",
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
@@ -1239,6 +1239,9 @@ MOS_STATUS RenderHal_AllocateStateHeaps(
     MHW_RENDERHAL_CHK_NULL(pStateHeap);
     MOS_ZeroMemory(pStateHeap, dwSizeAlloc);
 
+    // Kernel hash table for faster kernel search
+    MHW_RENDERHAL_CHK_STATUS(pStateHeap->kernelHashTable.Init());
+
     //-------------------------------------------------------------------------
     // Reset resource allocations
     //-------------------------------------------------------------------------
@@ -1543,6 +1546,13 @@ MOS_STATUS RenderHal_FreeStateHeaps(PRENDERHAL_INTERFACE pRenderHal)
     pOsInterface = pRenderHal->pOsInterface;
     pStateHeap   = pRenderHal->pStateHeap;
 
+    MHW_RENDERHAL_NORMALMESSAGE("Kernel loads: hits %u, loads %u, evictions %u, coalesced %u, bytes loaded %llu.",
+        pStateHeap->KernelLoadStats.dwHits,
+        pStateHeap->KernelLoadStats.dwLoads,
+        pStateHeap->KernelLoadStats.dwEvictions,
+        pStateHeap->KernelLoadStats.dwCoalesced,
+        (unsigned long long)pStateHeap->KernelLoadStats.uiBytesLoaded);
+
     // Free SSH Resource
     if (pStateHeap->pSshBuffer)
     {
@@ -1557,6 +1567,9 @@ MOS_STATUS RenderHal_FreeStateHeaps(PRENDERHAL_INTERFACE pRenderHal)
         entry->pSurface = nullptr;
     }
 
+    // Free kernel hash table
+    pStateHeap->kernelHashTable.Free();
+
     // Free State Heap Control structure
     MOS_AlignedFreeMemory(pStateHeap);
     pRenderHal->pStateHeap = nullptr;
@@ -1932,6 +1945,136 @@ finish:
     return eStatus;
 }
 
+//!
+//! \brief    Find Free Kernel Block
+//! \details  Search the smallest deallocated kernel block that fits the kernel
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iMaxKernels
+//!           [in] Number of kernel allocation entries
+//! \param    int32_t iKernelSize
+//!           [in] Kernel size
+//! \return   int32_t
+//!           Kernel allocation index, -1 if no block fits
+//!
+static int32_t RenderHal_FindFreeKernelBlock(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iMaxKernels,
+    int32_t               iKernelSize)
+{
+    PRENDERHAL_KRN_ALLOCATION pKernelAllocation;
+    int32_t                   iKernelAllocationID;
+    int32_t                   iSearchIndex = -1;
+    int32_t                   iMinSize     = 0;
+
+    pKernelAllocation = pStateHeap->pKernelAllocation;
+    for (iKernelAllocationID = 0;
+         iKernelAllocationID < iMaxKernels;
+         iKernelAllocationID++, pKernelAllocation++)
+    {
+        // Skip allocated/empty entries
+        if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE ||
+            pKernelAllocation->iSize   == 0)
+        {
+            continue;
+        }
+
+        // Allocate minimum available block
+        if (pKernelAllocation->iSize >= iKernelSize)
+        {
+            if (iSearchIndex < 0 ||
+                pKernelAllocation->iSize < iMinSize)
+            {
+                iSearchIndex = iKernelAllocationID;
+                iMinSize     = pKernelAllocation->iSize;
+            }
+        }
+    }
+
+    return iSearchIndex;
+}
+
+//!
+//! \brief    Coalesce Free Kernel Blocks
+//! \details  Merge deallocated kernel blocks with adjacent deallocated blocks,
+//!           and return the ones ending the kernel heap to the unused area.
+//!           Kernels are only unloaded once their sync tag is reached, so
+//!           deallocated blocks are no longer referenced by the GPU.
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iMaxKernels
+//!           [in] Number of kernel allocation entries
+//! \return   bool
+//!           true if any block was merged
+//!
+static bool RenderHal_CoalesceFreeKernelBlocks(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iMaxKernels)
+{
+    PRENDERHAL_KRN_ALLOCATION pBlock;
+    PRENDERHAL_KRN_ALLOCATION pNext;
+    int32_t                   i, j;
+    bool                      bMerged = false;
+    bool                      bFound;
+
+    pBlock = pStateHeap->pKernelAllocation;
+    for (i = 0; i < iMaxKernels; i++, pBlock++)
+    {
+        if (pBlock->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE ||
+            pBlock->iSize   == 0)
+        {
+            continue;
+        }
+
+        // Absorb the free blocks following this one
+        do
+        {
+            bFound = false;
+            pNext  = pStateHeap->pKernelAllocation;
+            for (j = 0; j < iMaxKernels; j++, pNext++)
+            {
+                if (pNext != pBlock &&
+                    pNext->dwFlags  == RENDERHAL_KERNEL_ALLOCATION_FREE &&
+                    pNext->iSize    != 0 &&
+                    pNext->dwOffset == pBlock->dwOffset + pBlock->iSize)
+                {
+                    pBlock->iSize  += pNext->iSize;
+                    pNext->dwOffset = 0;
+                    pNext->iSize    = 0;
+                    pStateHeap->KernelLoadStats.dwCoalesced++;
+                    bMerged = true;
+                    bFound  = true;
+                    break;
+                }
+            }
+        } while (bFound);
+    }
+
+    // Return the free blocks at the end of the heap
+    do
+    {
+        bFound = false;
+        pBlock = pStateHeap->pKernelAllocation;
+        for (i = 0; i < iMaxKernels; i++, pBlock++)
+        {
+            if (pBlock->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE &&
+                pBlock->iSize   != 0 &&
+                pBlock->dwOffset + pBlock->iSize == pStateHeap->dwKernelBase + pStateHeap->iKernelUsed)
+            {
+                pStateHeap->iKernelUsed -= pBlock->iSize;
+                pBlock->dwOffset = 0;
+                pBlock->iSize    = 0;
+                pStateHeap->KernelLoadStats.dwCoalesced++;
+                bMerged = true;
+                bFound  = true;
+                break;
+            }
+        }
+    } while (bFound);
+
+    return bMerged;
+}
+
 //!
 //! \brief    Load Kernel
 //! \details  Load a kernel from cache into GSH; searches for unused space in 
@@ -1967,6 +2110,9 @@ int32_t RenderHal_LoadKernel(
     int32_t iKernelSize;
     int32_t iSearchIndex;
     int32_t iMaxKernels;            // Max number of kernels allowed in GSH
+    int32_t iFreeIndex;             // Free allocation index
+    uint16_t wSearchIndex;          // Kernel hash table search index
+    bool    bAllocateAtEnd;
     uint32_t dwOffset;
     int32_t iSize;
     MOS_STATUS eStatus;
@@ -1997,24 +2143,48 @@ int32_t RenderHal_LoadKernel(
     iKernelUniqueID = pKernel->iKUID;
     iKernelCacheID  = pKernel->iKCID;
 
-    // Check if kernel is already loaded; Search free allocation index
-    iSearchIndex = -1;
-    iMaxKernels  = pRenderHal->StateHeapSettings.iKernelCount;
-    pKernelAllocation = pStateHeap->pKernelAllocation;
-    for (iKernelAllocationID = 0;
-         iKernelAllocationID < iMaxKernels;
-         iKernelAllocationID++, pKernelAllocation++)
+    // Check if kernel is already loaded; CM updates the kernel allocation
+    // table directly, so the hash table entry is validated before use
+    iMaxKernels         = pRenderHal->StateHeapSettings.iKernelCount;
+    iKernelAllocationID = -1;
+    wSearchIndex        = 0;
+    pKernelAllocation   = (PRENDERHAL_KRN_ALLOCATION)pStateHeap->kernelHashTable.Search(iKernelUniqueID, iKernelCacheID, wSearchIndex);
+    if (pKernelAllocation)
     {
         if (pKernelAllocation->iKUID == iKernelUniqueID &&
             pKernelAllocation->iKCID == iKernelCacheID)
         {
-            break;
+            iKernelAllocationID = (int32_t)(pKernelAllocation - pStateHeap->pKernelAllocation);
         }
+        else
+        {
+            pStateHeap->kernelHashTable.Unregister(iKernelUniqueID, iKernelCacheID);
+        }
+    }
 
-        if (iSearchIndex < 0 &&
-            pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
+    // Lookup miss: search the kernel and a free allocation index, preferring
+    // entries that do not hold a deallocated block
+    iSearchIndex = -1;
+    if (iKernelAllocationID < 0)
+    {
+        pKernelAllocation = pStateHeap->pKernelAllocation;
+        for (iKernelAllocationID = 0;
+             iKernelAllocationID < iMaxKernels;
+             iKernelAllocationID++, pKernelAllocation++)
         {
-            iSearchIndex = iKernelAllocationID;
+            if (pKernelAllocation->iKUID == iKernelUniqueID &&
+                pKernelAllocation->iKCID == iKernelCacheID)
+            {
+                pStateHeap->kernelHashTable.Register(iKernelUniqueID, iKernelCacheID, pKernelAllocation);
+                break;
+            }
+
+            if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE &&
+                (iSearchIndex < 0 ||
+                 (pStateHeap->pKernelAllocation[iSearchIndex].iSize != 0 && pKernelAllocation->iSize == 0)))
+            {
+                iSearchIndex = iKernelAllocationID;
+            }
         }
     }
 
@@ -2024,24 +2194,45 @@ int32_t RenderHal_LoadKernel(
     // Kernel already loaded: refresh timer; return allocation index
     if (iKernelAllocationID < iMaxKernels)
     {
+        pStateHeap->KernelLoadStats.dwHits++;
+
         // To reload the kernel forcibly if needed
         if (pKernel->bForceReload)
         {
             dwOffset = pKernelAllocation->dwOffset;
             MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
+            pStateHeap->KernelLoadStats.uiBytesLoaded += iKernelSize;
 
             pKernel->bForceReload = false;
         }
         goto finish;
     }
 
+    // Search block from deallocated entry if the kernel does not fit at the end of the heap;
+    // merge adjacent deallocated blocks if none is large enough
+    iFreeIndex     = iSearchIndex;
+    bAllocateAtEnd = (iFreeIndex >= 0) &&
+                     (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize);
+    if (iFreeIndex >= 0 && !bAllocateAtEnd)
+    {
+        iSearchIndex = RenderHal_FindFreeKernelBlock(pStateHeap, iMaxKernels, iKernelSize);
+        if (iSearchIndex < 0 &&
+            RenderHal_CoalesceFreeKernelBlocks(pStateHeap, iMaxKernels))
+        {
+            bAllocateAtEnd = (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize);
+            if (!bAllocateAtEnd)
+            {
+                iSearchIndex = RenderHal_FindFreeKernelBlock(pStateHeap, iMaxKernels, iKernelSize);
+            }
+        }
+    }
+
     // Simple allocation: allocation index available, space available
-    if ((iSearchIndex >= 0) &&
-        (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize))
+    if (bAllocateAtEnd)
     {
         // Allocate kernel at the end of the heap
-        iKernelAllocationID = iSearchIndex;
-        pKernelAllocation   = &(pStateHeap->pKernelAllocation[iSearchIndex]);
+        iKernelAllocationID = iFreeIndex;
+        pKernelAllocation   = &(pStateHeap->pKernelAllocation[iFreeIndex]);
 
         // Allocate block from the end of the heap
         dwOffset = pStateHeap->dwKernelBase + pStateHeap->iKernelUsed;
@@ -2054,37 +2245,6 @@ int32_t RenderHal_LoadKernel(
         goto loadkernel;
     }
 
-    // Search block from deallocated entry
-    if (iSearchIndex >= 0)
-    {
-        int32_t iMinSize = 0;
-
-        iSearchIndex = -1;
-        pKernelAllocation = pStateHeap->pKernelAllocation;
-        for (iKernelAllocationID = 0;
-             iKernelAllocationID < iMaxKernels;
-             iKernelAllocationID++, pKernelAllocation++)
-        {
-            // Skip allocated/empty entries
-            if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE ||
-                pKernelAllocation->iSize   == 0)
-            {
-                continue;
-            }
-
-            // Allocate minimum available block
-            if (pKernelAllocation->iSize >= iKernelSize)
-            {
-                if (iSearchIndex < 0 ||
-                    pKernelAllocation->iSize < iMinSize)
-                {
-                    iSearchIndex = iKernelAllocationID;
-                    iMinSize     = pKernelAllocation->iSize;
-                }
-            }
-        }
-    }
-
     // Did not find block, try to deallocate a kernel not recently used
     if (iSearchIndex < 0)
     {
@@ -2137,6 +2297,7 @@ int32_t RenderHal_LoadKernel(
             iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
             goto finish;
         }
+        pStateHeap->KernelLoadStats.dwEvictions++;
     }
 
     // Allocate the entry
@@ -2167,6 +2328,9 @@ loadkernel:
     {
         MOS_ZeroMemory(pStateHeap->pIshBuffer + dwOffset + iKernelSize, iSize - iKernelSize);
     }
+    pStateHeap->kernelHashTable.Register(iKernelUniqueID, iKernelCacheID, pKernelAllocation);
+    pStateHeap->KernelLoadStats.dwLoads++;
+    pStateHeap->KernelLoadStats.uiBytesLoaded += iKernelSize;
 
 finish:
     if (iKernelAllocationID != RENDERHAL_KERNEL_LOAD_FAIL)
@@ -2243,6 +2407,7 @@ MOS_STATUS RenderHal_UnloadKernel(
     }
 
     // Release kernel entry (Offset/size may be used for reallocation)
+    pStateHeap->kernelHashTable.Unregister(pKernelAllocation->iKUID, pKernelAllocation->iKCID);
     pKernelAllocation->iKID             = -1;
     pKernelAllocation->iKUID            = -1;
     pKernelAllocation->iKCID            = -1;
@@ -2328,6 +2493,11 @@ void RenderHal_ResetKernels(
             pKernelAllocation->pKernelEntry->dwLoaded = 0;
         }
 
+        if (pKernelAllocation->iKUID != -1)
+        {
+            pStateHeap->kernelHashTable.Unregister(pKernelAllocation->iKUID, pKernelAllocation->iKCID);
+        }
+
         pKernelAllocation->iKID             = -1;
         pKernelAllocation->iKUID            = -1;
         pKernelAllocation->iKCID            = -1;
@@ -781,6 +781,15 @@ typedef struct _RENDERHAL_KRN_ALLOCATION
     char                         *szKernelName;                                  // Kernel name - used for debugging
 } RENDERHAL_KRN_ALLOCATION, *PRENDERHAL_KRN_ALLOCATION;
 
+typedef struct _RENDERHAL_KRN_LOAD_STATS
+{
+    uint32_t                  dwHits;                                           // Kernels found already loaded in ISH
+    uint32_t                  dwLoads;                                          // Kernels copied into ISH
+    uint32_t                  dwEvictions;                                      // Kernels unloaded to make room
+    uint32_t                  dwCoalesced;                                      // Freed ISH blocks merged with a neighbour
+    uint64_t                  uiBytesLoaded;                                    // Bytes copied into ISH, including forced reloads
+} RENDERHAL_KRN_LOAD_STATS, *PRENDERHAL_KRN_LOAD_STATS;
+
 typedef struct _RENDERHAL_KRN_ALLOC_LIST
 {
     PRENDERHAL_KRN_ALLOCATION pHead;                                            // Head of the list
@@ -969,6 +978,7 @@ typedef struct _RENDERHAL_STATE_HEAP
 
     // Arrays created dynamically
     PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;                              // Kernel allocation table (or linked list)
+    RENDERHAL_KRN_LOAD_STATS    KernelLoadStats;                                // Kernel load counters
 
     // Dynamic Kernel States
     PMHW_MEMORY_POOL               pKernelAllocMemPool;                         // Kernel states memory pool (mallocs)
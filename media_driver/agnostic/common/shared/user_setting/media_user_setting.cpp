@@ -94,6 +94,19 @@ MOS_STATUS MediaUserSetting::Read(Value &value,
     return m_configure.Read(value, valueName, group, customValue, useCustomValue);
 }
 
+MOS_STATUS MediaUserSetting::Read(Value &value,
+    SettingId id,
+    const Value &customValue,
+    bool useCustomValue)
+{
+    return m_configure.Read(value, id, customValue, useCustomValue);
+}
+
+SettingId MediaUserSetting::GetSettingId(const std::string &valueName, const Group &group)
+{
+    return m_configure.GetSettingId(valueName, group);
+}
+
 MOS_STATUS MediaUserSetting::Write(
     const std::string &valueName,
     const Value &value,
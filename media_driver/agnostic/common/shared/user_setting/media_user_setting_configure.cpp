@@ -45,11 +45,34 @@ Configure::Configure()
 #endif
 
     MosUtilities::MosInitializeReg(m_regBufferMap);
+
+    // Pick up edits of the configure file at runtime only when asked for,
+    // otherwise the file is read once and values are served from the snapshot.
+    UFKEY_NEXT  key      = {};
+    std::string strValue = "";
+    uint32_t    size     = MOS_USER_CONTROL_MAX_DATA_SIZE;
+    uint32_t    type     = 0;
+    if (MosUtilities::MosReadEnvVariable(key, "Media User Setting Refresh", &type, strValue, &size) == MOS_STATUS_SUCCESS &&
+        strValue != "0")
+    {
+        m_regWatch = MosUtilities::MosWatchRegFile();
+        if (m_regWatch >= 0)
+        {
+            m_fileRegMap = m_regBufferMap;
+        }
+    }
 }
 
 Configure::~Configure()
 {
+    MosUtilities::MosUnwatchRegFile(m_regWatch);
     MosUtilities::MosUninitializeReg(m_regBufferMap);
+
+    for (auto &chunk : m_slotChunks)
+    {
+        SettingSlot *slots = chunk.load();
+        MOS_DeleteArray(slots);
+    }
 }
 
 MOS_STATUS Configure::Register(
@@ -82,18 +105,42 @@ MOS_STATUS Configure::Register(
         subPath = m_configPath;
     }
 
-    defs.insert(
-        std::make_pair(
-            MakeHash(valueName),
-            std::make_shared<Definition>(
-                valueName,
-                defaultValue,
-                isReportKey,
-                debugOnly,
-                useCustomPath,
-                subPath,
-                m_rootKey,
-                statePath)));
+    SettingId id         = m_settingNum.load(std::memory_order_relaxed);
+    uint32_t  chunkIndex = id / m_slotChunkSize;
+    if (chunkIndex >= m_maxSlotChunks)
+    {
+        m_mutexLock.Unlock();
+        MOS_OS_ASSERTMESSAGE("Too many media user setting items.");
+        return MOS_STATUS_NO_SPACE;
+    }
+    SettingSlot *chunk = m_slotChunks[chunkIndex].load(std::memory_order_relaxed);
+    if (chunk == nullptr)
+    {
+        chunk = MOS_NewArray(SettingSlot, m_slotChunkSize);
+        if (chunk == nullptr)
+        {
+            m_mutexLock.Unlock();
+            return MOS_STATUS_NO_SPACE;
+        }
+        m_slotChunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    auto def = std::make_shared<Definition>(
+        valueName,
+        defaultValue,
+        isReportKey,
+        debugOnly,
+        useCustomPath,
+        subPath,
+        m_rootKey,
+        statePath);
+    def->SetId(id);
+    chunk[id % m_slotChunkSize].def = def;
+
+    defs.insert(std::make_pair(MakeHash(valueName), def));
+
+    // Publish the id after its slot is filled
+    m_settingNum.store(id + 1, std::memory_order_release);
 
     m_mutexLock.Unlock();
 
@@ -106,33 +153,90 @@ MOS_STATUS Configure::Read(Value &value,
     const Value &customValue,
     bool useCustomValue)
 {
-    int32_t ret = 0;
-
     auto &defs = GetDefinitions(group);
 
-    auto def = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto def = defs.find(MakeHash(valueName));
+    if (def == defs.end() || def->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
 
-    if (def->IsDebugOnly() && !m_isDebugMode)
+    return Read(value, def->second->Id(), customValue, useCustomValue);
+}
+
+MOS_STATUS Configure::Read(Value &value,
+    SettingId id,
+    const Value &customValue,
+    bool useCustomValue)
+{
+    SettingSlot *slot = GetSlot(id);
+    if (slot == nullptr || slot->def == nullptr)
+    {
+        return MOS_STATUS_INVALID_HANDLE;
+    }
+    const Definition &def = *slot->def;
+
+    if (def.IsDebugOnly() && !m_isDebugMode)
     {
-        value = useCustomValue ? customValue : def->DefaultValue();
+        value = useCustomValue ? customValue : def.DefaultValue();
         return MOS_STATUS_SUCCESS;
     }
 
-    std::string basePath = "";
-    if(def->UseStatePath())
+    if (m_regWatch >= 0)
     {
-        if (m_keyPathInfo != nullptr && m_keyPathInfo->Path != nullptr)
-        {
-            basePath = m_keyPathInfo->Path;
-        }
+        CheckRefresh();
+    }
+
+    // The generation is sampled before resolving, so a value resolved
+    // concurrently with a write is tagged stale and resolved again.
+    uint32_t    generation = m_generation.load(std::memory_order_acquire);
+    const char *basePath   = GetBasePath(def);
+    auto        cached     = std::atomic_load(&slot->cached);
+    if (cached == nullptr || cached->generation != generation || cached->basePath != basePath)
+    {
+        bool fromEnv         = false;
+        auto resolved        = std::make_shared<CachedValue>();
+        resolved->generation = generation;
+        resolved->basePath   = basePath;
+        resolved->status     = ReadFromStore(def, basePath, resolved->value, fromEnv);
+        cached               = resolved;
+        // The environment can change without notice, keep only configure file values
+        std::atomic_store(&slot->cached, fromEnv ? std::shared_ptr<const CachedValue>() : cached);
+    }
+
+    if (cached->status == MOS_STATUS_SUCCESS)
+    {
+        value = cached->value;
+    }
+    else
+    {
+        value = useCustomValue ? customValue : def.DefaultValue();
+    }
+
+    return cached->status;
+}
+
+SettingId Configure::GetSettingId(const std::string &valueName, const Group &group)
+{
+    SettingId id = InvalidSettingId;
+
+    m_mutexLock.Lock();
+    auto &defs = GetDefinitions(group);
+    auto def = defs.find(MakeHash(valueName));
+    if (def != defs.end() && def->second != nullptr)
+    {
+        id = def->second->Id();
     }
-    std::string subPath = def->GetSubPath();
+    m_mutexLock.Unlock();
+
+    return id;
+}
 
-    std::string path = basePath + subPath;
+MOS_STATUS Configure::ReadFromStore(const Definition &def, const char *basePath, Value &value, bool &fromEnv)
+{
+    std::string valueName = def.ItemName();
+
+    std::string path = std::string(basePath) + def.GetSubPath();
 
     UFKEY_NEXT  key      = {};
     std::string strValue = "";
@@ -145,35 +249,86 @@ MOS_STATUS Configure::Read(Value &value,
  
     if (status == MOS_STATUS_SUCCESS)
     {
-        value = strValue;
+        value   = strValue;
+        fromEnv = true;
         return MOS_STATUS_SUCCESS;
     }
 
+    m_mutexLock.Lock();
     status = MosUtilities::MosOpenRegKey(m_rootKey, path, KEY_READ, &key, m_regBufferMap);
-    
+
     if (status == MOS_STATUS_SUCCESS)
     {
         strValue = "";
         size     = MOS_USER_CONTROL_MAX_DATA_SIZE;
         type     = 0;
 
-        m_mutexLock.Lock();
         status = MosUtilities::MosGetRegValue(key, valueName, &type, strValue, &size, m_regBufferMap);
         if (status == MOS_STATUS_SUCCESS)
         {
             value = strValue;
         }
-        m_mutexLock.Unlock();
 
         MosUtilities::MosCloseRegKey(key);
     }
+    m_mutexLock.Unlock();
 
-    if (status != MOS_STATUS_SUCCESS)
+    return status;
+}
+
+void Configure::CheckRefresh()
+{
+    if ((m_readCount.fetch_add(1, std::memory_order_relaxed) % m_refreshCheckInterval) == 0 &&
+        MosUtilities::MosIsRegFileChanged(m_regWatch))
     {
-        value = useCustomValue ? customValue : def->DefaultValue();
+        Refresh();
     }
+}
 
-    return status;
+void Configure::Refresh()
+{
+    RegBufferMap fileMap;
+    if (MosUtilities::MosInitializeReg(fileMap) != MOS_STATUS_SUCCESS)
+    {
+        return;
+    }
+
+    m_mutexLock.Lock();
+    // Drop the keys removed from the file since the last load, unless this
+    // process has written another value to them in the meantime
+    for (auto &path : m_fileRegMap)
+    {
+        auto regPath = m_regBufferMap.find(path.first);
+        if (regPath == m_regBufferMap.end())
+        {
+            continue;
+        }
+        auto filePath = fileMap.find(path.first);
+        for (auto &item : path.second)
+        {
+            if (filePath != fileMap.end() && filePath->second.count(item.first))
+            {
+                continue;
+            }
+            auto regItem = regPath->second.find(item.first);
+            if (regItem != regPath->second.end() && regItem->second == item.second)
+            {
+                regPath->second.erase(regItem);
+            }
+        }
+    }
+
+    for (auto &path : fileMap)
+    {
+        auto &keys = m_regBufferMap[path.first];
+        for (auto &item : path.second)
+        {
+            keys[item.first] = item.second;
+        }
+    }
+    m_fileRegMap = std::move(fileMap);
+    m_generation.fetch_add(1, std::memory_order_release);
+    m_mutexLock.Unlock();
 }
 
 MOS_STATUS Configure::Write(
@@ -184,11 +339,12 @@ MOS_STATUS Configure::Write(
 {
     auto &defs = GetDefinitions(group);
 
-    auto def = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto item = defs.find(MakeHash(valueName));
+    if (item == defs.end() || item->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
+    auto def = item->second;
 
     if (def->IsDebugOnly() && !m_isDebugMode)
     {
@@ -222,6 +378,8 @@ MOS_STATUS Configure::Write(
 
         MosUtilities::MosCloseRegKey(key);
     }
+    // Report keys are registered items too and may be read back
+    m_generation.fetch_add(1, std::memory_order_release);
     m_mutexLock.Unlock();
 
     if (status != MOS_STATUS_SUCCESS)
@@ -77,6 +77,7 @@ inline void Definition::SetData(const Definition& def)
     m_useCustomePath = def.m_useCustomePath;
     m_rootKey = def.m_rootKey;
     m_statePath = def.m_statePath;
+    m_id = def.m_id;
 }
 
 }}
\ No newline at end of file
@@ -54,6 +54,8 @@ extern "C"
 
 #define HDR_STAGES_CONFIG_TABLE_SIZE      32
 
+#define VPHAL_HDR_MONITOR_CCM_CACHE_NUM   3
+
 #define IS_HDR_SURFACE(surface)    \
     ((surface)->pHDRParams &&      \
     (((surface)->pHDRParams->EOTF == VPHAL_HDR_EOTF_SMPTE_ST2084) || IS_RGB64_FLOAT_FORMAT((surface)->Format)))
@@ -118,6 +120,20 @@ typedef union _HDRStageEnables
     };
 } HDRStageEnables, *PHDRStageEnables;
 
+//!
+//! \brief CCM matrix derived from monitor gamut, keyed by the display primaries
+//!        and white point it was calculated with
+//!
+typedef struct _VPHAL_HDR_MONITOR_CCM_CACHE
+{
+    bool                            bValid;                              //!< Entry holds a calculated matrix
+    uint16_t                        display_primaries_x[3];              //!< Display primaries X the matrix was calculated with
+    uint16_t                        display_primaries_y[3];              //!< Display primaries Y the matrix was calculated with
+    uint16_t                        white_point_x;                       //!< White point X the matrix was calculated with
+    uint16_t                        white_point_y;                       //!< White point Y the matrix was calculated with
+    float                           Matrix[12];                          //!< Calculated CCM matrix
+} VPHAL_HDR_MONITOR_CCM_CACHE, *PVPHAL_HDR_MONITOR_CCM_CACHE;
+
 //!
 //! \brief HDR Render data populated for every BLT call
 //!
@@ -195,6 +211,9 @@ typedef struct _VPHAL_HDR_STATE
     uint16_t                        OetfTraditionalGamma[VPHAL_HDR_OETF_1DLUT_POINT_NUMBER]; //!< EOTF 1D LUT traditional gamma
     uint16_t                        OetfSmpteSt2084[VPHAL_HDR_OETF_1DLUT_POINT_NUMBER];      //!< EOTF 1D LUT SMPTE ST2084
     uint16_t                        OetfsRgb[VPHAL_HDR_OETF_1DLUT_POINT_NUMBER];             //!< EOTF 1D LUT sRGB
+    float                           fOetfSmpteSt2084Stretch;                                 //!< Stretch factor OetfSmpteSt2084 was generated with, 0 if not generated
+
+    VPHAL_HDR_MONITOR_CCM_CACHE     MonitorCCMCache[VPHAL_HDR_MONITOR_CCM_CACHE_NUM];        //!< Monitor gamut CCM matrices, indexed by CCM type
 
     uint8_t*                        pInput3DLUT;                                             //!< Input 3DLUT address for GPU generate 3DLUT
 
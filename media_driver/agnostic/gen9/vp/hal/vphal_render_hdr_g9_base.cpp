@@ -1266,22 +1266,34 @@ float OETFsRGB(float c)
 }
 
 // Non-uniform OETF LUT generator.
+// The LUT samples 32 points in [0, 1/32) and 32 points in [1/32, 1], all the sample
+// points after that clamp to 1.0. Adjacent rows also share their boundary sample point.
+// So the OETF only needs to be evaluated once per distinct sample point.
+#define VPHAL_HDR_OETF_2SEGS_POINT_NUMBER 64
+
 void VpHal_Generate2SegmentsOETFLUT(float fStretchFactor, pfnOETFFunc oetfFunc, uint16_t *lut)
 {
-    int i = 0, j = 0;
+    uint16_t segLut[VPHAL_HDR_OETF_2SEGS_POINT_NUMBER] = {};
+    int      i = 0, j = 0;
+
+    for (i = 0; i < VPHAL_HDR_OETF_2SEGS_POINT_NUMBER; ++i)
+    {
+        float a = (i < 32) ? ((1.0f / 1024.0f) * i) : ((1.0f / 32.0f) * (i - 31));
+
+        if (a > 1.0f)
+            a = 1.0f;
+
+        a *= fStretchFactor;
+        segLut[i] = VpHal_FloatToHalfFloat(oetfFunc(a));
+    }
 
     for (i = 0; i < VPHAL_HDR_OETF_1DLUT_HEIGHT; ++i)
     {
         for (j = 0; j < VPHAL_HDR_OETF_1DLUT_WIDTH; ++j)
         {
             int idx = j + i * (VPHAL_HDR_OETF_1DLUT_WIDTH - 1);
-            float a = (idx < 32) ? ((1.0f / 1024.0f) * idx) : ((1.0f / 32.0f) * (idx - 31));
 
-            if (a > 1.0f)
-                a = 1.0f;
-
-            a *= fStretchFactor;
-            lut[i * VPHAL_HDR_OETF_1DLUT_WIDTH + j] = VpHal_FloatToHalfFloat(oetfFunc(a));
+            lut[i * VPHAL_HDR_OETF_1DLUT_WIDTH + j] = segLut[MOS_MIN(idx, VPHAL_HDR_OETF_2SEGS_POINT_NUMBER - 1)];
         }
     }
 }
@@ -1517,6 +1529,56 @@ finish:
     return;
 }
 
+//!
+//! \brief    Get CCM Matrix with Monitor Gamut
+//! \details  Return the CCM matrix cached for the CCM type, and only recalculate it
+//!           when the display primaries or white point of the target changed
+//! \param    PVPHAL_HDR_STATE pHdrState
+//!           [in] Pointer to HDR state
+//! \param    VPHAL_HDR_CCM_TYPE CCMType
+//!           [in] CCM type, must be one of the monitor gamut CCM types
+//! \param    PVPHAL_HDR_PARAMS pTarget
+//!           [in] Pointer to HDR params of output surface
+//! \param    float TempMatrix
+//!           [out] Array of temp matrix
+//! \return   void
+//!
+static void VpHal_HdrGetCCMWithMonitorGamut_g9(
+    PVPHAL_HDR_STATE    pHdrState,
+    VPHAL_HDR_CCM_TYPE  CCMType,
+    PVPHAL_HDR_PARAMS   pTarget,
+    float               TempMatrix[12])
+{
+    PVPHAL_HDR_MONITOR_CCM_CACHE pCache = nullptr;
+
+    VPHAL_PUBLIC_CHK_NULL_NO_STATUS(pHdrState);
+    VPHAL_PUBLIC_CHK_NULL_NO_STATUS(pTarget);
+
+    pCache = &pHdrState->MonitorCCMCache[CCMType - VPHAL_HDR_CCM_BT2020_TO_MONITOR_MATRIX];
+
+    if (!pCache->bValid                                        ||
+        pCache->white_point_x != pTarget->white_point_x        ||
+        pCache->white_point_y != pTarget->white_point_y        ||
+        memcmp(pCache->display_primaries_x, pTarget->display_primaries_x, sizeof(pCache->display_primaries_x)) ||
+        memcmp(pCache->display_primaries_y, pTarget->display_primaries_y, sizeof(pCache->display_primaries_y)))
+    {
+        VpHal_CalculateCCMWithMonitorGamut(CCMType, pTarget, pCache->Matrix);
+
+        MOS_SecureMemcpy(pCache->display_primaries_x, sizeof(pCache->display_primaries_x),
+            pTarget->display_primaries_x, sizeof(pTarget->display_primaries_x));
+        MOS_SecureMemcpy(pCache->display_primaries_y, sizeof(pCache->display_primaries_y),
+            pTarget->display_primaries_y, sizeof(pTarget->display_primaries_y));
+        pCache->white_point_x = pTarget->white_point_x;
+        pCache->white_point_y = pTarget->white_point_y;
+        pCache->bValid        = true;
+    }
+
+    MOS_SecureMemcpy(TempMatrix, sizeof(pCache->Matrix), pCache->Matrix, sizeof(pCache->Matrix));
+
+finish:
+    return;
+}
+
 //!
 //! \brief    Initiate EOTF Surface for HDR
 //! \details  Initiate EOTF Surface for HDR
@@ -1930,7 +1992,7 @@ MOS_STATUS VpHal_HdrInitCoeff_g9 (
                      pHdrState->CCMExt1[i] == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX)
             {
                 PVPHAL_SURFACE  pTargetSurf = (PVPHAL_SURFACE)pHdrState->pTargetSurf[0];
-                VpHal_CalculateCCMWithMonitorGamut(pHdrState->CCMExt1[i], pTargetSurf->pHDRParams, TempMatrix);
+                VpHal_HdrGetCCMWithMonitorGamut_g9(pHdrState, pHdrState->CCMExt1[i], pTargetSurf->pHDRParams, TempMatrix);
             }
             else
             {
@@ -1969,7 +2031,7 @@ MOS_STATUS VpHal_HdrInitCoeff_g9 (
                      pHdrState->CCMExt2[i] == VPHAL_HDR_CCM_MONITOR_TO_BT709_MATRIX)
             {
                 PVPHAL_SURFACE  pTargetSurf = (PVPHAL_SURFACE)pHdrState->pTargetSurf[0];
-                VpHal_CalculateCCMWithMonitorGamut(pHdrState->CCMExt2[i], pTargetSurf->pHDRParams, TempMatrix);
+                VpHal_HdrGetCCMWithMonitorGamut_g9(pHdrState, pHdrState->CCMExt2[i], pTargetSurf->pHDRParams, TempMatrix);
             }
             else
             {
@@ -3371,7 +3433,12 @@ MOS_STATUS VpHal_HdrInitOETF1DLUT_g9(
         if (pHdrState->HdrMode[iIndex] == VPHAL_HDR_MODE_INVERSE_TONE_MAPPING)
         {
             const float fStretchFactor = 0.01f;
-            VpHal_Generate2SegmentsOETFLUT(fStretchFactor, OETF2084, pHdrState->OetfSmpteSt2084);
+            // The generated LUT only depends on the stretch factor, reuse it across layers and frames
+            if (pHdrState->fOetfSmpteSt2084Stretch != fStretchFactor)
+            {
+                VpHal_Generate2SegmentsOETFLUT(fStretchFactor, OETF2084, pHdrState->OetfSmpteSt2084);
+                pHdrState->fOetfSmpteSt2084Stretch = fStretchFactor;
+            }
             pSrcOetfLut = pHdrState->OetfSmpteSt2084;
         }
         else // pHdrState->HdrMode[iIndex] == VPHAL_HDR_MODE_H2H
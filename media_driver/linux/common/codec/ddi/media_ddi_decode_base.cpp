@@ -518,8 +518,23 @@ VAStatus DdiMediaDecode::AllocBsBuffer(
     else
     {
         bufMgr->bIsSliceOverSize = false;
+
+        // Bitstream buffers of the frames recorded for batched submission are not busy until
+        // submitted, they are the latest ones in the bitstream order
+        uint32_t batchedFrames = MOS_MIN(DdiDecode_GetBatchedFrameCount(m_ddiDecodeCtx), (uint32_t)DDI_CODEC_MAX_BITSTREAM_BUFFER_MINUS1);
+        uint32_t batchedMask   = 0;
+        for (uint32_t k = 0; k < batchedFrames; k++)
+        {
+            batchedMask |= 1 << ((bufMgr->ui64BitstreamOrder >> (DDI_CODEC_BITSTREAM_BUFFER_INDEX_BITS * k)) & DDI_CODEC_MAX_BITSTREAM_BUFFER_INDEX);
+        }
+
         for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
         {
+            if (batchedMask & (1 << i))
+            {
+                continue;
+            }
+
             if (bufMgr->pBitStreamBuffObject[i]->bo != nullptr)
             {
                 if (!mos_bo_busy(bufMgr->pBitStreamBuffObject[i]->bo))
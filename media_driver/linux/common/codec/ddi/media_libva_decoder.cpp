@@ -170,7 +170,10 @@ VAStatus DdiDecode_EndPicture (
 
     if (decCtx->m_ddiDecode)
     {
+        // another thread may submit the batched frames of the decoder meanwhile
+        DdiMediaUtil_LockMutex(&decCtx->BatchMutex);
         VAStatus va = decCtx->m_ddiDecode->EndPicture(ctx, context);
+        DdiMediaUtil_UnLockMutex(&decCtx->BatchMutex);
         DDI_FUNCTION_EXIT(va);
         return va;
     }
@@ -255,6 +258,7 @@ void DdiDecodeCleanUp(
         {
             decCtx->m_ddiDecode->DestroyContext(ctx);
             MOS_Delete(decCtx->m_ddiDecode);
+            DdiMediaUtil_DestroyMutex(&decCtx->BatchMutex);
             MOS_FreeMemory(decCtx);
             decCtx = nullptr;
         }
@@ -431,6 +435,49 @@ VAStatus DdiDecode_StatusReport(PDDI_MEDIA_CONTEXT mediaCtx, DecodePipelineAdapt
     return VA_STATUS_SUCCESS;
 }
 
+static DecodePipelineAdapter *DdiDecode_GetPipelineAdapter(PDDI_DECODE_CONTEXT decCtx)
+{
+    if (decCtx == nullptr || decCtx->pCodecHal == nullptr || !decCtx->pCodecHal->IsApogeiosEnabled())
+    {
+        return nullptr;
+    }
+    return dynamic_cast<DecodePipelineAdapter *>(decCtx->pCodecHal);
+}
+
+VAStatus DdiDecode_FlushBatchedSubmission(PDDI_DECODE_CONTEXT decCtx)
+{
+    DecodePipelineAdapter *decoder = DdiDecode_GetPipelineAdapter(decCtx);
+    if (decoder == nullptr)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    DdiMediaUtil_LockMutex(&decCtx->BatchMutex);
+    if (decoder->GetBatchedFrameCount() > 0)
+    {
+        eStatus = decoder->FlushBatchedSubmission();
+    }
+    DdiMediaUtil_UnLockMutex(&decCtx->BatchMutex);
+    DDI_CHK_CONDITION(MOS_STATUS_SUCCESS != eStatus, "Submit batched frames fail", VA_STATUS_ERROR_OPERATION_FAILED);
+
+    return VA_STATUS_SUCCESS;
+}
+
+uint32_t DdiDecode_GetBatchedFrameCount(PDDI_DECODE_CONTEXT decCtx)
+{
+    DecodePipelineAdapter *decoder = DdiDecode_GetPipelineAdapter(decCtx);
+    if (decoder == nullptr)
+    {
+        return 0;
+    }
+
+    DdiMediaUtil_LockMutex(&decCtx->BatchMutex);
+    uint32_t count = decoder->GetBatchedFrameCount();
+    DdiMediaUtil_UnLockMutex(&decCtx->BatchMutex);
+    return count;
+}
+
 /*
  *  vpgDecodeCreateContext - Create a decode context
  *  dpy: display
@@ -527,6 +574,7 @@ VAStatus DdiDecode_CreateContext (
 
     decCtx->pMediaCtx                       = mediaCtx;
     decCtx->m_ddiDecode                     = ddiDecBase;
+    DdiMediaUtil_InitMutex(&decCtx->BatchMutex);
 
     mosCtx.bufmgr                = mediaCtx->pDrmBufMgr;
     mosCtx.m_gpuContextMgr       = mediaCtx->m_gpuContextMgr;
@@ -711,6 +759,12 @@ VAStatus DdiDecode_DestroyContext (
     DDI_CHK_NULL(decCtx,            "nullptr decCtx",            VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(decCtx->pCodecHal, "nullptr decCtx->pCodecHal", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    // the recorded frames reference the bitstream buffers freed below
+    if (DdiDecode_FlushBatchedSubmission(decCtx) != VA_STATUS_SUCCESS)
+    {
+        DDI_ASSERTMESSAGE("Failed to submit batched frames.");
+    }
+
     /* Free the context id from the context_heap earlier */
     uint32_t decIndex                 = (uint32_t)context & DDI_MEDIA_MASK_VACONTEXTID;
     DdiMediaUtil_LockMutex(&mediaCtx->DecoderMutex);
@@ -718,6 +772,19 @@ VAStatus DdiDecode_DestroyContext (
     mediaCtx->uiNumDecoders--;
     DdiMediaUtil_UnLockMutex(&mediaCtx->DecoderMutex);
 
+    // flushes of other threads may still use the context found in the heap before
+    while (true)
+    {
+        DdiMediaUtil_LockMutex(&mediaCtx->DecoderMutex);
+        uint32_t refs = decCtx->uiBatchFlushRefs;
+        DdiMediaUtil_UnLockMutex(&mediaCtx->DecoderMutex);
+        if (refs == 0)
+        {
+            break;
+        }
+        usleep(100);
+    }
+
     DdiMedia_FreeBufferHeapElements(ctx, decCtx);
 
     if (decCtx->m_ddiDecode) {
@@ -80,6 +80,10 @@ struct DDI_DECODE_CONTEXT
     uint32_t                        dwSliceParamBufNum;
     uint32_t                        dwSliceCtrlBufNum;
     uint32_t                        uiDecProcessingType;
+    // Serializes adding frames to the batched submission with its flush from other threads
+    MEDIA_MUTEX_T                   BatchMutex;
+    // Flushes of other threads still using the context, protected by DecoderMutex
+    uint32_t                        uiBatchFlushRefs;
 };
 
 typedef struct DDI_DECODE_CONTEXT *PDDI_DECODE_CONTEXT;
@@ -117,6 +121,30 @@ VAStatus DdiDecode_StatusReport(
     DecodePipelineAdapter *decoder,
     DDI_MEDIA_SURFACE *surface);
 
+//!
+//! \brief  Submit the frames recorded by the decoder for batched submission
+//! \details Serialized with DdiDecode_EndPicture by the batch lock of the decoder, so it
+//!          may be called from any thread while the decoder is alive
+//!
+//! \param  [in] decCtx
+//!     Pointer to ddi decode context
+//!
+//! \return VAStatus
+//!     VA_STATUS_SUCCESS if success, else fail reason
+//!
+VAStatus DdiDecode_FlushBatchedSubmission(PDDI_DECODE_CONTEXT decCtx);
+
+//!
+//! \brief  Get the number of frames recorded by the decoder but not submitted
+//!
+//! \param  [in] decCtx
+//!     Pointer to ddi decode context
+//!
+//! \return uint32_t
+//!     Number of pending frames
+//!
+uint32_t DdiDecode_GetBatchedFrameCount(PDDI_DECODE_CONTEXT decCtx);
+
 //!
 //! \brief  Create buffer
 //!
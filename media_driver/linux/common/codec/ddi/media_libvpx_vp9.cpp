@@ -47,34 +47,46 @@
 
 struct vp9_write_bit_buffer {
     uint8_t *bit_buffer;
-    int bit_offset;
+    int bit_offset;     // total bits written, including the bits still in bit_cache
+    uint32_t bit_cache; // pending bits not yet flushed to bit_buffer, LSB aligned
+    int cache_bits;     // number of valid bits in bit_cache, always less than 8 between calls
 };
 
+/* Pending bits are kept in bit_cache and flushed a whole byte at a time,
+ * so a literal is written with one shift instead of one call per bit.
+ * The last partial byte is only written by vp9_wb_flush.
+ */
 static
-void vp9_wb_write_bit(struct vp9_write_bit_buffer *wb, int bit)
+void vp9_wb_write_literal(struct vp9_write_bit_buffer *wb, int data, int bits)
 {
-    const int off = wb->bit_offset;
-    const int p = off / 8;
-    const int q = 7 - off % 8;
+    uint32_t cache = (wb->bit_cache << bits) | ((uint32_t)data & ((1u << bits) - 1));
+    int cacheBits  = wb->cache_bits + bits;
+    uint8_t *dst   = wb->bit_buffer + wb->bit_offset / 8;
 
-    if (q == 7)
+    while (cacheBits >= 8)
     {
-        wb->bit_buffer[p] = bit << q;
+        cacheBits -= 8;
+        *dst++ = (uint8_t)(cache >> cacheBits);
     }
-    else
-    {
-        wb->bit_buffer[p] &= ~(1 << q);
-        wb->bit_buffer[p] |= bit << q;
-    }
-    wb->bit_offset = off + 1;
+    wb->bit_cache  = cache & ((1u << cacheBits) - 1);
+    wb->cache_bits = cacheBits;
+    wb->bit_offset += bits;
 }
 
 static
-void vp9_wb_write_literal(struct vp9_write_bit_buffer *wb, int data, int bits)
+void vp9_wb_write_bit(struct vp9_write_bit_buffer *wb, int bit)
 {
-    int bit;
-    for (bit = bits - 1; bit >= 0; bit--)
-        vp9_wb_write_bit(wb, (data >> bit) & 1);
+    vp9_wb_write_literal(wb, bit, 1);
+}
+
+static
+void vp9_wb_flush(struct vp9_write_bit_buffer *wb)
+{
+    if (wb->cache_bits)
+    {
+        /* pad the trailing bits of the last byte with zero */
+        wb->bit_buffer[wb->bit_offset / 8] = (uint8_t)(wb->bit_cache << (8 - wb->cache_bits));
+    }
 }
 
 static
@@ -164,6 +176,8 @@ bool Vp9WriteUncompressHeader(struct _DDI_ENCODE_CONTEXT *ddiEncContext,
 
     vp9_wb.bit_buffer = (uint8_t *)headerData;
     vp9_wb.bit_offset = 0;
+    vp9_wb.bit_cache = 0;
+    vp9_wb.cache_bits = 0;
     wb = &vp9_wb;
     vp9_wb_write_literal(wb, VP9_FRAME_MARKER, 2);
 
@@ -536,7 +550,7 @@ bool Vp9WriteUncompressHeader(struct _DDI_ENCODE_CONTEXT *ddiEncContext,
         }
 
         /* write tile row info */
-        vp9_wb_write_bit(wb, picParam->log2_tile_rows);
+        vp9_wb_write_bit(wb, picParam->log2_tile_rows != 0);
         if (picParam->log2_tile_rows)
         {
             vp9_wb_write_bit(wb, (picParam->log2_tile_rows != 1));
@@ -548,6 +562,7 @@ bool Vp9WriteUncompressHeader(struct _DDI_ENCODE_CONTEXT *ddiEncContext,
 
     /* reserve the space for writing the first partitions ize */
     vp9_wb_write_literal(wb, 0, 16);
+    vp9_wb_flush(wb);
 
     *headerLen = (wb->bit_offset + 7) / 8;
 
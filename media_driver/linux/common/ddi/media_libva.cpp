@@ -59,6 +59,8 @@
 #include "media_user_settings_mgr.h"
 #include "media_interfaces.h"
 #include "mos_interface.h"
+#include "mos_cpu_profiler.h"
+#include "media_libva_async_submit.h"
 #include "drm_fourcc.h"
 #include "media_libva_apo_decision.h"
 #include "mos_oca_interface_specific.h"
@@ -1023,6 +1025,196 @@ uint32_t DdiMedia_GetCtxTypeFromVABufferID (PDDI_MEDIA_CONTEXT mediaCtx, VABuffe
 
 }
 
+//!
+//! \brief  Submit the frames a decoder recorded for batched submission, after its queued picture calls
+//!
+//! \return VAStatus
+//!     Status of the submission if it ran inline, else VA_STATUS_SUCCESS and a failure is
+//!     reported by the next picture call or wait of the decoder
+//!
+static VAStatus DdiMedia_FlushBatchedDecode(PDDI_MEDIA_CONTEXT mediaCtx, PDDI_DECODE_CONTEXT decCtx)
+{
+    if (mediaCtx == nullptr || decCtx == nullptr)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    if (mediaCtx->m_asyncSubmit)
+    {
+        return mediaCtx->m_asyncSubmit->Post(decCtx, [decCtx]() { return DdiDecode_FlushBatchedSubmission(decCtx); });
+    }
+
+    return DdiDecode_FlushBatchedSubmission(decCtx);
+}
+
+//!
+//! \brief  Submit the frames recorded for batched submission by all decoders, before work of
+//!         other contexts or CPU access which may read their output
+//!
+static void DdiMedia_FlushAllBatchedDecode(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    if (mediaCtx == nullptr || mediaCtx->pDecoderCtxHeap == nullptr || mediaCtx->uiNumDecoders == 0)
+    {
+        return;
+    }
+
+    // the flush takes the lock of the decoder, and EndPicture looks up the decoder under
+    // DecoderMutex while holding it, so the decoders are only referenced under DecoderMutex
+    // and DdiDecode_DestroyContext waits for the references to be dropped
+    std::vector<PDDI_DECODE_CONTEXT> decoders;
+    DdiMediaUtil_LockMutex(&mediaCtx->DecoderMutex);
+    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT heapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)mediaCtx->pDecoderCtxHeap->pHeapBase;
+    for (uint32_t i = 0; heapElmt && i < mediaCtx->pDecoderCtxHeap->uiAllocatedHeapElements; i++)
+    {
+        if (heapElmt[i].pVaContext != nullptr)
+        {
+            PDDI_DECODE_CONTEXT decCtx = (PDDI_DECODE_CONTEXT)heapElmt[i].pVaContext;
+            decCtx->uiBatchFlushRefs++;
+            decoders.push_back(decCtx);
+        }
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->DecoderMutex);
+
+    for (auto decCtx : decoders)
+    {
+        if (DdiMedia_FlushBatchedDecode(mediaCtx, decCtx) != VA_STATUS_SUCCESS)
+        {
+            DDI_ASSERTMESSAGE("Failed to submit batched decode frames.");
+        }
+    }
+
+    DdiMediaUtil_LockMutex(&mediaCtx->DecoderMutex);
+    for (auto decCtx : decoders)
+    {
+        decCtx->uiBatchFlushRefs--;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->DecoderMutex);
+}
+
+//!
+//! \brief  Wait for all queued asynchronous picture calls, since any of them may read or write the surface
+//!
+static void DdiMedia_WaitAsyncSubmitForSurface(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    DdiMedia_FlushAllBatchedDecode(mediaCtx);
+
+    if (mediaCtx && mediaCtx->m_asyncSubmit)
+    {
+        mediaCtx->m_asyncSubmit->WaitAll();
+    }
+}
+
+//!
+//! \brief  Wait for the asynchronous picture calls rendering to the surface, and for the context
+//!         holding its status report, which later pictures of that context update
+//!
+//! \return VAStatus
+//!     First failure of a picture call of that context not yet reported, else VA_STATUS_SUCCESS
+//!
+static VAStatus DdiMedia_WaitAsyncSubmitForSurfaceStatus(PDDI_MEDIA_CONTEXT mediaCtx, DDI_MEDIA_SURFACE *surface)
+{
+    if (mediaCtx == nullptr || surface == nullptr)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    // the queued BeginPicture sets the context owning the surface, so it is read after the wait
+    if (mediaCtx->m_asyncSubmit)
+    {
+        mediaCtx->m_asyncSubmit->WaitSurface(surface);
+    }
+
+    // frames recorded for batched submission are not executed until submitted
+    if (surface->curCtxType == DDI_MEDIA_CONTEXT_TYPE_DECODER)
+    {
+        VAStatus vaStatus = DdiMedia_FlushBatchedDecode(mediaCtx, (PDDI_DECODE_CONTEXT)surface->pDecCtx);
+        DDI_CHK_CONDITION(vaStatus != VA_STATUS_SUCCESS, "Failed to submit batched decode frames", vaStatus);
+    }
+
+    if (mediaCtx->m_asyncSubmit == nullptr)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    // the wait for the status context covers the submission posted above
+    if (surface->curCtxType == DDI_MEDIA_CONTEXT_TYPE_DECODER)
+    {
+        return mediaCtx->m_asyncSubmit->Wait(surface->pDecCtx);
+    }
+    else if (surface->curCtxType == DDI_MEDIA_CONTEXT_TYPE_VP)
+    {
+        return mediaCtx->m_asyncSubmit->Wait(surface->pVpCtx);
+    }
+    return VA_STATUS_SUCCESS;
+}
+
+//!
+//! \brief  Wait for the asynchronous picture calls rendering to the surface, and submit the frames
+//!         its decoder recorded for batched submission, before the surface is read by the CPU
+//!
+static void DdiMedia_WaitAsyncSubmitForSurfaceRead(PDDI_MEDIA_CONTEXT mediaCtx, DDI_MEDIA_SURFACE *surface)
+{
+    if (mediaCtx == nullptr || surface == nullptr)
+    {
+        return;
+    }
+
+    // the queued BeginPicture sets the decoder owning the surface
+    if (mediaCtx->m_asyncSubmit)
+    {
+        mediaCtx->m_asyncSubmit->WaitSurface(surface);
+    }
+
+    if (surface->curCtxType != DDI_MEDIA_CONTEXT_TYPE_DECODER)
+    {
+        return;
+    }
+
+    PDDI_DECODE_CONTEXT decCtx = (PDDI_DECODE_CONTEXT)surface->pDecCtx;
+    if (DdiMedia_FlushBatchedDecode(mediaCtx, decCtx) != VA_STATUS_SUCCESS)
+    {
+        DDI_ASSERTMESSAGE("Failed to submit batched decode frames.");
+    }
+    if (mediaCtx->m_asyncSubmit)
+    {
+        mediaCtx->m_asyncSubmit->WaitIdle(decCtx);
+    }
+}
+
+//!
+//! \brief  Wait for the asynchronous picture calls of the context owning the buffer
+//!
+static void DdiMedia_WaitAsyncSubmitForBuffer(PDDI_MEDIA_CONTEXT mediaCtx, VABufferID bufId)
+{
+    if (mediaCtx == nullptr)
+    {
+        return;
+    }
+
+    // the buffer of a derived image is the surface itself, which any queued job may access
+    DDI_MEDIA_BUFFER *buf = DdiMedia_GetBufferFromVABufferID(mediaCtx, bufId);
+    if (buf && buf->pSurface)
+    {
+        DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+        return;
+    }
+
+    // the other decoder buffers are only read by the GPU, and the bitstream of the recorded
+    // frames is kept, so only the buffers written by the GPU need the frames submitted
+    void *ctxPtr = DdiMedia_GetCtxFromVABufferID(mediaCtx, bufId);
+    if (buf && buf->uiType == VADecodeStreamoutBufferType &&
+        DdiMedia_GetCtxTypeFromVABufferID(mediaCtx, bufId) == DDI_MEDIA_CONTEXT_TYPE_DECODER &&
+        DdiMedia_FlushBatchedDecode(mediaCtx, (PDDI_DECODE_CONTEXT)ctxPtr) != VA_STATUS_SUCCESS)
+    {
+        DDI_ASSERTMESSAGE("Failed to submit batched decode frames.");
+    }
+
+    if (mediaCtx->m_asyncSubmit)
+    {
+        mediaCtx->m_asyncSubmit->WaitIdle(ctxPtr);
+    }
+}
+
 //!
 //! \brief  Destroy image from VA image ID 
 //! 
@@ -2066,6 +2258,11 @@ VAStatus DdiMedia_InitMediaContext (
 
     DdiMediaUtil_SetMediaResetEnableFlag(mediaCtx);
 
+    if (DdiMediaAsyncSubmit::IsRequested())
+    {
+        mediaCtx->m_asyncSubmit = MOS_New(DdiMediaAsyncSubmit);
+    }
+
     DdiMediaUtil_UnLockMutex(&GlobalMutex);
 
     return VA_STATUS_SUCCESS;
@@ -2187,6 +2384,12 @@ VAStatus DdiMedia_CleanUp (PDDI_MEDIA_CONTEXT mediaCtx)
 {
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    if (mediaCtx->m_asyncSubmit)
+    {
+        MOS_Delete(mediaCtx->m_asyncSubmit);
+        mediaCtx->m_asyncSubmit = nullptr;
+    }
+
     if (mediaCtx->m_caps)
     {
         MOS_Delete(mediaCtx->m_caps);
@@ -2507,12 +2710,18 @@ VAStatus DdiMedia_DestroySurfaces (
     DDI_CHK_NULL  (mediaCtx,                  "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL  (mediaCtx->pSurfaceHeap,    "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     PDDI_MEDIA_SURFACE surface = nullptr;
     for(int32_t i = 0; i < num_surfaces; i++)
     {
         DDI_CHK_LESS((uint32_t)surfaces[i], mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
         surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surfaces[i]);
         DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
+        if (mediaCtx->m_asyncSubmit)
+        {
+            mediaCtx->m_asyncSubmit->RemoveSurface(surface);
+        }
         if(surface->pCurrentFrameSemaphore)
         {
             DdiMediaUtil_WaitSemaphore(surface->pCurrentFrameSemaphore);
@@ -3181,6 +3390,22 @@ VAStatus DdiMedia_CreateContext (
         vaStatus = VA_STATUS_ERROR_INVALID_CONFIG;
     }
 
+    if (vaStatus == VA_STATUS_SUCCESS && mediaDrvCtx->m_asyncSubmit)
+    {
+        uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
+        void     *ctxPtr = DdiMedia_GetContextFromContextID(ctx, *context, &ctxType);
+        if (ctxPtr && DdiMediaAsyncSubmit::IsRequested(ctxType))
+        {
+            vaStatus = mediaDrvCtx->m_asyncSubmit->AddContext(ctxPtr);
+        }
+    }
+
+    if (vaStatus == VA_STATUS_SUCCESS && MosCpuProfiler::IsEnabled())
+    {
+        uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
+        MosCpuProfiler::BeginInterval(DdiMedia_GetContextFromContextID(ctx, *context, &ctxType));
+    }
+
     return vaStatus;
 }
 
@@ -3196,6 +3421,24 @@ VAStatus DdiMedia_DestroyContext (
     uint32_t            ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
     void *ctxPtr = DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
 
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    if (mediaCtx && mediaCtx->m_asyncSubmit)
+    {
+        // buffers created by a RenderPicture job whose picture was never ended
+        for (VABufferID bufId : mediaCtx->m_asyncSubmit->RemoveContext(ctxPtr))
+        {
+            DdiMedia_DestroyBuffer(ctx, bufId);
+        }
+    }
+
+    if (MosCpuProfiler::IsEnabled())
+    {
+        // Covers the lifetime of this context, other contexts keep their samples
+        char tag[64];
+        MOS_SecureStringPrint(tag, sizeof(tag), sizeof(tag), "vaDestroyContext 0x%x type %d", context, ctxType);
+        MosCpuProfiler::DumpInterval(ctxPtr, tag);
+    }
+
     switch (ctxType)
     {
         case DDI_MEDIA_CONTEXT_TYPE_DECODER:
@@ -3212,6 +3455,152 @@ VAStatus DdiMedia_DestroyContext (
     }
 }
 
+//!
+//! \brief  Check whether a buffer of a queued context is created as a CPU copy, from which its
+//!         RenderPicture job creates the buffer of the codec
+//! \details The codecs create these buffers from their buffer manager and picture state, which
+//!         the queued picture calls of the context still use
+//!
+static bool DdiMedia_IsAsyncStagedBufferType(uint32_t ctxType, int32_t type)
+{
+    switch (ctxType)
+    {
+        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
+            switch (type)
+            {
+                case VAPictureParameterBufferType:
+                case VASliceParameterBufferType:
+                case VASliceDataBufferType:
+                case VAIQMatrixBufferType:
+                case VABitPlaneBufferType:
+                case VAProbabilityBufferType:
+                case VAHuffmanTableBufferType:
+                case VASubsetsParameterBufferType:
+                    return true;
+                default:
+                    return false;
+            }
+        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
+            switch (type)
+            {
+                case VAEncSequenceParameterBufferType:
+                case VAEncPictureParameterBufferType:
+                case VAEncSliceParameterBufferType:
+                case VAEncMiscParameterBufferType:
+                case VAEncPackedHeaderParameterBufferType:
+                case VAEncPackedHeaderDataBufferType:
+                case VAIQMatrixBufferType:
+                case VAQMatrixBufferType:
+                case VAHuffmanTableBufferType:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+//!
+//! \brief  Create the CPU copy of a buffer of a queued context
+//!
+static VAStatus DdiMedia_CreateAsyncStagedBuffer(
+    PDDI_MEDIA_CONTEXT  mediaCtx,
+    void               *ctxPtr,
+    uint32_t            ctxType,
+    VABufferType        type,
+    uint32_t            size,
+    uint32_t            numElements,
+    void               *data,
+    VABufferID         *bufId)
+{
+    // only for VASliceParameterBufferType of buffer, the number of elements can be greater than 1
+    if (type != VASliceParameterBufferType && type != VAEncSliceParameterBufferType && numElements > 1)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+    DDI_CHK_LARGER(numElements, 0, "Invalid number elements", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    DDI_MEDIA_BUFFER *buf = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+    DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_ALLOCATION_FAILED);
+
+    buf->iSize         = size * numElements;
+    buf->uiNumElements = numElements;
+    buf->uiType        = type;
+    buf->format        = Media_Format_CPU;
+    buf->bAsyncStaged  = true;
+    buf->pMediaCtx     = mediaCtx;
+    buf->pData         = (uint8_t *)MOS_AllocAndZeroMemory(buf->iSize);
+    if (buf->pData == nullptr)
+    {
+        MOS_FreeMemory(buf);
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+    if (data)
+    {
+        MOS_SecureMemcpy(buf->pData, buf->iSize, data, buf->iSize);
+    }
+
+    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
+    PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufferHeapElement = DdiMediaUtil_AllocPMediaBufferFromHeap(mediaCtx->pBufferHeap);
+    if (bufferHeapElement == nullptr)
+    {
+        DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+        MOS_FreeMemory(buf->pData);
+        MOS_FreeMemory(buf);
+        return VA_STATUS_ERROR_MAX_NUM_EXCEEDED;
+    }
+    bufferHeapElement->pBuffer   = buf;
+    bufferHeapElement->pCtx      = ctxPtr;
+    bufferHeapElement->uiCtxType = ctxType;
+    *bufId                       = bufferHeapElement->uiVaBufferID;
+    mediaCtx->uiNumBufs++;
+    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+
+    return VA_STATUS_SUCCESS;
+}
+
+//!
+//! \brief  Create a buffer of the codec of a context
+//!
+static VAStatus DdiMedia_CreateContextBuffer(
+    VADriverContextP    ctx,
+    VAContextID         context,
+    void               *ctxPtr,
+    uint32_t            ctxType,
+    VABufferType        type,
+    uint32_t            size,
+    uint32_t            numElements,
+    void               *data,
+    VABufferID         *bufId)
+{
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
+    VAStatus va = VA_STATUS_SUCCESS;
+    switch (ctxType)
+    {
+        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
+            va = DdiDecode_CreateBuffer(ctx, DdiDecode_GetDecContextFromPVOID(ctxPtr), type, size, numElements, data, bufId);
+            break;
+        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
+            va = DdiEncode_CreateBuffer(ctx, context, type, size, numElements, data, bufId);
+            break;
+        case DDI_MEDIA_CONTEXT_TYPE_VP:
+            va = DdiVp_CreateBuffer(ctx, ctxPtr, type, size, numElements, data, bufId);
+            break;
+        case DDI_MEDIA_CONTEXT_TYPE_PROTECTED:
+            va = DdiMediaProtected::DdiMedia_ProtectedSessionCreateBuffer(ctx, context, type, size, numElements, data, bufId);
+            break;
+        default:
+            va = VA_STATUS_ERROR_INVALID_CONTEXT;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+
+    return va;
+}
+
 VAStatus DdiMedia_CreateBuffer (
     VADriverContextP    ctx,
     VAContextID         context,
@@ -3239,27 +3628,24 @@ VAStatus DdiMedia_CreateBuffer (
 
     *bufId     = VA_INVALID_ID;
 
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
     VAStatus va = VA_STATUS_SUCCESS;
-    switch (ctxType)
+    if (mediaCtx->m_asyncSubmit && mediaCtx->m_asyncSubmit->IsQueued(ctxPtr))
     {
-        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
-            va = DdiDecode_CreateBuffer(ctx, DdiDecode_GetDecContextFromPVOID(ctxPtr), type, size, num_elements, data, bufId);
-            break;
-        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
-            va = DdiEncode_CreateBuffer(ctx, context, type, size, num_elements, data, bufId);
-            break;
-        case DDI_MEDIA_CONTEXT_TYPE_VP:
-            va = DdiVp_CreateBuffer(ctx, ctxPtr, type, size, num_elements, data, bufId);
-            break;
-        case DDI_MEDIA_CONTEXT_TYPE_PROTECTED:
-            va = DdiMediaProtected::DdiMedia_ProtectedSessionCreateBuffer(ctx, context, type, size, num_elements, data, bufId);
-            break;
-        default:
-            va = VA_STATUS_ERROR_INVALID_CONTEXT;
+        if (DdiMedia_IsAsyncStagedBufferType(ctxType, type))
+        {
+            va = DdiMedia_CreateAsyncStagedBuffer(mediaCtx, ctxPtr, ctxType, type, size, num_elements, data, bufId);
+            MOS_TraceEventExt(EVENT_VA_BUFFER, EVENT_TYPE_END, bufId, sizeof(bufId), nullptr, 0);
+            return va;
+        }
+        // the VP buffers are plain CPU memory, the other codec buffers are created once per
+        // stream and use the buffer manager of the context, used by its queued picture calls
+        if (ctxType != DDI_MEDIA_CONTEXT_TYPE_VP)
+        {
+            mediaCtx->m_asyncSubmit->WaitIdle(ctxPtr);
+        }
     }
 
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+    va = DdiMedia_CreateContextBuffer(ctx, context, ctxPtr, ctxType, type, size, num_elements, data, bufId);
     MOS_TraceEventExt(EVENT_VA_BUFFER, EVENT_TYPE_END, bufId, sizeof(bufId), nullptr, 0);
     return va;
 }
@@ -3290,6 +3676,23 @@ VAStatus DdiMedia_BufferSetNumElements (
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
 
+    if (buf->bAsyncStaged)
+    {
+        DDI_CHK_LARGER(num_elements, 0, "Invalid number elements", VA_STATUS_ERROR_INVALID_PARAMETER);
+        if (buf->uiNumElements < num_elements)
+        {
+            uint32_t elementSize = buf->iSize / buf->uiNumElements;
+            uint8_t *data        = (uint8_t *)MOS_AllocAndZeroMemory(elementSize * num_elements);
+            DDI_CHK_NULL(data, "nullptr data", VA_STATUS_ERROR_ALLOCATION_FAILED);
+            MOS_SecureMemcpy(data, elementSize * num_elements, buf->pData, buf->iSize);
+            MOS_FreeMemory(buf->pData);
+            buf->pData = data;
+        }
+        buf->iSize         = buf->iSize / buf->uiNumElements * num_elements;
+        buf->uiNumElements = num_elements;
+        return VA_STATUS_SUCCESS;
+    }
+
     if(buf->uiType == VASliceParameterBufferType &&
        buf->uiNumElements < num_elements)
     {
@@ -3341,6 +3744,16 @@ VAStatus DdiMedia_MapBufferInternal (
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
 
+    // the RenderPicture job uses its own copy of a staged buffer
+    if (buf->bAsyncStaged)
+    {
+        *pbuf = buf->pData;
+        MOS_TraceEventExt(EVENT_VA_MAP, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
+        return VA_STATUS_SUCCESS;
+    }
+
+    DdiMedia_WaitAsyncSubmitForBuffer(mediaCtx, buf_id);
+
     // The context is nullptr when the buffer is created from DdiMedia_DeriveImage
     // So doesn't need to check the context for all cases
     // Only check the context in dec/enc mode
@@ -3626,6 +4039,12 @@ VAStatus DdiMedia_UnmapBuffer (
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx,  buf_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
 
+    if (buf->bAsyncStaged)
+    {
+        MOS_TraceEventExt(EVENT_VA_UNMAP, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
+        return VA_STATUS_SUCCESS;
+    }
+
     // The context is nullptr when the buffer is created from DdiMedia_DeriveImage
     // So doesn't need to check the context for all cases
     // Only check the context in dec/enc mode
@@ -3725,6 +4144,18 @@ VAStatus DdiMedia_DestroyBuffer (
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx,  buffer_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
 
+    // the buffers created from it are destroyed by the EndPicture job
+    if (buf->bAsyncStaged)
+    {
+        MOS_FreeMemory(buf->pData);
+        MOS_FreeMemory(buf);
+        DdiMedia_DestroyBufFromVABufferID(mediaCtx, buffer_id);
+        MOS_TraceEventExt(EVENT_VA_FREE_BUFFER, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
+        return VA_STATUS_SUCCESS;
+    }
+
+    DdiMedia_WaitAsyncSubmitForBuffer(mediaCtx, buffer_id);
+
     void     *ctxPtr = DdiMedia_GetCtxFromVABufferID(mediaCtx,     buffer_id);
     uint32_t ctxType = DdiMedia_GetCtxTypeFromVABufferID(mediaCtx, buffer_id);
 
@@ -3929,18 +4360,84 @@ VAStatus DdiMedia_BeginPicture (
     }
     DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
 
+    DdiMediaAsyncSubmit::SubmitFunc beginPicture = nullptr;
     switch (ctxType)
     {
         case DDI_MEDIA_CONTEXT_TYPE_DECODER:
-            return DdiDecode_BeginPicture(ctx, context, render_target);
+            beginPicture = [=]() { return DdiDecode_BeginPicture(ctx, context, render_target); };
+            break;
         case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
-            return DdiEncode_BeginPicture(ctx, context, render_target);
+            beginPicture = [=]() { return DdiEncode_BeginPicture(ctx, context, render_target); };
+            break;
         case DDI_MEDIA_CONTEXT_TYPE_VP:
-            return DdiVp_BeginPicture(ctx, context, render_target);
+            beginPicture = [=]() { return DdiVp_BeginPicture(ctx, context, render_target); };
+            break;
         default:
             DDI_ASSERTMESSAGE("DDI: unsupported context in DdiCodec_BeginPicture.");
             return VA_STATUS_ERROR_INVALID_CONTEXT;
     }
+
+    // runs inline unless the context is queued, a failure of an earlier picture is reported here
+    return mediaCtx->m_asyncSubmit ?
+        mediaCtx->m_asyncSubmit->Submit(ctxPtr, beginPicture, surface) :
+        beginPicture();
+}
+
+//!
+//! \brief  Copy of a staged buffer taken by a queued RenderPicture
+//!
+struct DdiMediaAsyncStagedBuffer
+{
+    int32_t              index       = 0;  //!< Position in the buffer list of the picture call
+    VABufferType         type        = VAPictureParameterBufferType;
+    uint32_t             size        = 0;  //!< Size of one element
+    uint32_t             numElements = 0;
+    std::vector<uint8_t> data;
+};
+
+//!
+//! \brief  Render a queued picture, creating the buffers of the codec from the staged copies
+//! \details Runs on the worker in the order of the picture calls of the context, so the buffer
+//!          manager and picture state used by the codec are those of this picture. The created
+//!          buffers are held for the context and destroyed by its EndPicture job.
+//!
+static VAStatus DdiMedia_RenderAsyncStagedPicture(
+    VADriverContextP                        ctx,
+    VAContextID                             context,
+    void                                   *ctxPtr,
+    uint32_t                                ctxType,
+    std::vector<VABufferID>                &buffers,
+    std::vector<DdiMediaAsyncStagedBuffer> &staged)
+{
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    DDI_CHK_NULL(mediaCtx,                "nullptr mediaCtx",                VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_NULL(mediaCtx->m_asyncSubmit, "nullptr mediaCtx->m_asyncSubmit", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    VAStatus                vaStatus = VA_STATUS_SUCCESS;
+    std::vector<VABufferID> created;
+    for (auto &copy : staged)
+    {
+        VABufferID bufId = VA_INVALID_ID;
+        vaStatus = DdiMedia_CreateContextBuffer(ctx, context, ctxPtr, ctxType, copy.type, copy.size, copy.numElements, copy.data.data(), &bufId);
+        if (vaStatus != VA_STATUS_SUCCESS)
+        {
+            break;
+        }
+        buffers[copy.index] = bufId;
+        created.push_back(bufId);
+    }
+    mediaCtx->m_asyncSubmit->HoldBuffers(ctxPtr, created);
+    DDI_CHK_RET(vaStatus, "Failed to create buffer from staged copy");
+
+    switch (ctxType)
+    {
+        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
+            return DdiDecode_RenderPicture(ctx, context, buffers.data(), (int32_t)buffers.size());
+        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
+            return DdiEncode_RenderPicture(ctx, context, buffers.data(), (int32_t)buffers.size());
+        default:
+            return VA_STATUS_ERROR_INVALID_CONTEXT;
+    }
 }
 
 VAStatus DdiMedia_RenderPicture (
@@ -3952,6 +4449,7 @@ VAStatus DdiMedia_RenderPicture (
 {
 
     DDI_FUNCTION_ENTER();
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_DDI_RENDER_PICTURE);
 
     DDI_CHK_NULL(  ctx,            "nullptr ctx",                   VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(  buffers,        "nullptr buffers",               VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -3971,19 +4469,60 @@ VAStatus DdiMedia_RenderPicture (
     uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
     void     *ctxPtr = DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
 
-    switch (ctxType)
+    if (mediaCtx->m_asyncSubmit == nullptr)
     {
-        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
-            return DdiDecode_RenderPicture(ctx, context, buffers, num_buffers);
-        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
-            return DdiEncode_RenderPicture(ctx, context, buffers, num_buffers);
-        case DDI_MEDIA_CONTEXT_TYPE_VP:
-            return DdiVp_RenderPicture(ctx, context, buffers, num_buffers);
-        default:
-            DDI_ASSERTMESSAGE("DDI: unsupported context in DdiCodec_RenderPicture.");
-            return VA_STATUS_ERROR_INVALID_CONTEXT;
+        switch (ctxType)
+        {
+            case DDI_MEDIA_CONTEXT_TYPE_DECODER:
+                return DdiDecode_RenderPicture(ctx, context, buffers, num_buffers);
+            case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
+                return DdiEncode_RenderPicture(ctx, context, buffers, num_buffers);
+            case DDI_MEDIA_CONTEXT_TYPE_VP:
+                return DdiVp_RenderPicture(ctx, context, buffers, num_buffers);
+            default:
+                DDI_ASSERTMESSAGE("DDI: unsupported context in DdiCodec_RenderPicture.");
+                return VA_STATUS_ERROR_INVALID_CONTEXT;
+        }
     }
 
+    if (ctxType == DDI_MEDIA_CONTEXT_TYPE_VP)
+    {
+        // the pipeline parameters point to memory of the application, which it may reuse once
+        // this call returns, so they are parsed into the render parameters of the context now
+        VAStatus vaStatus = mediaCtx->m_asyncSubmit->Wait(ctxPtr);
+        DDI_CHK_RET(vaStatus, "Queued picture call of the VP context failed");
+        return DdiVp_RenderPicture(ctx, context, buffers, num_buffers);
+    }
+    if (ctxType != DDI_MEDIA_CONTEXT_TYPE_DECODER && ctxType != DDI_MEDIA_CONTEXT_TYPE_ENCODER)
+    {
+        DDI_ASSERTMESSAGE("DDI: unsupported context in DdiCodec_RenderPicture.");
+        return VA_STATUS_ERROR_INVALID_CONTEXT;
+    }
+
+    // the application may reuse its buffer list and staged buffers once this call returns
+    std::vector<VABufferID>                bufferList(buffers, buffers + num_buffers);
+    std::vector<DdiMediaAsyncStagedBuffer> staged;
+    for (int32_t i = 0; i < num_buffers; i++)
+    {
+        DDI_MEDIA_BUFFER *buf = DdiMedia_GetBufferFromVABufferID(mediaCtx, buffers[i]);
+        if (buf && buf->bAsyncStaged)
+        {
+            DdiMediaAsyncStagedBuffer copy;
+            copy.index       = i;
+            copy.type        = (VABufferType)buf->uiType;
+            copy.size        = buf->iSize / buf->uiNumElements;
+            copy.numElements = buf->uiNumElements;
+            copy.data.assign(buf->pData, buf->pData + buf->iSize);
+            staged.push_back(std::move(copy));
+        }
+    }
+
+    DdiMediaAsyncSubmit::SubmitFunc renderPicture =
+        [ctx, context, ctxPtr, ctxType, bufferList = std::move(bufferList), staged = std::move(staged)]() mutable {
+            return DdiMedia_RenderAsyncStagedPicture(ctx, context, ctxPtr, ctxType, bufferList, staged);
+        };
+
+    return mediaCtx->m_asyncSubmit->Submit(ctxPtr, std::move(renderPicture));
 }
 
 VAStatus DdiMedia_EndPicture (
@@ -3992,28 +4531,59 @@ VAStatus DdiMedia_EndPicture (
 )
 {
     DDI_FUNCTION_ENTER();
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_DDI_END_PICTURE);
 
     DDI_CHK_NULL(ctx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
     void     *ctxPtr = DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
     VAStatus  vaStatus = VA_STATUS_SUCCESS;
+
+    DdiMediaAsyncSubmit::SubmitFunc endPicture = nullptr;
     switch (ctxType)
     {
         case DDI_MEDIA_CONTEXT_TYPE_DECODER:
-            vaStatus = DdiDecode_EndPicture(ctx, context);
+            endPicture = [=]() { return DdiDecode_EndPicture(ctx, context); };
             break;
         case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
-            vaStatus = DdiEncode_EndPicture(ctx, context);
+            endPicture = [=]() { return DdiEncode_EndPicture(ctx, context); };
             break;
         case DDI_MEDIA_CONTEXT_TYPE_VP:
-            vaStatus = DdiVp_EndPicture(ctx, context);
+            endPicture = [=]() { return DdiVp_EndPicture(ctx, context); };
             break;
         default:
             DDI_ASSERTMESSAGE("DDI: unsupported context in DdiCodec_EndPicture.");
             vaStatus = VA_STATUS_ERROR_INVALID_CONTEXT;
     }
 
+    if (endPicture)
+    {
+        PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+        // decoded frames recorded for batched submission may be read by this picture
+        if (ctxType != DDI_MEDIA_CONTEXT_TYPE_DECODER)
+        {
+            DdiMedia_FlushAllBatchedDecode(mediaCtx);
+        }
+        if (mediaCtx && mediaCtx->m_asyncSubmit)
+        {
+            // the buffers created by the RenderPicture jobs are not used after the picture
+            DdiMediaAsyncSubmit::SubmitFunc endPictureAndRelease = [=]() {
+                VAStatus status = endPicture();
+                for (VABufferID bufId : mediaCtx->m_asyncSubmit->ReleaseHeldBuffers(ctxPtr))
+                {
+                    DdiMedia_DestroyBuffer(ctx, bufId);
+                }
+                return status;
+            };
+            // runs inline unless the context is queued
+            vaStatus = mediaCtx->m_asyncSubmit->Submit(ctxPtr, std::move(endPictureAndRelease));
+        }
+        else
+        {
+            vaStatus = endPicture();
+        }
+    }
+
     MOS_TraceEventExt(EVENT_VA_PICTURE, EVENT_TYPE_END, &context, sizeof(context), &vaStatus, sizeof(vaStatus));
     PERF_UTILITY_STOP_ONCE("First Frame Time", PERF_MOS, PERF_LEVEL_DDI);
 
@@ -4141,6 +4711,8 @@ VAStatus DdiMedia_SyncSurface (
 
     DDI_MEDIA_SURFACE  *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, render_target);
     DDI_CHK_NULL(surface,    "nullptr surface",      VA_STATUS_ERROR_INVALID_CONTEXT);
+    VAStatus asyncStatus = DdiMedia_WaitAsyncSubmitForSurfaceStatus(mediaCtx, surface);
+    DDI_CHK_CONDITION(asyncStatus != VA_STATUS_SUCCESS, "Async picture call failed", asyncStatus);
     if (surface->pCurrentFrameSemaphore)
     {
         DdiMediaUtil_WaitSemaphore(surface->pCurrentFrameSemaphore);
@@ -4182,6 +4754,8 @@ VAStatus DdiMedia_SyncSurface2 (
 
     DDI_MEDIA_SURFACE  *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface_id);
     DDI_CHK_NULL(surface,    "nullptr surface",      VA_STATUS_ERROR_INVALID_CONTEXT);
+    VAStatus asyncStatus = DdiMedia_WaitAsyncSubmitForSurfaceStatus(mediaCtx, surface);
+    DDI_CHK_CONDITION(asyncStatus != VA_STATUS_SUCCESS, "Async picture call failed", asyncStatus);
     if (surface->pCurrentFrameSemaphore)
     {
         DdiMediaUtil_WaitSemaphore(surface->pCurrentFrameSemaphore);
@@ -4250,6 +4824,7 @@ VAStatus DdiMedia_SyncBuffer (
     DDI_CHK_NULL(mediaCtx->pBufferHeap,  "nullptr mediaCtx->pBufferHeap",  VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buffer", VA_STATUS_ERROR_INVALID_BUFFER);
+    DdiMedia_WaitAsyncSubmitForBuffer(mediaCtx, buf_id);
 
     DDI_MEDIA_BUFFER  *buffer = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buffer,    "nullptr buffer",      VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -4318,6 +4893,20 @@ VAStatus DdiMedia_QuerySurfaceStatus (
     DDI_MEDIA_SURFACE *surface   = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, render_target);
     DDI_CHK_NULL(surface,    "nullptr surface",    VA_STATUS_ERROR_INVALID_SURFACE);
 
+    // frames recorded for batched submission are not executed until submitted
+    if (surface->curCtxType == DDI_MEDIA_CONTEXT_TYPE_DECODER)
+    {
+        VAStatus vaStatus = DdiMedia_FlushBatchedDecode(mediaCtx, (PDDI_DECODE_CONTEXT)surface->pDecCtx);
+        DDI_CHK_CONDITION(vaStatus != VA_STATUS_SUCCESS, "Failed to submit batched decode frames", vaStatus);
+    }
+
+    if (mediaCtx->m_asyncSubmit && mediaCtx->m_asyncSubmit->IsSurfaceBusy(surface))
+    {
+        // the picture rendering to the surface has not been submitted yet
+        *status = VASurfaceRendering;
+        return VA_STATUS_SUCCESS;
+    }
+
     if (surface->pCurrentFrameSemaphore)
     {
         if(DdiMediaUtil_TryWaitSemaphore(surface->pCurrentFrameSemaphore) == 0)
@@ -4364,6 +4953,8 @@ VAStatus DdiMedia_QuerySurfaceError(
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL( mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     DDI_MEDIA_SURFACE *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, render_target);
     DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
@@ -4482,6 +5073,8 @@ VAStatus DdiMedia_PutSurface(
     DDI_CHK_NULL(mediaDrvCtx,               "nullptr mediaDrvCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaDrvCtx->pSurfaceHeap, "nullptr mediaDrvCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaDrvCtx);
+
     DDI_CHK_LESS((uint32_t)surface, mediaDrvCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
     if (nullptr != mediaDrvCtx->pVpCtxHeap->pHeapBase)
@@ -4768,6 +5361,8 @@ VAStatus DdiMedia_DeriveImage (
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     DDI_CHK_NULL(mediaSurface, "nullptr mediaSurface", VA_STATUS_ERROR_INVALID_SURFACE);
 
@@ -5355,6 +5950,9 @@ VAStatus DdiMedia_GetImage(
     DDI_CHK_NULL(inputSurface,     "nullptr inputSurface.",      VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_CHK_NULL(inputSurface->bo, "nullptr inputSurface->bo.",  VA_STATUS_ERROR_INVALID_SURFACE);
 
+    // the surface is only read, so only the pictures writing it are waited for
+    DdiMedia_WaitAsyncSubmitForSurfaceRead(mediaCtx, inputSurface);
+
     VAStatus vaStatus = VA_STATUS_SUCCESS;
 #ifndef _FULL_OPEN_SOURCE
     VASurfaceID target_surface = VA_INVALID_SURFACE;
@@ -5511,6 +6109,8 @@ VAStatus DdiMedia_PutImage(
     DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface.", VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_CHK_LESS((uint32_t)image, mediaCtx->pImageHeap->uiAllocatedHeapElements,     "Invalid image.",   VA_STATUS_ERROR_INVALID_IMAGE);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     DDI_CHK_NULL(mediaSurface,     "nullptr mediaSurface.", VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_CHK_NULL(mediaSurface->bo, "Invalid buffer.",       VA_STATUS_ERROR_INVALID_BUFFER);
@@ -6241,6 +6841,9 @@ DdiMedia_Copy(
         DDI_ASSERTMESSAGE("DDI: unsupported dst copy object in DdiMedia_copy.");
     }
 
+    // queued picture calls may still read the source or render to the destination
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     MOS_ZeroMemory(&mosCtx, sizeof(mosCtx));
 
     mosCtx.bufmgr          = mediaCtx->pDrmBufMgr;
@@ -6402,6 +7005,8 @@ VAStatus DdiMedia_LockSurface (
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     
 #ifdef _MMC_SUPPORTED
@@ -7146,6 +7751,8 @@ VAStatus DdiMedia_ExportSurfaceHandle(
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_LESS((uint32_t)(surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
 
+    DdiMedia_WaitAsyncSubmitForSurface(mediaCtx);
+
     DDI_MEDIA_SURFACE  *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface_id);
     DDI_CHK_NULL(mediaSurface,                   "nullptr mediaSurface",                   VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_CHK_NULL(mediaSurface->bo,               "nullptr mediaSurface->bo",               VA_STATUS_ERROR_INVALID_SURFACE);
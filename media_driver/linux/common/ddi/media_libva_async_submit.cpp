@@ -0,0 +1,319 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_async_submit.cpp
+//! \brief    Worker thread running the picture calls of a VA display off the application thread.
+//!
+
+#include <stdlib.h>
+#include <system_error>
+#include "media_libva_async_submit.h"
+#include "media_libva_common.h"
+#include "media_libva_util.h"
+
+thread_local bool DdiMediaAsyncSubmit::m_onWorker = false;
+
+static uint32_t DdiMediaAsyncSubmit_GetRequestedMask()
+{
+    static const uint32_t mask = []() {
+        const char *env = getenv("INTEL_MEDIA_ASYNC_SUBMIT");
+        return env ? (uint32_t)strtoul(env, nullptr, 0) : 0;
+    }();
+    return mask;
+}
+
+bool DdiMediaAsyncSubmit::IsRequested(uint32_t ctxType)
+{
+    uint32_t mask = DdiMediaAsyncSubmit_GetRequestedMask();
+    switch (ctxType)
+    {
+        case DDI_MEDIA_CONTEXT_TYPE_DECODER:
+            return (mask & 1) != 0;
+        case DDI_MEDIA_CONTEXT_TYPE_ENCODER:
+            return (mask & 2) != 0;
+        case DDI_MEDIA_CONTEXT_TYPE_VP:
+            return (mask & 4) != 0;
+        default:
+            return false;
+    }
+}
+
+bool DdiMediaAsyncSubmit::IsRequested()
+{
+    return (DdiMediaAsyncSubmit_GetRequestedMask() & 7) != 0;
+}
+
+DdiMediaAsyncSubmit::DdiMediaAsyncSubmit(uint32_t ringSize) :
+    m_ring(ringSize ? ringSize : 1)
+{
+    try
+    {
+        m_thread  = std::thread(&DdiMediaAsyncSubmit::Run, this);
+        m_started = true;
+    }
+    catch (const std::system_error &)
+    {
+        DDI_ASSERTMESSAGE("Failed to create async submission worker, contexts run synchronously.");
+    }
+}
+
+DdiMediaAsyncSubmit::~DdiMediaAsyncSubmit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_jobReady.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+VAStatus DdiMediaAsyncSubmit::AddContext(void *ctx)
+{
+    DDI_CHK_NULL(ctx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_started)
+    {
+        m_contexts[ctx] = Context();
+    }
+    return VA_STATUS_SUCCESS;
+}
+
+std::vector<VABufferID> DdiMediaAsyncSubmit::RemoveContext(void *ctx)
+{
+    std::vector<VABufferID> held;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_contexts.find(ctx);
+    if (it == m_contexts.end())
+    {
+        return held;
+    }
+    if (!m_onWorker)
+    {
+        WaitFence(lock, it->second.fence);
+    }
+    held.swap(it->second.held);
+    m_contexts.erase(it);
+    return held;
+}
+
+bool DdiMediaAsyncSubmit::IsQueued(void *ctx)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_contexts.find(ctx) != m_contexts.end();
+}
+
+void DdiMediaAsyncSubmit::HoldBuffers(void *ctx, const std::vector<VABufferID> &buffers)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_contexts.find(ctx);
+    if (it != m_contexts.end())
+    {
+        it->second.held.insert(it->second.held.end(), buffers.begin(), buffers.end());
+    }
+}
+
+std::vector<VABufferID> DdiMediaAsyncSubmit::ReleaseHeldBuffers(void *ctx)
+{
+    std::vector<VABufferID> held;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_contexts.find(ctx);
+    if (it != m_contexts.end())
+    {
+        held.swap(it->second.held);
+    }
+    return held;
+}
+
+VAStatus DdiMediaAsyncSubmit::Submit(void *ctx, SubmitFunc func, void *target)
+{
+    VAStatus earlier = VA_STATUS_SUCCESS;
+    VAStatus status  = Queue(ctx, std::move(func), target, &earlier);
+    return (earlier != VA_STATUS_SUCCESS) ? earlier : status;
+}
+
+VAStatus DdiMediaAsyncSubmit::Post(void *ctx, SubmitFunc func)
+{
+    return Queue(ctx, std::move(func), nullptr, nullptr);
+}
+
+VAStatus DdiMediaAsyncSubmit::Queue(void *ctx, SubmitFunc func, void *target, VAStatus *earlier)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_onWorker || m_contexts.find(ctx) == m_contexts.end())
+    {
+        lock.unlock();
+        return func();
+    }
+
+    // the worker frees a slot as soon as it takes a job
+    m_jobDone.wait(lock, [&]() { return m_ringCount < m_ring.size(); });
+
+    Context &context = m_contexts[ctx];
+    if (earlier)
+    {
+        *earlier       = context.status;
+        context.status = VA_STATUS_SUCCESS;
+    }
+
+    Job &job  = m_ring[(m_ringHead + m_ringCount) % m_ring.size()];
+    job.func  = std::move(func);
+    job.ctx   = ctx;
+    job.fence = ++m_queuedFence;
+    m_ringCount++;
+
+    context.fence = job.fence;
+    if (target)
+    {
+        context.target = target;
+    }
+    if (context.target)
+    {
+        m_surfaceFences[context.target] = job.fence;
+    }
+
+    lock.unlock();
+    m_jobReady.notify_one();
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiMediaAsyncSubmit::Wait(void *ctx)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_contexts.find(ctx);
+    if (m_onWorker || it == m_contexts.end())
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    WaitFence(lock, it->second.fence);
+
+    // the context can not be removed while one of its calls is waiting
+    VAStatus status   = it->second.status;
+    it->second.status = VA_STATUS_SUCCESS;
+    return status;
+}
+
+void DdiMediaAsyncSubmit::WaitIdle(void *ctx)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_contexts.find(ctx);
+    if (!m_onWorker && it != m_contexts.end())
+    {
+        WaitFence(lock, it->second.fence);
+    }
+}
+
+void DdiMediaAsyncSubmit::WaitSurface(void *surface)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_surfaceFences.find(surface);
+    if (m_onWorker || it == m_surfaceFences.end())
+    {
+        return;
+    }
+
+    uint64_t fence = it->second;
+    WaitFence(lock, fence);
+
+    // a job queued meanwhile may have moved the fence on
+    it = m_surfaceFences.find(surface);
+    if (it != m_surfaceFences.end() && it->second <= m_doneFence)
+    {
+        m_surfaceFences.erase(it);
+    }
+}
+
+bool DdiMediaAsyncSubmit::IsSurfaceBusy(void *surface)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_surfaceFences.find(surface);
+    return it != m_surfaceFences.end() && it->second > m_doneFence;
+}
+
+void DdiMediaAsyncSubmit::RemoveSurface(void *surface)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_surfaceFences.erase(surface);
+    for (auto &it : m_contexts)
+    {
+        if (it.second.target == surface)
+        {
+            it.second.target = nullptr;
+        }
+    }
+}
+
+void DdiMediaAsyncSubmit::WaitAll()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_onWorker)
+    {
+        WaitFence(lock, m_queuedFence);
+    }
+}
+
+void DdiMediaAsyncSubmit::WaitFence(std::unique_lock<std::mutex> &lock, uint64_t fence)
+{
+    m_jobDone.wait(lock, [&]() { return m_doneFence >= fence; });
+}
+
+void DdiMediaAsyncSubmit::Run()
+{
+    m_onWorker = true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_jobReady.wait(lock, [&]() { return m_ringCount > 0 || m_exit; });
+        // queued jobs are always run before exit
+        if (m_ringCount == 0)
+        {
+            break;
+        }
+
+        Job job = std::move(m_ring[m_ringHead]);
+        m_ring[m_ringHead] = Job();
+        m_ringHead = (m_ringHead + 1) % m_ring.size();
+        m_ringCount--;
+        lock.unlock();
+        m_jobDone.notify_all();
+
+        VAStatus status = job.func();
+
+        lock.lock();
+        if (status != VA_STATUS_SUCCESS)
+        {
+            DDI_ASSERTMESSAGE("Async picture call failed with status %d.", status);
+            auto it = m_contexts.find(job.ctx);
+            if (it != m_contexts.end() && it->second.status == VA_STATUS_SUCCESS)
+            {
+                it->second.status = status;
+            }
+        }
+        m_doneFence = job.fence;
+        m_jobDone.notify_all();
+    }
+}
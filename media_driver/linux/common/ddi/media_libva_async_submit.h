@@ -0,0 +1,220 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_async_submit.h
+//! \brief    Worker thread running the picture calls of a VA display off the application thread.
+//! \details  Enabled through the INTEL_MEDIA_ASYNC_SUBMIT environment variable, whose value
+//!           is a mask of the context types to run asynchronously: 1 decode, 2 encode, 4 vp.
+//!           BeginPicture, RenderPicture and EndPicture of those contexts are queued in a ring
+//!           and run by one worker in submission order, so work of different contexts reaches
+//!           the GPU in the order the application issued it. Every job gets a fence, and calls
+//!           which read the result of a job or the state of its context wait for that fence.
+//!
+#ifndef __MEDIA_LIBVA_ASYNC_SUBMIT_H__
+#define __MEDIA_LIBVA_ASYNC_SUBMIT_H__
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "va/va.h"
+
+class DdiMediaAsyncSubmit
+{
+public:
+    using SubmitFunc = std::function<VAStatus()>;
+
+    static const uint32_t m_defaultRingSize = 16;  //!< jobs queued before Submit blocks
+
+    //!
+    //! \brief    Check whether asynchronous submission is requested for a context type
+    //! \param    [in] ctxType
+    //!           DDI_MEDIA_CONTEXT_TYPE_xxx
+    //!
+    static bool IsRequested(uint32_t ctxType);
+
+    //!
+    //! \brief    Check whether asynchronous submission is requested for any context type
+    //!
+    static bool IsRequested();
+
+    //!
+    //! \brief    Constructor, starts the worker
+    //! \param    [in] ringSize
+    //!           Number of jobs which can be queued
+    //!
+    DdiMediaAsyncSubmit(uint32_t ringSize = m_defaultRingSize);
+
+    //!
+    //! \brief    Destructor, runs the queued jobs and stops the worker
+    //!
+    virtual ~DdiMediaAsyncSubmit();
+
+    //!
+    //! \brief    Queue the picture calls of a context from now on
+    //! \param    [in] ctx
+    //!           DDI context, as returned by DdiMedia_GetContextFromContextID
+    //!
+    VAStatus AddContext(void *ctx);
+
+    //!
+    //! \brief    Wait for the queued jobs of a context and stop queuing for it
+    //! \details  Must be called before the DDI context is destroyed
+    //! \return   std::vector<VABufferID>
+    //!           Buffers still held for the context, to be destroyed by the caller
+    //!
+    std::vector<VABufferID> RemoveContext(void *ctx);
+
+    //!
+    //! \brief    Check whether the picture calls of a context are queued
+    //!
+    bool IsQueued(void *ctx);
+
+    //!
+    //! \brief    Keep buffers created by a job of a context until the end of its picture
+    //!
+    void HoldBuffers(void *ctx, const std::vector<VABufferID> &buffers);
+
+    //!
+    //! \brief    Take the buffers held for a context
+    //!
+    std::vector<VABufferID> ReleaseHeldBuffers(void *ctx);
+
+    //!
+    //! \brief    Queue a job of a context
+    //! \details  Returns at once unless the ring is full. Runs the job inline if the context
+    //!           was not added or the worker could not be started.
+    //! \param    [in] ctx
+    //!           DDI context the job belongs to
+    //! \param    [in] func
+    //!           Job, it must only use state owned by the context or copied into it
+    //! \param    [in] target
+    //!           Surface rendered by this and the following jobs of the context, nullptr to
+    //!           keep the current one
+    //! \return   VAStatus
+    //!           First failure of an earlier job of the context not yet reported, else success
+    //!
+    VAStatus Submit(void *ctx, SubmitFunc func, void *target = nullptr);
+
+    //!
+    //! \brief    Queue a job of a context without reporting earlier failures
+    //! \details  Used by calls which queue work for a context they do not own, the failures
+    //!           of the context and of this job are kept for its next Wait or picture call
+    //! \param    [in] ctx
+    //!           DDI context the job belongs to
+    //! \param    [in] func
+    //!           Job, it must only use state owned by the context or copied into it
+    //! \return   VAStatus
+    //!           Status of the job if it ran inline, else VA_STATUS_SUCCESS
+    //!
+    VAStatus Post(void *ctx, SubmitFunc func);
+
+    //!
+    //! \brief    Wait for the queued jobs of a context
+    //! \return   VAStatus
+    //!           First failure of the jobs not yet reported, reported once
+    //!
+    VAStatus Wait(void *ctx);
+
+    //!
+    //! \brief    Wait for the queued jobs of a context, keeping a failure for the next Wait
+    //! \details  Used by buffer calls, which have no status of their own to return for it
+    //!
+    void WaitIdle(void *ctx);
+
+    //!
+    //! \brief    Wait for the jobs queued so far which render to a surface
+    //!
+    void WaitSurface(void *surface);
+
+    //!
+    //! \brief    Check whether a job rendering to a surface is still queued or running
+    //!
+    bool IsSurfaceBusy(void *surface);
+
+    //!
+    //! \brief    Forget a surface, called when it is destroyed after WaitAll
+    //!
+    void RemoveSurface(void *surface);
+
+    //!
+    //! \brief    Wait for all jobs queued so far
+    //! \details  Used by calls giving CPU access to a surface, which any queued job may read
+    //!
+    void WaitAll();
+
+protected:
+    struct Job
+    {
+        SubmitFunc func;
+        void      *ctx   = nullptr;
+        uint64_t   fence = 0;
+    };
+
+    struct Context
+    {
+        uint64_t fence  = 0;                   //!< Fence of the last queued job
+        VAStatus status = VA_STATUS_SUCCESS;   //!< First failure not yet reported
+        void    *target = nullptr;             //!< Surface rendered by the current picture
+        std::vector<VABufferID> held;          //!< Buffers created by jobs of the current picture
+    };
+
+    //!
+    //! \brief    Queue a job, or run it inline if the context is not queued
+    //! \param    [out] earlier
+    //!           First failure of an earlier job of the context not yet reported, reset to
+    //!           success in the context, nullptr to keep it there
+    //! \return   VAStatus
+    //!           Status of the job if it ran inline, else VA_STATUS_SUCCESS
+    //!
+    VAStatus Queue(void *ctx, SubmitFunc func, void *target, VAStatus *earlier);
+
+    //!
+    //! \brief    Wait until the job with the fence has finished, m_mutex must be held
+    //!
+    void WaitFence(std::unique_lock<std::mutex> &lock, uint64_t fence);
+
+    //!
+    //! \brief    Worker loop, runs the jobs in queue order
+    //!
+    void Run();
+
+    std::mutex                     m_mutex;            //!< Protects all members below
+    std::condition_variable        m_jobReady;         //!< Signalled when a job is queued or on exit
+    std::condition_variable        m_jobDone;          //!< Signalled when a job finished or left the ring
+    std::vector<Job>               m_ring;
+    uint32_t                       m_ringHead    = 0;  //!< Index of the oldest queued job
+    uint32_t                       m_ringCount   = 0;  //!< Number of queued jobs, the running one excluded
+    uint64_t                       m_queuedFence = 0;  //!< Fence of the last queued job
+    uint64_t                       m_doneFence   = 0;  //!< Fence of the last finished job, jobs finish in order
+    std::map<void *, Context>      m_contexts;
+    std::map<void *, uint64_t>     m_surfaceFences;    //!< Fence of the last job rendering to a surface
+    std::thread                    m_thread;
+    bool                           m_started     = false;
+    bool                           m_exit        = false;
+
+    static thread_local bool m_onWorker;     //!< Set on the worker so nested DDI calls never wait on themselves
+};
+
+#endif // __MEDIA_LIBVA_ASYNC_SUBMIT_H__
@@ -44,6 +44,7 @@ typedef MediaLibvaCapsFactory<MediaLibvaCaps, DDI_MEDIA_CONTEXT> CapsFactory;
 #endif
 
 #include "set"
+#include <algorithm>
 
 #ifndef VA_ENCRYPTION_TYPE_NONE
 #define VA_ENCRYPTION_TYPE_NONE 0x00000000
@@ -233,16 +234,42 @@ VAStatus MediaLibvaCaps::GetProfileEntrypointFromConfigId(
         return VA_STATUS_ERROR_INVALID_CONFIG;
     }
 
-    int32_t i;
-    for (i = 0; i < m_profileEntryCount; i++)
+    const std::vector<int16_t> *configEntryIdx = nullptr;
+    switch (codecType)
     {
-        if (CheckEntrypointCodecType(m_profileEntryTbl[i].m_entrypoint, codecType))
+        case videoDecode:
+            configEntryIdx = &m_decConfigEntryIdx;
+            break;
+        case videoEncode:
+            configEntryIdx = &m_encConfigEntryIdx;
+            break;
+        case videoProcess:
+            configEntryIdx = &m_vpConfigEntryIdx;
+            break;
+        default:
+            break;
+    }
+
+    int32_t i = m_profileEntryCount;
+    if (configEntryIdx != nullptr)
+    {
+        if (configOffset >= 0 && configOffset < (int32_t)configEntryIdx->size() && (*configEntryIdx)[configOffset] >= 0)
         {
-            int32_t configStart = m_profileEntryTbl[i].m_configStartIdx;
-            int32_t configEnd = m_profileEntryTbl[i].m_configStartIdx + m_profileEntryTbl[i].m_configNum;
-            if (configOffset >= configStart && configOffset < configEnd)
+            i = (*configEntryIdx)[configOffset];
+        }
+    }
+    else
+    {
+        for (i = 0; i < m_profileEntryCount; i++)
+        {
+            if (CheckEntrypointCodecType(m_profileEntryTbl[i].m_entrypoint, codecType))
             {
-                break;
+                int32_t configStart = m_profileEntryTbl[i].m_configStartIdx;
+                int32_t configEnd = m_profileEntryTbl[i].m_configStartIdx + m_profileEntryTbl[i].m_configNum;
+                if (configOffset >= configStart && configOffset < configEnd)
+                {
+                    break;
+                }
             }
         }
     }
@@ -277,6 +304,45 @@ VAStatus MediaLibvaCaps::AddProfileEntry(
     m_profileEntryTbl[m_profileEntryCount].m_attributes = attributeList;
     m_profileEntryTbl[m_profileEntryCount].m_configStartIdx = configStartIdx;
     m_profileEntryTbl[m_profileEntryCount].m_configNum = configNum;
+
+    std::vector<int16_t> *configEntryIdx = nullptr;
+    if (CheckEntrypointCodecType(entrypoint, videoDecode))
+    {
+        configEntryIdx = &m_decConfigEntryIdx;
+    }
+    else if (CheckEntrypointCodecType(entrypoint, videoEncode))
+    {
+        configEntryIdx = &m_encConfigEntryIdx;
+    }
+    else if (CheckEntrypointCodecType(entrypoint, videoProcess))
+    {
+        configEntryIdx = &m_vpConfigEntryIdx;
+    }
+    if (configEntryIdx != nullptr && configStartIdx >= 0 && configNum > 0)
+    {
+        if ((int32_t)configEntryIdx->size() < configStartIdx + configNum)
+        {
+            configEntryIdx->resize(configStartIdx + configNum, -1);
+        }
+        // The first entry covering a config wins, as the table used to be scanned in order
+        for (int32_t i = configStartIdx; i < configStartIdx + configNum; i++)
+        {
+            if ((*configEntryIdx)[i] < 0)
+            {
+                (*configEntryIdx)[i] = m_profileEntryCount;
+            }
+        }
+    }
+
+    uint64_t key = ((uint64_t)(uint32_t)profile << 32) | (uint32_t)entrypoint;
+    m_profileEntryIdx.emplace(key, m_profileEntryCount);
+
+    auto pos = std::lower_bound(m_profiles.begin(), m_profiles.end(), profile);
+    if (pos == m_profiles.end() || *pos != profile)
+    {
+        m_profiles.insert(pos, profile);
+    }
+
     m_profileEntryCount++;
 
     return VA_STATUS_SUCCESS;
@@ -284,22 +350,15 @@ VAStatus MediaLibvaCaps::AddProfileEntry(
 
 int32_t MediaLibvaCaps::GetProfileTableIdx(VAProfile profile, VAEntrypoint entrypoint)
 {
-    // initialize ret value to "invalid profile"
-    int32_t ret = -1;
-    for (int32_t i = 0; i < m_profileEntryCount; i++)
+    uint64_t key   = ((uint64_t)(uint32_t)profile << 32) | (uint32_t)entrypoint;
+    auto     entry = m_profileEntryIdx.find(key);
+    if (entry != m_profileEntryIdx.end())
     {
-        if (m_profileEntryTbl[i].m_profile == profile)
-        {
-            //there are such profile , but no such entrypoint
-            ret = -2;
-            if(m_profileEntryTbl[i].m_entrypoint == entrypoint)
-            {
-                return i;
-            }
-        }
+        return entry->second;
     }
 
-    return ret;
+    //there are such profile , but no such entrypoint, otherwise "invalid profile"
+    return std::binary_search(m_profiles.begin(), m_profiles.end(), profile) ? -2 : -1;
 }
 
 VAStatus MediaLibvaCaps::CreateAttributeList(AttribMap **attributeList)
@@ -2330,17 +2389,10 @@ VAStatus MediaLibvaCaps::QueryConfigProfiles(
 {
     DDI_CHK_NULL(profileList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(numProfiles, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
-    std::set<int32_t> profiles;
-    int32_t i;
-    for (i = 0; i < m_profileEntryCount; i++)
-    {
-        profiles.insert((int32_t)m_profileEntryTbl[i].m_profile);
-    }
-
-    std::set<int32_t>::iterator it;
-    for (it = profiles.begin(), i = 0; it != profiles.end(); ++it, i++)
+    int32_t i = 0;
+    for (auto profile : m_profiles)
     {
-        profileList[i] = (VAProfile)*it;
+        profileList[i++] = profile;
     }
 
     *numProfiles = i;
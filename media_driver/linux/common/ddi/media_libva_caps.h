@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #ifndef CONTEXT_PRIORITY_MAX
 #define CONTEXT_PRIORITY_MAX 1024
@@ -912,6 +913,18 @@ protected:
     std::vector<DecConfig> m_decConfigs; //!< Store supported decode configs
     std::vector<uint32_t> m_vpConfigs;   //!< Store supported vp configs
 
+    //!
+    //! \brief  Lookup tables filled by AddProfileEntry
+    //! \details The profile table is not changed once the caps are loaded, so config
+    //!          ID and profile/entrypoint queries are served by index instead of
+    //!          scanning the table.
+    //!
+    std::vector<int16_t> m_decConfigEntryIdx; //!< Profile table index of each decode config, -1 if none
+    std::vector<int16_t> m_encConfigEntryIdx; //!< Profile table index of each encode config, -1 if none
+    std::vector<int16_t> m_vpConfigEntryIdx;  //!< Profile table index of each vp config, -1 if none
+    std::unordered_map<uint64_t, int16_t> m_profileEntryIdx; //!< Profile table index keyed by profile and entrypoint
+    std::vector<VAProfile> m_profiles;        //!< Sorted unique profiles of the profile table
+
     bool m_vdencActive = false;  //!< If vdenc is active on current platform
 
     //!
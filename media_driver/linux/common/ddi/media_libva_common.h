@@ -146,6 +146,7 @@ typedef sem_t MEDIA_SEM_T, *PMEDIA_SEM_T;
 
 class MediaLibvaCaps;
 class MediaLibvaCapsNext;
+class DdiMediaAsyncSubmit;
 
 typedef enum _DDI_MEDIA_FORMAT
 {
@@ -345,6 +346,7 @@ typedef struct _DDI_MEDIA_BUFFER
     uint32_t               uiExportcount;
     uintptr_t              handle;
     bool                   bPostponedBufFree;
+    bool                   bAsyncStaged; // CPU copy of a buffer of a queued context, the buffer of the codec is created by its RenderPicture job
 
     bool                   bCFlushReq; // No LLC between CPU & GPU, requries to call CPU Flush for CPU mapped buffer
     bool                   bUseSysGfxMem;
@@ -491,6 +493,9 @@ struct DDI_MEDIA_CONTEXT
     // Media reset enable flag
     bool                bMediaResetEnable;
 
+    // Async EndPicture workers, only created when requested by INTEL_MEDIA_ASYNC_SUBMIT
+    DdiMediaAsyncSubmit *m_asyncSubmit;
+
     // Media memory decompression function
     void (* pfnMemoryDecompress)(
         PMOS_CONTEXT  pMosCtx,
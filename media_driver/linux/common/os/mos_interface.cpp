@@ -33,6 +33,7 @@
 #include "mos_os_virtualengine_singlepipe_specific_next.h"
 #include "mos_os_virtualengine_scalability_specific_next.h"
 #include "mos_graphicsresource_specific_next.h"
+#include "mos_cpu_profiler.h"
 #include "mos_bufmgr_priv.h"
 #include "drm_device.h"
 
@@ -979,6 +980,7 @@ MOS_STATUS MosInterface::SubmitCommandBuffer(
     bool                  nullRendering)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_MOS_SUBMIT);
 
     MOS_OS_CHK_NULL_RETURN(streamState);
 
@@ -1957,6 +1959,39 @@ void *MosInterface::LockMosResource(
     return pData;
 }
 
+void *MosInterface::LockMosResourceRegion(
+    MOS_STREAM_HANDLE   streamState,
+    MOS_RESOURCE_HANDLE resource,
+    PMOS_LOCK_PARAMS    flags,
+    uint32_t            rowStart,
+    uint32_t            rowNum)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    if (nullptr == streamState || nullptr == resource)
+    {
+        MOS_OS_ASSERTMESSAGE("input parameter streamState or resource is NULL.");
+        return nullptr;
+    }
+
+    if ((!resource->bConvertedFromDDIResource) && (resource->pGfxResourceNext))
+    {
+        if (nullptr == streamState->osDeviceContext)
+        {
+            MOS_OS_ASSERTMESSAGE("invalid osDeviceContext, skip lock");
+            return nullptr;
+        }
+
+        GraphicsResourceNext::LockParams params(flags);
+        params.m_rowStart = rowStart;
+        params.m_rowNum   = rowNum;
+        return resource->pGfxResourceNext->Lock(streamState->osDeviceContext, params);
+    }
+
+    // external resources have no region tracking
+    return GraphicsResourceSpecificNext::LockExternalResource(streamState, resource, flags);
+}
+
 MOS_STATUS MosInterface::UnlockMosResource(
     MOS_STREAM_HANDLE   streamState,
     MOS_RESOURCE_HANDLE resource)
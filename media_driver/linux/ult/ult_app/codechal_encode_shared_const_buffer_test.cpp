@@ -0,0 +1,219 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "codechal_encode_shared_const_buffer.h"
+
+//!
+//! The buffers live in system memory here, pOsContext of each interface
+//! stands for the device it is created on.
+//!
+static uint32_t g_allocCount = 0;
+static uint32_t g_freeCount  = 0;
+
+static GMM_CLIENT_CONTEXT *GetFakeGmmClientContext(PMOS_INTERFACE osInterface)
+{
+    return (GMM_CLIENT_CONTEXT *)osInterface->pOsContext;
+}
+
+#if MOS_MESSAGES_ENABLED
+static MOS_STATUS AllocateFakeResource(
+    PMOS_INTERFACE           osInterface,
+    PMOS_ALLOC_GFXRES_PARAMS params,
+    const char              *functionName,
+    const char              *filename,
+    int32_t                  line,
+    PMOS_RESOURCE            resource)
+#else
+static MOS_STATUS AllocateFakeResource(
+    PMOS_INTERFACE           osInterface,
+    PMOS_ALLOC_GFXRES_PARAMS params,
+    PMOS_RESOURCE            resource)
+#endif
+{
+    resource->pData = new uint8_t[params->dwBytes];
+    g_allocCount++;
+    return MOS_STATUS_SUCCESS;
+}
+
+#if MOS_MESSAGES_ENABLED
+static void FreeFakeResource(
+    PMOS_INTERFACE osInterface,
+    const char    *functionName,
+    const char    *filename,
+    int32_t        line,
+    PMOS_RESOURCE  resource)
+#else
+static void FreeFakeResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+#endif
+{
+    delete[] resource->pData;
+    resource->pData = nullptr;
+    g_freeCount++;
+}
+
+static void *LockFakeResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+{
+    return resource->pData;
+}
+
+static MOS_STATUS UnlockFakeResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+class SharedConstBufferUnderTest : public CodechalEncodeSharedConstBuffer
+{
+public:
+    using CodechalEncodeSharedConstBuffer::Entry;
+    using CodechalEncodeSharedConstBuffer::Hash;
+    using CodechalEncodeSharedConstBuffer::m_entries;
+};
+
+class CodechalEncodeSharedConstBufferTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        g_allocCount = 0;
+        g_freeCount  = 0;
+        InitOsInterface(m_osInterfaceA, &m_deviceA);
+        InitOsInterface(m_osInterfaceA2, &m_deviceA);
+        InitOsInterface(m_osInterfaceB, &m_deviceB);
+
+        for (uint32_t i = 0; i < sizeof(m_table1); i++)
+        {
+            m_table1[i] = (uint8_t)(i * 7);
+            m_table2[i] = (uint8_t)(i * 7);
+        }
+        m_table2[sizeof(m_table2) - 1] ^= 1;
+    }
+
+    void TearDown() override
+    {
+        EXPECT_TRUE(SharedConstBufferUnderTest::m_entries.empty());
+        EXPECT_EQ(g_allocCount, g_freeCount);
+    }
+
+    void InitOsInterface(MOS_INTERFACE &osInterface, int *device)
+    {
+        MOS_ZeroMemory(&osInterface, sizeof(osInterface));
+        osInterface.pOsContext             = (PMOS_CONTEXT)device;
+        osInterface.pfnGetGmmClientContext = GetFakeGmmClientContext;
+        osInterface.pfnAllocateResource    = AllocateFakeResource;
+        osInterface.pfnFreeResource        = FreeFakeResource;
+        osInterface.pfnLockResource        = LockFakeResource;
+        osInterface.pfnUnlockResource      = UnlockFakeResource;
+    }
+
+    int           m_deviceA = 0;
+    int           m_deviceB = 0;
+    MOS_INTERFACE m_osInterfaceA;
+    MOS_INTERFACE m_osInterfaceA2;  //!< second encoder on device A
+    MOS_INTERFACE m_osInterfaceB;
+    uint8_t       m_table1[1000];
+    uint8_t       m_table2[1000];   //!< differs from m_table1 in the last byte
+};
+
+TEST_F(CodechalEncodeSharedConstBufferTest, ShareSameContentPerDevice)
+{
+    const MOS_RESOURCE *resA  = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table1, sizeof(m_table1), "BrcConst");
+    const MOS_RESOURCE *resA2 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA2, m_table1, sizeof(m_table1), "BrcConst");
+    const MOS_RESOURCE *resB  = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceB, m_table1, sizeof(m_table1), "BrcConst");
+    const MOS_RESOURCE *res2  = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA2, m_table2, sizeof(m_table2), "BrcConst");
+    ASSERT_NE(nullptr, resA);
+    ASSERT_NE(nullptr, resB);
+    ASSERT_NE(nullptr, res2);
+
+    // encoders of one device share a content, other devices and other contents get their own
+    EXPECT_EQ(resA, resA2);
+    EXPECT_NE(resA, resB);
+    EXPECT_NE(resA, res2);
+    EXPECT_EQ(3u, g_allocCount);
+
+    // content uploaded, page padding cleared
+    EXPECT_EQ(0, memcmp(resA->pData, m_table1, sizeof(m_table1)));
+    EXPECT_EQ(0, memcmp(res2->pData, m_table2, sizeof(m_table2)));
+    EXPECT_EQ(0, resA->pData[CODECHAL_PAGE_SIZE - 1]);
+
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, resA);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA2, resA2);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceB, resB);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA2, res2);
+}
+
+TEST_F(CodechalEncodeSharedConstBufferTest, LastReleaseFrees)
+{
+    const MOS_RESOURCE *res1 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table1, sizeof(m_table1), "BrcConst");
+    const MOS_RESOURCE *res2 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA2, m_table1, sizeof(m_table1), "BrcConst");
+    const MOS_RESOURCE *res3 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table1, sizeof(m_table1), "BrcConst");
+    EXPECT_EQ(1u, g_allocCount);
+
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, res1);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA2, res2);
+    EXPECT_EQ(0u, g_freeCount);
+
+    // any encoder of the device may drop the last reference
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA2, res3);
+    EXPECT_EQ(1u, g_freeCount);
+    EXPECT_TRUE(SharedConstBufferUnderTest::m_entries.empty());
+
+    // released content is uploaded again
+    const MOS_RESOURCE *res4 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table1, sizeof(m_table1), "BrcConst");
+    EXPECT_EQ(2u, g_allocCount);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, res4);
+
+    // nullptr is ignored
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, nullptr);
+    EXPECT_EQ(2u, g_freeCount);
+}
+
+TEST_F(CodechalEncodeSharedConstBufferTest, HashCollisionComparesContent)
+{
+    const MOS_RESOURCE *res2 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table2, sizeof(m_table2), "BrcConst");
+    ASSERT_NE(nullptr, res2);
+
+    // file the entry of table2 under the hash of table1 to make the two collide
+    uint64_t hash1 = SharedConstBufferUnderTest::Hash(m_table1, sizeof(m_table1));
+    ASSERT_EQ(1u, SharedConstBufferUnderTest::m_entries.size());
+    SharedConstBufferUnderTest::Entry *entry2 = SharedConstBufferUnderTest::m_entries.begin()->second;
+    SharedConstBufferUnderTest::m_entries.clear();
+    SharedConstBufferUnderTest::m_entries.insert(std::make_pair(hash1, entry2));
+
+    const MOS_RESOURCE *res1 = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA, m_table1, sizeof(m_table1), "BrcConst");
+    ASSERT_NE(nullptr, res1);
+    EXPECT_NE(res1, res2);
+    EXPECT_EQ(2u, g_allocCount);
+    EXPECT_EQ(2u, SharedConstBufferUnderTest::m_entries.count(hash1));
+    EXPECT_EQ(0, memcmp(res1->pData, m_table1, sizeof(m_table1)));
+
+    // the colliding entry is skipped, table1 finds its own buffer
+    const MOS_RESOURCE *res1Again = CodechalEncodeSharedConstBuffer::Acquire(&m_osInterfaceA2, m_table1, sizeof(m_table1), "BrcConst");
+    EXPECT_EQ(res1, res1Again);
+    EXPECT_EQ(2u, g_allocCount);
+
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, res2);
+    EXPECT_EQ(1u, g_freeCount);
+    EXPECT_EQ(0, memcmp(res1->pData, m_table1, sizeof(m_table1)));
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA, res1);
+    CodechalEncodeSharedConstBuffer::Release(&m_osInterfaceA2, res1Again);
+}
@@ -0,0 +1,313 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_libva_async_submit.h"
+
+//!
+//! Contexts and surfaces are only keys for the queue, so any distinct
+//! addresses stand for them here.
+//!
+class DdiMediaAsyncSubmitTest : public testing::Test
+{
+protected:
+    //!
+    //! \brief    Job which blocks the worker until Open is called
+    //!
+    DdiMediaAsyncSubmit::SubmitFunc GateJob()
+    {
+        std::shared_future<void> gate = m_gate.get_future().share();
+        return [this, gate]() {
+            m_gateEntered = true;
+            gate.wait();
+            return VA_STATUS_SUCCESS;
+        };
+    }
+
+    void Open()
+    {
+        m_gate.set_value();
+    }
+
+    void WaitGateEntered()
+    {
+        while (!m_gateEntered)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::promise<void> m_gate;
+    std::atomic<bool>  m_gateEntered{false};
+
+    int m_ctx[2]     = {};
+    int m_surface[2] = {};
+};
+
+TEST_F(DdiMediaAsyncSubmitTest, KeepsSubmissionOrderAcrossContexts)
+{
+    DdiMediaAsyncSubmit submit;
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.AddContext(&m_ctx[0]));
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.AddContext(&m_ctx[1]));
+
+    std::vector<int> order;  // only written on the worker
+    for (int i = 0; i < 100; i++)
+    {
+        submit.Submit(&m_ctx[i % 3 == 0], [&order, i]() {
+            order.push_back(i);
+            return VA_STATUS_SUCCESS;
+        });
+    }
+    submit.WaitAll();
+
+    ASSERT_EQ(100u, order.size());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, QueuesSeveralPicturesOfAContext)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+
+    std::atomic<int> done{0};
+    submit.Submit(&m_ctx[0], GateJob(), &m_surface[0]);
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(VA_STATUS_SUCCESS, submit.Submit(&m_ctx[0], [&done]() {
+            done++;
+            return VA_STATUS_SUCCESS;
+        }));
+    }
+    // all of them were queued behind the blocked job
+    EXPECT_EQ(0, done);
+    EXPECT_TRUE(submit.IsSurfaceBusy(&m_surface[0]));
+
+    Open();
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Wait(&m_ctx[0]));
+    EXPECT_EQ(8, done);
+    EXPECT_FALSE(submit.IsSurfaceBusy(&m_surface[0]));
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, BlocksWhenRingIsFull)
+{
+    DdiMediaAsyncSubmit submit(2);
+    submit.AddContext(&m_ctx[0]);
+
+    submit.Submit(&m_ctx[0], GateJob());
+    WaitGateEntered();
+
+    auto nop = []() { return VA_STATUS_SUCCESS; };
+    submit.Submit(&m_ctx[0], nop);
+    submit.Submit(&m_ctx[0], nop);
+
+    std::atomic<bool> submitted{false};
+    std::thread producer([&]() {
+        submit.Submit(&m_ctx[0], nop);
+        submitted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(submitted);
+
+    Open();
+    producer.join();
+    EXPECT_TRUE(submitted);
+    submit.WaitAll();
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, WaitSurfaceOnlyWaitsForItsPictures)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+    submit.AddContext(&m_ctx[1]);
+
+    std::atomic<bool> rendered{false};
+    submit.Submit(&m_ctx[0], [&rendered]() {
+        rendered = true;
+        return VA_STATUS_SUCCESS;
+    }, &m_surface[0]);
+    submit.Submit(&m_ctx[1], GateJob(), &m_surface[1]);
+
+    submit.WaitSurface(&m_surface[0]);
+    EXPECT_TRUE(rendered);
+    EXPECT_FALSE(submit.IsSurfaceBusy(&m_surface[0]));
+    EXPECT_TRUE(submit.IsSurfaceBusy(&m_surface[1]));
+
+    Open();
+    submit.WaitSurface(&m_surface[1]);
+    EXPECT_FALSE(submit.IsSurfaceBusy(&m_surface[1]));
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, LaterJobsOfAContextRenderToItsTarget)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+
+    auto nop = []() { return VA_STATUS_SUCCESS; };
+    submit.Submit(&m_ctx[0], nop, &m_surface[0]);
+    // EndPicture keeps the target of BeginPicture
+    submit.Submit(&m_ctx[0], GateJob());
+
+    EXPECT_TRUE(submit.IsSurfaceBusy(&m_surface[0]));
+    Open();
+    submit.WaitSurface(&m_surface[0]);
+    EXPECT_FALSE(submit.IsSurfaceBusy(&m_surface[0]));
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, ReportsFailureOnce)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+    submit.AddContext(&m_ctx[1]);
+
+    auto fail = []() { return VA_STATUS_ERROR_DECODING_ERROR; };
+    auto nop  = []() { return VA_STATUS_SUCCESS; };
+
+    submit.Submit(&m_ctx[0], fail);
+    submit.Submit(&m_ctx[1], nop);
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Wait(&m_ctx[1]));
+    EXPECT_EQ(VA_STATUS_ERROR_DECODING_ERROR, submit.Wait(&m_ctx[0]));
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Wait(&m_ctx[0]));
+
+    // kept by WaitIdle, then returned by the next picture call
+    submit.Submit(&m_ctx[0], fail);
+    submit.WaitIdle(&m_ctx[0]);
+    EXPECT_EQ(VA_STATUS_ERROR_DECODING_ERROR, submit.Submit(&m_ctx[0], nop));
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Wait(&m_ctx[0]));
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, PostKeepsFailuresForWait)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+
+    auto fail = []() { return VA_STATUS_ERROR_DECODING_ERROR; };
+    auto nop  = []() { return VA_STATUS_SUCCESS; };
+
+    submit.Submit(&m_ctx[0], fail);
+    submit.WaitIdle(&m_ctx[0]);
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Post(&m_ctx[0], nop));
+    EXPECT_EQ(VA_STATUS_ERROR_DECODING_ERROR, submit.Wait(&m_ctx[0]));
+
+    // a failed posted job is reported by the context
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Post(&m_ctx[0], fail));
+    EXPECT_EQ(VA_STATUS_ERROR_DECODING_ERROR, submit.Wait(&m_ctx[0]));
+
+    // runs inline for a context which is not queued
+    EXPECT_EQ(VA_STATUS_ERROR_DECODING_ERROR, submit.Post(&m_ctx[1], fail));
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, NestedCallsRunInline)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+
+    bool nestedRan = false;
+    submit.Submit(&m_ctx[0], [&]() {
+        submit.WaitAll();
+        submit.Wait(&m_ctx[0]);
+        return submit.Submit(&m_ctx[0], [&nestedRan]() {
+            nestedRan = true;
+            return VA_STATUS_SUCCESS;
+        });
+    });
+    EXPECT_EQ(VA_STATUS_SUCCESS, submit.Wait(&m_ctx[0]));
+    EXPECT_TRUE(nestedRan);
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, RemoveContextDrainsItsJobs)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+
+    std::atomic<bool> done{false};
+    submit.Submit(&m_ctx[0], [&done]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        done = true;
+        return VA_STATUS_SUCCESS;
+    });
+    submit.RemoveContext(&m_ctx[0]);
+    EXPECT_TRUE(done);
+
+    // not queued any more
+    std::thread::id caller = std::this_thread::get_id();
+    std::thread::id runner;
+    submit.Submit(&m_ctx[0], [&runner]() {
+        runner = std::this_thread::get_id();
+        return VA_STATUS_SUCCESS;
+    });
+    EXPECT_EQ(caller, runner);
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, HeldBuffersAreReleasedOnceByEndOrRemove)
+{
+    DdiMediaAsyncSubmit submit;
+    submit.AddContext(&m_ctx[0]);
+    submit.AddContext(&m_ctx[1]);
+    EXPECT_TRUE(submit.IsQueued(&m_ctx[0]));
+
+    // RenderPicture jobs hold the buffers they create, the EndPicture job takes them
+    submit.Submit(&m_ctx[0], [&submit, this]() {
+        submit.HoldBuffers(&m_ctx[0], {1, 2});
+        submit.HoldBuffers(&m_ctx[1], {7});
+        return VA_STATUS_SUCCESS;
+    });
+    std::vector<VABufferID> released;
+    submit.Submit(&m_ctx[0], [&submit, &released, this]() {
+        submit.HoldBuffers(&m_ctx[0], {3});
+        released = submit.ReleaseHeldBuffers(&m_ctx[0]);
+        return VA_STATUS_SUCCESS;
+    });
+    submit.Wait(&m_ctx[0]);
+    EXPECT_EQ((std::vector<VABufferID>{1, 2, 3}), released);
+    EXPECT_TRUE(submit.ReleaseHeldBuffers(&m_ctx[0]).empty());
+
+    // a picture never ended leaves its buffers to the caller of RemoveContext
+    EXPECT_EQ((std::vector<VABufferID>{7}), submit.RemoveContext(&m_ctx[1]));
+    EXPECT_FALSE(submit.IsQueued(&m_ctx[1]));
+
+    submit.HoldBuffers(&m_ctx[1], {8});
+    EXPECT_TRUE(submit.ReleaseHeldBuffers(&m_ctx[1]).empty());
+}
+
+TEST_F(DdiMediaAsyncSubmitTest, DestructorRunsQueuedJobs)
+{
+    std::atomic<int> done{0};
+    {
+        DdiMediaAsyncSubmit submit;
+        submit.AddContext(&m_ctx[0]);
+        for (int i = 0; i < 4; i++)
+        {
+            submit.Submit(&m_ctx[0], [&done]() {
+                done++;
+                return VA_STATUS_SUCCESS;
+            });
+        }
+    }
+    EXPECT_EQ(4, done);
+}
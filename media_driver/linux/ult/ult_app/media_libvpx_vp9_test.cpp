@@ -0,0 +1,328 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+#include "media_libva_encoder.h"
+#include "media_libvpx_vp9.h"
+
+//!
+//! \brief    Uncompressed header written by the bit-at-a-time writer that
+//!           media_libvpx_vp9.cpp used before bit writes were batched, with
+//!           the first tile row flag written as a single bit
+//!
+struct Vp9GoldenHeader
+{
+    uint32_t             profile;
+    vp9_header_bitoffset offset;
+    uint32_t             size;
+    uint8_t              data[64];
+};
+
+// One entry per RandomizeParams call, starting from the fixture seed
+static const Vp9GoldenHeader s_goldenHeaders[] =
+{
+    {1, {112, 144, 101, 160, 187, 0, 0}, 26,
+        {0xa5, 0x6c, 0xc8, 0xe8, 0x1d, 0x4b, 0x12, 0xd1, 0x84, 0xa2, 0x03, 0x40, 0xe0, 0x73, 0x87, 0x96,
+        0xce, 0xde, 0x87, 0x96, 0xc2, 0xd1, 0xa3, 0x40, 0x00, 0x00}},
+    {3, {131, 163, 120, 179, 206, 0, 0}, 28,
+        {0xb3, 0x09, 0x30, 0x68, 0x40, 0x17, 0xe1, 0xe1, 0xe0, 0x13, 0x31, 0x6f, 0x50, 0x09, 0x9b, 0xe9,
+        0x75, 0xbc, 0x96, 0x3e, 0x95, 0xbc, 0x8d, 0x92, 0xbe, 0x6c, 0x00, 0x00}},
+    {1, {85, 117, 74, 133, 393, 151, 0}, 52,
+        {0xa6, 0x94, 0x23, 0x38, 0x02, 0x4b, 0x88, 0x12, 0x81, 0x13, 0x7d, 0xd7, 0xb5, 0x14, 0x5d, 0xd7,
+        0xb6, 0x5a, 0x77, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0x47, 0x15, 0xf5, 0x3c, 0xc7,
+        0xb8, 0x46, 0x55, 0xc8, 0x1a, 0x35, 0x54, 0xf9, 0x4d, 0x31, 0x87, 0x16, 0x45, 0xb3, 0xc1, 0xe1,
+        0x55, 0x80, 0x00, 0x00}},
+    {3, {115, 147, 104, 163, 179, 0, 0}, 25,
+        {0xb2, 0x81, 0xee, 0xbc, 0x0c, 0xb8, 0x02, 0x85, 0x46, 0x5c, 0x00, 0x68, 0xad, 0xc4, 0x72, 0x5f,
+        0xf0, 0x77, 0xb2, 0x5f, 0xfa, 0x61, 0x60, 0x00, 0x00}},
+    {1, {87, 119, 76, 135, 323, 153, 0}, 43,
+        {0xa0, 0x49, 0x83, 0x42, 0x00, 0x02, 0x12, 0x36, 0xf2, 0xf7, 0x87, 0x77, 0xcd, 0xc3, 0xf3, 0x77,
+        0xcd, 0xaa, 0x6b, 0x5f, 0x0d, 0x0d, 0x74, 0x93, 0x3b, 0xff, 0x6a, 0x14, 0xfc, 0x41, 0xad, 0xe4,
+        0xbb, 0xbc, 0xc3, 0x6d, 0xdd, 0xef, 0x7d, 0xa6, 0x40, 0x00, 0x00}},
+    {0, {115, 147, 104, 163, 196, 191, 0}, 27,
+        {0x86, 0x82, 0xaf, 0xd8, 0x0a, 0x88, 0x07, 0x89, 0x47, 0xc4, 0x44, 0xac, 0x37, 0xdb, 0x72, 0x1c,
+        0x7a, 0xbb, 0xf2, 0x1c, 0x67, 0x99, 0xeb, 0xf4, 0xc0, 0x00, 0x00}},
+    {2, {117, 149, 106, 165, 181, 0, 0}, 25,
+        {0x90, 0x49, 0x83, 0x42, 0x00, 0x2d, 0xa0, 0x48, 0x64, 0x4e, 0xf8, 0x75, 0x62, 0xc4, 0xdc, 0x26,
+        0x76, 0x8c, 0x7c, 0x26, 0x75, 0x28, 0x78, 0x00, 0x00}},
+    {1, {79, 111, 68, 127, 143, 0, 0}, 20,
+        {0xa7, 0xdf, 0x89, 0xe0, 0x22, 0x10, 0x1c, 0x1c, 0x60, 0xc7, 0xc3, 0xc7, 0x5b, 0x29, 0xc3, 0xc7,
+        0x0e, 0x14, 0x00, 0x00}},
+    {0, {117, 149, 106, 165, 367, 188, 0}, 48,
+        {0x86, 0x8c, 0xba, 0xd0, 0x05, 0xc8, 0x07, 0x10, 0x42, 0x99, 0x01, 0x8b, 0x2a, 0x1c, 0xde, 0xa7,
+        0xa4, 0x4d, 0x0e, 0xa7, 0xa0, 0x9a, 0x6d, 0xaa, 0x6d, 0x88, 0xaf, 0x0f, 0x2e, 0xeb, 0xfc, 0x37,
+        0x6f, 0xeb, 0x39, 0xc8, 0x7f, 0xe4, 0xb8, 0x32, 0x4a, 0xe5, 0xc8, 0x8b, 0xe2, 0x34, 0x00, 0x00}},
+    {2, {95, 127, 84, 143, 163, 0, 0}, 23,
+        {0x96, 0xd2, 0x60, 0xd0, 0x80, 0xd8, 0x25, 0x24, 0x38, 0x5a, 0xca, 0xdf, 0x15, 0xfd, 0xc3, 0x6d,
+        0x15, 0xfc, 0x96, 0xa8, 0x60, 0x00, 0x00}},
+    {0, {116, 148, 105, 164, 186, 0, 0}, 26,
+        {0x80, 0x49, 0x83, 0x42, 0x00, 0xb4, 0x11, 0x9b, 0x48, 0x5a, 0x08, 0x51, 0xf0, 0x15, 0x7d, 0x2e,
+        0x9b, 0x7e, 0xcd, 0x2e, 0x99, 0x53, 0x66, 0xc0, 0x00, 0x00}},
+    {3, {131, 163, 120, 179, 200, 0, 0}, 27,
+        {0xb3, 0x09, 0x30, 0x68, 0x40, 0x02, 0x63, 0x4b, 0xc0, 0xdf, 0x90, 0x6d, 0x30, 0x53, 0x7a, 0xae,
+        0x70, 0xba, 0xda, 0xfd, 0x30, 0xba, 0xc1, 0xee, 0xcb, 0x00, 0x00}},
+    {2, {82, 114, 71, 130, 326, 148, 0}, 43,
+        {0x95, 0x0f, 0x3d, 0x68, 0x19, 0xb7, 0x0c, 0x69, 0x12, 0xc4, 0xff, 0x77, 0x20, 0xff, 0xff, 0x77,
+        0x27, 0xdf, 0xaa, 0x28, 0x8f, 0x32, 0xad, 0xcb, 0xc0, 0xe4, 0x2b, 0xfd, 0xa8, 0x8e, 0x12, 0x1f,
+        0xf0, 0xbb, 0x5b, 0xaf, 0xa4, 0x6b, 0x11, 0x9a, 0x28, 0x00, 0x00}},
+    {3, {119, 151, 108, 167, 461, 195, 0}, 60,
+        {0xb0, 0xa4, 0xc1, 0xa1, 0x00, 0x04, 0x21, 0x8b, 0x0d, 0xc0, 0x1c, 0xc3, 0xb0, 0xad, 0xff, 0x23,
+        0x3b, 0x73, 0xf5, 0x23, 0x3b, 0x9d, 0xe6, 0x37, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xfe, 0x98, 0xf9, 0xcb, 0x2e, 0x7d, 0x8b, 0xfe, 0xfb, 0x8b, 0xb2, 0x21, 0x3f,
+        0xbe, 0xc9, 0xaa, 0x26, 0xbe, 0x9c, 0xa9, 0x93, 0x3a, 0xd8, 0x00, 0x00}},
+    {1, {84, 116, 73, 132, 154, 0, 0}, 22,
+        {0xa4, 0x01, 0x7e, 0xb0, 0x03, 0x6e, 0x82, 0x35, 0x18, 0xf6, 0xbf, 0x48, 0x4e, 0xba, 0x9f, 0x48,
+        0x4c, 0x82, 0x76, 0xc0, 0x00, 0x00}},
+    {1, {117, 149, 106, 165, 188, 183, 0}, 26,
+        {0xa3, 0x49, 0x83, 0x42, 0x00, 0x13, 0xc8, 0x19, 0x19, 0x1a, 0xca, 0x0c, 0x8c, 0x4c, 0xfc, 0x25,
+        0x4e, 0xdc, 0x04, 0x25, 0x4d, 0x41, 0x84, 0xc0, 0x00, 0x00}},
+    {0, {122, 154, 111, 170, 185, 0, 0}, 26,
+        {0x86, 0x52, 0x60, 0xd0, 0xb4, 0x05, 0x76, 0x45, 0x48, 0x23, 0xef, 0xc2, 0xa4, 0x00, 0x3d, 0xf9,
+        0xe0, 0xf9, 0x3c, 0x79, 0xe0, 0xf4, 0x42, 0x00, 0x00, 0x00}},
+    {1, {97, 129, 86, 145, 268, 173, 0}, 36,
+        {0xa6, 0x52, 0x60, 0xd0, 0x80, 0x36, 0x81, 0x24, 0x8d, 0x65, 0xb6, 0xb7, 0xe4, 0xe7, 0xe9, 0x6b,
+        0xe4, 0xe7, 0xe7, 0xd1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x30, 0x00, 0x00}},
+    {3, {87, 119, 76, 135, 156, 0, 0}, 22,
+        {0xb0, 0xa4, 0xc1, 0xa1, 0x00, 0x0e, 0x5e, 0x86, 0x6d, 0x32, 0xd7, 0x11, 0xab, 0x01, 0xb5, 0x11,
+        0xaa, 0x39, 0xf8, 0xb0, 0x00, 0x00}},
+    {1, {130, 162, 119, 178, 363, 191, 0}, 48,
+        {0xa4, 0xe9, 0x30, 0x68, 0x40, 0x1b, 0xc0, 0x24, 0xc1, 0xf4, 0xe2, 0x8e, 0x40, 0xfa, 0x72, 0xa6,
+        0xf6, 0xa8, 0xe8, 0x75, 0xb6, 0xa8, 0xf7, 0xc5, 0x71, 0xb5, 0xb7, 0x2f, 0xc7, 0x18, 0x65, 0x55,
+        0x40, 0x9e, 0x85, 0x79, 0x07, 0x1b, 0x95, 0x4c, 0x6f, 0x38, 0xc5, 0x5f, 0x40, 0x60, 0x00, 0x00}},
+    {0, {123, 155, 112, 171, 433, 194, 0}, 57,
+        {0x84, 0xa9, 0x30, 0x68, 0x4c, 0x62, 0xd6, 0x20, 0x39, 0x51, 0x6b, 0x10, 0xa2, 0x97, 0x46, 0xfa,
+        0xd4, 0x94, 0x50, 0xba, 0xd4, 0x94, 0xde, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xa9, 0x56, 0x82, 0x7d, 0x0d, 0xb9, 0x8a, 0x6d, 0xe6, 0xea, 0x8f, 0x7a, 0x1d, 0xe6, 0x27, 0x99,
+        0x72, 0xa9, 0xec, 0x83, 0x2b, 0xcd, 0x00, 0x00, 0x00}},
+    {3, {127, 159, 116, 175, 195, 0, 0}, 27,
+        {0xb3, 0xa4, 0xc1, 0xa1, 0x00, 0x64, 0x02, 0xc5, 0x02, 0x84, 0x45, 0x47, 0xc1, 0x42, 0x1a, 0xdf,
+        0xa5, 0xff, 0xb5, 0x4b, 0xa5, 0xfe, 0x3d, 0x18, 0x40, 0x00, 0x00}},
+    {0, {114, 146, 103, 162, 189, 0, 0}, 26,
+        {0x83, 0x49, 0x83, 0x42, 0x00, 0xe1, 0x61, 0x9d, 0x38, 0x7e, 0x88, 0xce, 0x9e, 0x5f, 0xee, 0x23,
+        0xa6, 0x61, 0x6e, 0x23, 0x90, 0x56, 0xec, 0xf0, 0x00, 0x00}},
+    {2, {115, 147, 104, 163, 196, 191, 0}, 27,
+        {0x93, 0x49, 0x83, 0x42, 0x00, 0xe8, 0x30, 0x08, 0x54, 0x60, 0x64, 0x04, 0x29, 0x96, 0xf1, 0x9f,
+        0x1c, 0x14, 0x51, 0x9f, 0x0d, 0xbe, 0xdd, 0x34, 0xa0, 0x00, 0x00}},
+    {3, {128, 160, 117, 176, 199, 194, 0}, 27,
+        {0xb2, 0xd2, 0x60, 0xd0, 0x80, 0x08, 0x84, 0xe5, 0x43, 0xf2, 0x60, 0x61, 0x21, 0xf9, 0x3d, 0x4b,
+        0xf5, 0xb6, 0xa4, 0x84, 0xf5, 0xb6, 0x01, 0x3f, 0x96, 0x00, 0x00}},
+    {1, {119, 151, 108, 167, 358, 185, 0}, 47,
+        {0xa2, 0x49, 0x83, 0x42, 0x00, 0x18, 0x2e, 0x11, 0x07, 0x04, 0xb1, 0x11, 0xa9, 0x30, 0x27, 0x41,
+        0x3b, 0x5b, 0xe5, 0x41, 0x3b, 0xab, 0xc1, 0x52, 0xad, 0xa4, 0xf0, 0x32, 0x55, 0xa1, 0xee, 0x92,
+        0x3e, 0x5f, 0x43, 0x5f, 0xa5, 0xd1, 0x6e, 0xd2, 0xf2, 0x2e, 0x77, 0x08, 0x6c, 0x00, 0x00}},
+    {2, {124, 156, 113, 172, 372, 195, 0}, 49,
+        {0x95, 0xa4, 0xc1, 0xa1, 0x00, 0x6c, 0x3e, 0xf4, 0x68, 0x16, 0x1d, 0xf0, 0x08, 0xca, 0x1a, 0xbf,
+        0x6c, 0xaa, 0xd9, 0xdf, 0x6c, 0xa5, 0x77, 0x74, 0x57, 0xa7, 0xd6, 0x7c, 0x9b, 0x26, 0xb3, 0xe9,
+        0x5b, 0x37, 0x34, 0x43, 0xff, 0xd9, 0x60, 0xf5, 0x4e, 0x63, 0xd5, 0x7f, 0x0c, 0x1e, 0xb0, 0x00,
+        0x00}},
+    {2, {117, 149, 106, 165, 182, 0, 0}, 25,
+        {0x90, 0x49, 0x83, 0x42, 0x00, 0xe9, 0x78, 0x4c, 0x2c, 0x66, 0xc0, 0x09, 0xb4, 0x50, 0xdd, 0x9f,
+        0x3f, 0xc6, 0xbd, 0x9f, 0x3f, 0x98, 0x6c, 0x00, 0x00}},
+    {3, {119, 151, 108, 167, 360, 190, 0}, 47,
+        {0xb1, 0xa4, 0xc1, 0xa1, 0x00, 0x0f, 0x12, 0x04, 0xe1, 0xc6, 0xf3, 0xc2, 0x70, 0xf4, 0x87, 0xcf,
+        0xa7, 0xcf, 0x67, 0xcf, 0xa7, 0x04, 0x93, 0x8a, 0xdc, 0xed, 0x8c, 0x0b, 0x1e, 0x6a, 0xf9, 0x67,
+        0x2e, 0xc7, 0x76, 0x1d, 0xc6, 0xd1, 0x83, 0xec, 0xbb, 0x89, 0xa6, 0x2f, 0x1c, 0x00, 0x00}},
+    {3, {112, 144, 101, 160, 355, 183, 0}, 47,
+        {0xb3, 0xf9, 0xc9, 0xc0, 0x0c, 0xd8, 0x12, 0xa6, 0x86, 0x6c, 0x05, 0x6a, 0xe2, 0xab, 0xe6, 0xa0,
+        0xb1, 0xb0, 0xe6, 0xa0, 0x29, 0x97, 0x75, 0x69, 0x9c, 0xf3, 0x6e, 0x6f, 0xc6, 0x09, 0xf8, 0x5b,
+        0x10, 0x1d, 0x89, 0x50, 0x91, 0x06, 0x25, 0x4c, 0xb4, 0x07, 0x83, 0x8a, 0x80, 0x00, 0x00}},
+    {0, {119, 151, 108, 167, 279, 185, 0}, 37,
+        {0x85, 0xa4, 0xc1, 0xa1, 0x5f, 0x0b, 0x50, 0x0d, 0x3a, 0xc7, 0x20, 0x44, 0xeb, 0x3f, 0x1f, 0xc3,
+        0x59, 0xdd, 0x5f, 0xc3, 0x58, 0x54, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xf0, 0x00, 0x00}},
+    {3, {119, 151, 108, 167, 189, 0, 0}, 26,
+        {0xb1, 0xa4, 0xc1, 0xa1, 0x00, 0x0b, 0x9f, 0x86, 0x03, 0xc2, 0x3f, 0x43, 0x01, 0xe8, 0x6f, 0xe5,
+        0x97, 0x1b, 0xdd, 0xe5, 0x97, 0x44, 0x54, 0xd8, 0x00, 0x00}},
+};
+
+class MediaLibvpxVp9Test : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_encodeCtx.pPicParams    = &m_picParams;
+        m_encodeCtx.pVpxSegParams = &m_segParams;
+    }
+
+    uint32_t NextRandom()
+    {
+        // xorshift32, the golden headers depend on this exact sequence
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed;
+    }
+
+    int32_t Random(int32_t minValue, int32_t maxValue)
+    {
+        return minValue + (int32_t)(NextRandom() % (uint32_t)(maxValue - minValue + 1));
+    }
+
+    //!
+    //! \brief    Fill picture and segment parameters with pseudo random in-range values
+    //!
+    void RandomizeParams()
+    {
+        MOS_ZeroMemory(&m_picParams, sizeof(m_picParams));
+        MOS_ZeroMemory(&m_segParams, sizeof(m_segParams));
+
+        m_picParams.PicFlags.value       = NextRandom();
+        m_picParams.RefFlags.value       = NextRandom();
+        m_picParams.DstFrameWidthMinus1  = (uint16_t)Random(15, 8191);
+        m_picParams.DstFrameHeightMinus1 = (uint16_t)Random(15, 8191);
+        m_picParams.SrcFrameWidthMinus1  = Random(0, 1) ? m_picParams.DstFrameWidthMinus1 : (uint16_t)Random(15, 8191);
+        m_picParams.SrcFrameHeightMinus1 = Random(0, 1) ? m_picParams.DstFrameHeightMinus1 : (uint16_t)Random(15, 8191);
+
+        m_picParams.filter_level    = (uint8_t)Random(0, 63);
+        m_picParams.sharpness_level = (uint8_t)Random(0, 7);
+        for (auto &delta : m_picParams.LFRefDelta)
+        {
+            delta = (char)Random(-63, 63);
+        }
+        for (auto &delta : m_picParams.LFModeDelta)
+        {
+            delta = (char)Random(-63, 63);
+        }
+
+        m_picParams.LumaACQIndex        = (uint8_t)Random(0, 255);
+        m_picParams.LumaDCQIndexDelta   = Random(0, 1) ? (char)Random(-15, 15) : 0;
+        m_picParams.ChromaDCQIndexDelta = Random(0, 1) ? (char)Random(-15, 15) : 0;
+        m_picParams.ChromaACQIndexDelta = Random(0, 1) ? (char)Random(-15, 15) : 0;
+
+        for (auto &segData : m_segParams.SegData)
+        {
+            segData.SegmentFlags.value  = (uint8_t)Random(0, 15);
+            segData.SegmentQIndexDelta  = (int16_t)Random(-255, 255);
+            segData.SegmentLFLevelDelta = (char)Random(-63, 63);
+        }
+
+        // tile columns must stay within the range allowed for the frame width
+        int32_t sbCols         = (m_picParams.DstFrameWidthMinus1 + 64) / 64;
+        int32_t minLog2TileCol = 0;
+        int32_t maxLog2TileCol = 1;
+        while ((64 << minLog2TileCol) < sbCols)
+        {
+            minLog2TileCol++;
+        }
+        while ((sbCols >> maxLog2TileCol) >= 4)
+        {
+            maxLog2TileCol++;
+        }
+        m_picParams.log2_tile_columns = (uint8_t)Random(minLog2TileCol, maxLog2TileCol - 1);
+        m_picParams.log2_tile_rows    = (uint8_t)Random(0, 2);
+    }
+
+    void WriteHeader(uint32_t profile)
+    {
+        // stale bytes must not leak into the padding of the last byte
+        memset(m_header, 0xa5, sizeof(m_header));
+        ASSERT_TRUE(Vp9WriteUncompressHeader(&m_encodeCtx, profile, m_header, &m_headerLen, &m_offset));
+    }
+
+    uint32_t ReadBits(uint32_t bitOffset, uint32_t bits)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = bitOffset; i < bitOffset + bits; i++)
+        {
+            value = (value << 1) | ((m_header[i / 8] >> (7 - i % 8)) & 1);
+        }
+        return value;
+    }
+
+    DDI_ENCODE_CONTEXT              m_encodeCtx = {};
+    CODEC_VP9_ENCODE_PIC_PARAMS     m_picParams = {};
+    CODEC_VP9_ENCODE_SEGMENT_PARAMS m_segParams = {};
+    uint32_t                        m_seed        = 0x5650;
+    uint8_t                         m_header[256] = {};
+    uint32_t                        m_headerLen   = 0;
+    vp9_header_bitoffset            m_offset      = {};
+};
+
+TEST_F(MediaLibvpxVp9Test, RandomHeadersMatchGoldenBytes)
+{
+    for (uint32_t i = 0; i < sizeof(s_goldenHeaders) / sizeof(s_goldenHeaders[0]); i++)
+    {
+        const Vp9GoldenHeader &golden = s_goldenHeaders[i];
+
+        RandomizeParams();
+        uint32_t profile = (uint32_t)Random(VP9_PROFILE_0, VP9_PROFILE_3);
+        ASSERT_EQ(golden.profile, profile) << "parameter sequence changed";
+
+        WriteHeader(profile);
+        ASSERT_EQ(golden.size, m_headerLen) << "header " << i;
+        EXPECT_EQ(0, memcmp(golden.data, m_header, m_headerLen)) << "header " << i;
+        EXPECT_EQ(0, memcmp(&golden.offset, &m_offset, sizeof(m_offset))) << "header " << i;
+    }
+}
+
+TEST_F(MediaLibvpxVp9Test, LoopFilterAndSegmentationFields)
+{
+    RandomizeParams();
+    m_picParams.PicFlags.fields.frame_type                   = 0;
+    m_picParams.PicFlags.fields.segmentation_enabled         = 1;
+    m_picParams.PicFlags.fields.segmentation_update_map      = 1;
+    m_picParams.PicFlags.fields.segmentation_temporal_update = 1;
+    m_picParams.PicFlags.fields.seg_update_data              = 1;
+    m_picParams.filter_level                                 = 41;
+    m_picParams.sharpness_level                              = 5;
+    m_picParams.LFRefDelta[0]                                = 1;
+    m_picParams.LFRefDelta[1]                                = -63;
+    m_picParams.LumaACQIndex                                 = 0x9c;
+    m_segParams.SegData[0].SegmentQIndexDelta                = -200;
+    m_segParams.SegData[0].SegmentLFLevelDelta               = 17;
+    m_segParams.SegData[0].SegmentFlags.value                = 0;
+    WriteHeader(VP9_PROFILE_0);
+
+    EXPECT_EQ(41u, ReadBits(m_offset.bit_offset_lf_level, 6));
+    EXPECT_EQ(5u, ReadBits(m_offset.bit_offset_lf_level + 6, 3));
+    // update flag, 6 bit magnitude, sign
+    EXPECT_EQ((1u << 7) | (1u << 1), ReadBits(m_offset.bit_offset_ref_lf_delta, 8));
+    EXPECT_EQ((1u << 7) | (63u << 1) | 1, ReadBits(m_offset.bit_offset_ref_lf_delta + 8, 8));
+    EXPECT_EQ(0x9cu, ReadBits(m_offset.bit_offset_qindex, 8));
+
+    // 7 tree probs and 3 pred probs of 9 bits, then update_data and abs_delta
+    uint32_t segData = m_offset.bit_offset_segmentation + 1 + 10 * 9 + 2;
+    EXPECT_EQ(0x1ffu, ReadBits(m_offset.bit_offset_segmentation, 9));
+    EXPECT_EQ((1u << 9) | (200u << 1) | 1, ReadBits(segData, 10));
+    EXPECT_EQ((1u << 7) | (17u << 1), ReadBits(segData + 10, 8));
+    EXPECT_EQ(0u, ReadBits(segData + 18, 2));
+}
+
+TEST_F(MediaLibvpxVp9Test, TileRowsAreCodedAsTwoFlags)
+{
+    const uint32_t expectedBits[3][2] = {{1, 0}, {2, 2}, {2, 3}};  // {bit count, bits}
+
+    RandomizeParams();
+    m_picParams.DstFrameWidthMinus1 = 4095;
+    m_picParams.log2_tile_columns   = 2;
+    for (uint8_t log2TileRows = 0; log2TileRows < 3; log2TileRows++)
+    {
+        m_picParams.log2_tile_rows = log2TileRows;
+        WriteHeader(VP9_PROFILE_0);
+
+        uint32_t bits = expectedBits[log2TileRows][0];
+        EXPECT_EQ(expectedBits[log2TileRows][1], ReadBits(m_offset.bit_offset_first_partition_size - bits, bits));
+        // tile columns increment and end bits stay intact in front of the rows
+        EXPECT_EQ(2u, ReadBits(m_offset.bit_offset_first_partition_size - bits - 2, 2));
+    }
+}
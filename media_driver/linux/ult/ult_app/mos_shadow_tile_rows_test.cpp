@@ -0,0 +1,144 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_graphicsresource_specific_next.h"
+
+//!
+//! Region locks of the s/w untiling shadow are checked against converting
+//! the whole surface with MosSwizzleData, as locks did before.
+//!
+class MosShadowTileRowsTest : public testing::TestWithParam<int32_t>
+{
+protected:
+    static const uint32_t m_pitch  = 512;   // 4 TileY tiles
+    static const uint32_t m_rowNum = 256;   // 8 tile rows
+
+    void SetUp() override
+    {
+        m_tiled.resize(m_pitch * m_rowNum);
+        for (auto &data : m_tiled)
+        {
+            data = (uint8_t)Random();
+        }
+        m_original = m_tiled;
+
+        // Rows not de-swizzled keep this value in the shadow
+        m_linear.assign(m_pitch * m_rowNum, 0xcd);
+
+        m_fullLinear.resize(m_pitch * m_rowNum);
+        MosUtilities::MosSwizzleData(m_tiled.data(), m_fullLinear.data(), MOS_TILE_Y, MOS_TILE_LINEAR,
+            m_rowNum, m_pitch, GetParam());
+
+        m_rows.Reset(m_tiled.data(), m_linear.data(), m_rowNum, m_pitch, GetParam());
+    }
+
+    uint32_t Random()
+    {
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed;
+    }
+
+    bool RowsMatch(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint32_t rowStart, uint32_t rowEnd)
+    {
+        return std::equal(a.begin() + rowStart * m_pitch, a.begin() + rowEnd * m_pitch, b.begin() + rowStart * m_pitch);
+    }
+
+    //!
+    //! \brief    Write back the whole shadow the way Unlock did before region locks
+    //!
+    std::vector<uint8_t> FullSwizzleBack(std::vector<uint8_t> &linear)
+    {
+        std::vector<uint8_t> tiled(m_pitch * m_rowNum);
+        MosUtilities::MosSwizzleData(linear.data(), tiled.data(), MOS_TILE_LINEAR, MOS_TILE_Y,
+            m_rowNum, m_pitch, GetParam());
+        return tiled;
+    }
+
+    uint32_t             m_seed = 0x4d4f53;
+    std::vector<uint8_t> m_tiled;
+    std::vector<uint8_t> m_original;
+    std::vector<uint8_t> m_linear;
+    std::vector<uint8_t> m_fullLinear;
+    MosShadowTileRows    m_rows;
+};
+
+TEST_P(MosShadowTileRowsTest, RegionReadMatchesFullDeswizzle)
+{
+    // Rows 70..109 are in tile rows 2 and 3
+    m_rows.Prepare(70, 40, false);
+
+    EXPECT_TRUE(RowsMatch(m_linear, m_fullLinear, 64, 128));
+    EXPECT_TRUE(std::all_of(m_linear.begin(), m_linear.begin() + 64 * m_pitch,
+        [](uint8_t data) { return data == 0xcd; }));
+    EXPECT_TRUE(std::all_of(m_linear.begin() + 128 * m_pitch, m_linear.end(),
+        [](uint8_t data) { return data == 0xcd; }));
+}
+
+TEST_P(MosShadowTileRowsTest, WholeSurfaceLockMatchesFullDeswizzle)
+{
+    m_rows.Prepare(0, 0, false);
+
+    EXPECT_EQ(m_fullLinear, m_linear);
+}
+
+TEST_P(MosShadowTileRowsTest, ReadOnlyRegionIsNotWrittenBack)
+{
+    m_rows.Prepare(32, 64, false);
+    std::fill(m_linear.begin() + 32 * m_pitch, m_linear.begin() + 96 * m_pitch, 0);
+    m_rows.Flush();
+
+    EXPECT_EQ(m_original, m_tiled);
+}
+
+TEST_P(MosShadowTileRowsTest, RandomRegionsRoundTripLikeFullSwizzle)
+{
+    // Expected result of the same writes done on a whole-surface shadow
+    std::vector<uint8_t> expectedLinear = m_fullLinear;
+
+    for (int i = 0; i < 16; i++)
+    {
+        uint32_t rowStart = Random() % m_rowNum;
+        uint32_t rowNum   = 1 + Random() % 48;
+        bool     write    = (Random() & 1) != 0;
+        uint32_t rowEnd   = MOS_MIN(rowStart + rowNum, m_rowNum);
+
+        m_rows.Prepare(rowStart, rowNum, write);
+        ASSERT_TRUE(RowsMatch(m_linear, expectedLinear, rowStart, rowEnd));
+
+        if (write)
+        {
+            for (uint32_t offset = rowStart * m_pitch; offset < rowEnd * m_pitch; offset++)
+            {
+                m_linear[offset] = expectedLinear[offset] = (uint8_t)Random();
+            }
+        }
+    }
+    m_rows.Flush();
+
+    EXPECT_EQ(FullSwizzleBack(expectedLinear), m_tiled);
+}
+
+INSTANTIATE_TEST_CASE_P(SwizzleFlags, MosShadowTileRowsTest, testing::Values(0, 1));
@@ -83,6 +83,23 @@ MOS_STATUS AvcDecodePktM12::Submit(
     return MOS_STATUS_SUCCESS;
 }
 
+bool AvcDecodePktM12::IsBatchable()
+{
+    if (m_avcBasicFeature == nullptr || m_avcBasicFeature->m_cencBuf != nullptr)
+    {
+        return false;
+    }
+
+#if MOS_EVENT_TRACE_DUMP_SUPPORTED
+    if (MOS_GetTraceEventKeyword() & EVENT_DECODE_REFYUV_KEYWORD)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 MOS_STATUS AvcDecodePktM12::PackPictureLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer)
 {
     DECODE_FUNC_CALL();
@@ -130,7 +147,11 @@ MOS_STATUS AvcDecodePktM12::PackSliceLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer)
             m_mmcState->UpdateUserFeatureKey(&(m_avcBasicFeature->m_destSurface));
         })
 
-    DECODE_CHK_STATUS(m_miInterface->AddMiBatchBufferEnd(&cmdBuffer, nullptr));
+    // Batch buffer end is added when the batched command buffer is submitted
+    if (!m_avcPipeline->IsBatchedSubmission())
+    {
+        DECODE_CHK_STATUS(m_miInterface->AddMiBatchBufferEnd(&cmdBuffer, nullptr));
+    }
 
     return MOS_STATUS_SUCCESS;
 }
@@ -58,6 +58,15 @@ public:
     //!
     virtual MOS_STATUS Submit(MOS_COMMAND_BUFFER* commandBuffer, uint8_t packetPhase = otherPacket) override;
 
+    //!
+    //! \brief  Indicates whether the packet can be recorded and submitted together with later frames
+    //! \details CENC decode checks status by CP during submit and reference trace dump locks
+    //!          references by CPU, both of them are not batchable
+    //! \return bool
+    //!         true if batchable, else false
+    //!
+    virtual bool IsBatchable() override;
+
 protected:
     MOS_STATUS PackPictureLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer);
     MOS_STATUS PackSliceLevelCmds(MOS_COMMAND_BUFFER &cmdBuffer);
@@ -136,3 +136,15 @@ MOS_GPU_CONTEXT DecodeAvcPipelineAdapterM12::GetDecodeContext()
     return m_decoder->GetDecodeContext();
 }
 
+MOS_STATUS DecodeAvcPipelineAdapterM12::FlushBatchedSubmission()
+{
+    DECODE_FUNC_CALL();
+    DECODE_CHK_NULL(m_decoder);
+
+    return m_decoder->FlushBatchedSubmission();
+}
+
+uint32_t DecodeAvcPipelineAdapterM12::GetBatchedFrameCount()
+{
+    return (m_decoder == nullptr) ? 0 : m_decoder->GetBatchedFrameCount();
+}
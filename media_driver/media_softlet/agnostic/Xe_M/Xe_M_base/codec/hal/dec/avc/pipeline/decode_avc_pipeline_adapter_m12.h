@@ -73,6 +73,10 @@ public:
 
     virtual MOS_GPU_CONTEXT GetDecodeContext() override;
 
+    virtual MOS_STATUS FlushBatchedSubmission() override;
+
+    virtual uint32_t GetBatchedFrameCount() override;
+
 protected:
     std::shared_ptr<decode::AvcPipelineM12> m_decoder;
 };
@@ -162,6 +162,20 @@ MOS_STATUS AvcPipelineM12::InitContext()
     }
 #endif
 
+    // Resetting OS states drops the resources registered by the batched frames, so keep them
+    // when switching back to the same context, otherwise submit them before the switch
+    if (GetBatchedFrameCount() > 0)
+    {
+        if (m_scalability != nullptr && m_scalability->IsScalabilityModeMatched(&scalPars))
+        {
+            scalPars.IsContextSwitchBack = true;
+        }
+        else
+        {
+            DECODE_CHK_STATUS(FlushBatchedSubmission());
+        }
+    }
+
     m_mediaContext->SwitchContext(VdboxDecodeFunc, &scalPars, &m_scalability);
     DECODE_CHK_NULL(m_scalability);
 
@@ -29,6 +29,7 @@
 #include "codechal_debug_config_manager.h"
 #include "codechal_encoder_base.h"
 #include <iomanip>
+#include <sstream>
 
 CodechalDebugInterface::CodechalDebugInterface()
 {
@@ -326,13 +327,8 @@ MOS_STATUS CodechalDebugInterface::DumpEncodeStatusReport(const EncodeStatusRepo
         return MOS_STATUS_SUCCESS;
     }
 
-    const char *  filePath = CreateFileName(bufferName, attrName, MediaDbgExtType::txt);
-    std::ofstream ofs(filePath);
-
-    if (ofs.fail())
-    {
-        return MOS_STATUS_UNKNOWN;
-    }
+    const char *       filePath = CreateFileName(bufferName, attrName, MediaDbgExtType::txt);
+    std::ostringstream ofs;
     std::string print_shift = "";
     sizeof(report->CodecStatus);
     FIELD_TO_OFS(CodecStatus);
@@ -387,9 +383,9 @@ MOS_STATUS CodechalDebugInterface::DumpEncodeStatusReport(const EncodeStatusRepo
 
     FIELD_TO_OFS(StreamId);
     PTR_TO_OFS(  pLookaheadStatus);
-    ofs.close();
 
-    return MOS_STATUS_SUCCESS;
+    std::string text = ofs.str();
+    return WriteBufferToFile(filePath, (const uint8_t *)text.data(), (uint32_t)text.size());
 }
 
 CodechalDebugInterfaceG12::CodechalDebugInterfaceG12()
@@ -520,20 +516,11 @@ MOS_STATUS CodechalDebugInterfaceG12::DumpYUVSurface(
     const char *funcName = (m_codecFunction == CODECHAL_FUNCTION_DECODE) ? "_DEC" :(m_codecFunction == CODECHAL_FUNCTION_CENC_DECODE ? "_DEC" : "_ENC");
     std::string bufName  = std::string(surfName) + "_w[" + std::to_string(surface->dwWidth) + "]_h[" + std::to_string(surface->dwHeight) + "]_p[" + std::to_string(pitch) + "]";
 
-    const char *filePath = CreateFileName(funcName, bufName.c_str(), hasAuxSurf ? ".Y" : ".yuv");
-
-    std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
-    if (ofs.fail())
-    {
-        return MOS_STATUS_UNKNOWN;
-    }
+    // CreateFileName reuses one buffer, keep the path for the chroma planes
+    std::string filePath = CreateFileName(funcName, bufName.c_str(), hasAuxSurf ? ".Y" : ".yuv");
 
     // write luma data to file
-    for (uint32_t h = 0; h < lumaheight; h++)
-    {
-        ofs.write((char*)data, hasAuxSurf ? pitch : width);
-        data += pitch;
-    }
+    CODECHAL_DEBUG_CHK_STATUS(Write2DBufferToFile(filePath, data, hasAuxSurf ? pitch : width, lumaheight, pitch, false));
 
     switch (surface->Format)
     {
@@ -589,41 +576,21 @@ MOS_STATUS CodechalDebugInterfaceG12::DumpYUVSurface(
         if (hasAuxSurf)
         {
             const char *uvfilePath = CreateFileName(funcName, bufName.c_str(), ".UV");
-            std::ofstream ofs1(uvfilePath, std::ios_base::out | std::ios_base::binary);
-            if (ofs1.fail())
-            {
-                return MOS_STATUS_UNKNOWN;
-            }
             // write chroma data to file
-            for (uint32_t h = 0; h < GFX_ALIGN(height, 32); h++)
-            {
-                ofs1.write((char*)data, pitch);
-                data += pitch;
-            }
-            ofs1.close();
+            CODECHAL_DEBUG_CHK_STATUS(Write2DBufferToFile(uvfilePath, data, pitch, GFX_ALIGN(height, 32), pitch, false));
         }
         else
         {
             // write chroma data to file
-            for (uint32_t h = 0; h < height; h++)
-            {
-                ofs.write((char *)data, hasAuxSurf ? pitch : width);
-                data += pitch;
-            }
+            CODECHAL_DEBUG_CHK_STATUS(Write2DBufferToFile(filePath, data, width, height, pitch, true));
 
             // write v planar data to file
             if (surface->Format == Format_422V
                 || surface->Format == Format_IMC3)
             {
-                for (uint32_t h = 0; h < height; h++)
-                {
-                    ofs.write((char *)vPlaneData, hasAuxSurf ? pitch : width);
-                    vPlaneData += pitch;
-                }
+                CODECHAL_DEBUG_CHK_STATUS(Write2DBufferToFile(filePath, vPlaneData, width, height, pitch, true));
             }
-
         }
-        ofs.close();
     }
 
     if (hasAuxSurf)
@@ -636,13 +603,7 @@ MOS_STATUS CodechalDebugInterfaceG12::DumpYUVSurface(
 
         // Y Aux data
         const char *yAuxfilePath = CreateFileName(funcName, bufName.c_str(), ".Yaux");
-        std::ofstream ofs2(yAuxfilePath, std::ios_base::out | std::ios_base::binary);
-        if (ofs2.fail())
-        {
-            return MOS_STATUS_UNKNOWN;
-        }
-        ofs2.write((char*)yAuxData, yAuxSize);
-        ofs2.close();
+        CODECHAL_DEBUG_CHK_STATUS(WriteBufferToFile(yAuxfilePath, yAuxData, yAuxSize));
 
         if (isPlanar)
         {
@@ -651,14 +612,7 @@ MOS_STATUS CodechalDebugInterfaceG12::DumpYUVSurface(
 
             // UV Aux data
             const char *uvAuxfilePath = CreateFileName(funcName, bufName.c_str(), ".UVaux");
-            std::ofstream ofs3(uvAuxfilePath, std::ios_base::out | std::ios_base::binary);
-            if (ofs3.fail())
-            {
-                return MOS_STATUS_UNKNOWN;
-            }
-            ofs3.write((char*)uvAuxData, uvAuxSize);
-
-            ofs3.close();
+            CODECHAL_DEBUG_CHK_STATUS(WriteBufferToFile(uvAuxfilePath, uvAuxData, uvAuxSize));
         }
     }
 
@@ -119,6 +119,9 @@ namespace decode
             uint32_t uvrowSize = pitch * uvblockHeight * 2;
             uint32_t dstOffset = 0, x = 0, uvsize = 0;
 
+            // Chroma of mono picture is copied by another workload, which must not run ahead of batched frames
+            DECODE_CHK_STATUS(FlushBatchedSubmission());
+
             //update decode output surface's cpTag before decode submitbuffer, pfnMediaCopyResource2D can decide clear/secure workload by output surface's cptag.
             if (m_osInterface->osCpInterface && m_osInterface->osCpInterface->IsHMEnabled())
             {
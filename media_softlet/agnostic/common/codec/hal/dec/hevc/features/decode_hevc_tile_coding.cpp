@@ -277,34 +277,121 @@ MOS_STATUS HevcTileCoding::GetAllTileInfo(const CODEC_HEVC_PIC_PARAMS & picParam
                     (picParams.num_tile_rows_minus1 >= HEVC_NUM_MAX_TILE_ROW),
                     "num_tile_columns_minus1 or num_tile_rows_minus1 is out of range!");
 
-    if (picParams.uniform_spacing_flag == 1)
+    TileLayoutKey key;
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.widthInCtb           = widthInCtb;
+    key.heightInCtb          = heightInCtb;
+    key.numTileColumnsMinus1 = picParams.num_tile_columns_minus1;
+    key.numTileRowsMinus1    = picParams.num_tile_rows_minus1;
+    key.uniformSpacingFlag   = picParams.uniform_spacing_flag;
+    if (picParams.uniform_spacing_flag != 1)
     {
-        for (auto i = 0; i <= picParams.num_tile_columns_minus1; i++)
+        for (auto i = 0; i < picParams.num_tile_columns_minus1; i++)
+        {
+            key.columnWidthMinus1[i] = picParams.column_width_minus1[i];
+        }
+        for (auto i = 0; i < picParams.num_tile_rows_minus1; i++)
         {
-            m_tileColWidth[i] = ((i + 1) * widthInCtb) / (picParams.num_tile_columns_minus1 + 1) -
-                                (i * widthInCtb) / (picParams.num_tile_columns_minus1 + 1);
+            key.rowHeightMinus1[i] = picParams.row_height_minus1[i];
         }
+    }
 
-        for (auto i = 0; i <= picParams.num_tile_rows_minus1; i++)
+    if (m_curTileLayout->valid && memcmp(&m_curTileLayout->key, &key, sizeof(key)) == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    for (auto &layout : m_tileLayouts)
+    {
+        if (layout.valid && memcmp(&layout.key, &key, sizeof(key)) == 0)
         {
-            m_tileRowHeight[i] = ((i + 1) * heightInCtb) / (picParams.num_tile_rows_minus1 + 1) -
-                                 (i * heightInCtb) / (picParams.num_tile_rows_minus1 + 1);
+            m_curTileLayout = &layout;
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    TileLayout &layout = m_tileLayouts[m_nextTileLayout];
+    m_nextTileLayout   = (m_nextTileLayout + 1) % m_maxTileLayoutNum;
+    layout.valid       = false;
+    layout.key         = key;
+    DECODE_CHK_STATUS(ComputeTileLayout(layout));
+    layout.valid       = true;
+    m_curTileLayout    = &layout;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcTileCoding::ComputeTileLayout(TileLayout &layout)
+{
+    DECODE_FUNC_CALL();
+
+    const TileLayoutKey &key         = layout.key;
+    uint16_t            *colWidth    = layout.colWidth;
+    uint16_t            *rowHeight   = layout.rowHeight;
+    uint32_t             widthInCtb  = key.widthInCtb;
+    uint32_t             heightInCtb = key.heightInCtb;
+
+    MOS_ZeroMemory(layout.colWidth, sizeof(layout.colWidth));
+    MOS_ZeroMemory(layout.rowHeight, sizeof(layout.rowHeight));
+
+    if (key.uniformSpacingFlag == 1)
+    {
+        for (auto i = 0; i <= key.numTileColumnsMinus1; i++)
+        {
+            colWidth[i] = ((i + 1) * widthInCtb) / (key.numTileColumnsMinus1 + 1) -
+                          (i * widthInCtb) / (key.numTileColumnsMinus1 + 1);
+        }
+
+        for (auto i = 0; i <= key.numTileRowsMinus1; i++)
+        {
+            rowHeight[i] = ((i + 1) * heightInCtb) / (key.numTileRowsMinus1 + 1) -
+                           (i * heightInCtb) / (key.numTileRowsMinus1 + 1);
         }
     }
     else
     {
-        m_tileColWidth[picParams.num_tile_columns_minus1] = widthInCtb & 0xffff;
-        for (auto i = 0; i < picParams.num_tile_columns_minus1; i++)
+        colWidth[key.numTileColumnsMinus1] = widthInCtb & 0xffff;
+        for (auto i = 0; i < key.numTileColumnsMinus1; i++)
         {
-            m_tileColWidth[i] = picParams.column_width_minus1[i] + 1;
-            m_tileColWidth[picParams.num_tile_columns_minus1] -= m_tileColWidth[i];
+            colWidth[i] = key.columnWidthMinus1[i] + 1;
+            colWidth[key.numTileColumnsMinus1] -= colWidth[i];
         }
 
-        m_tileRowHeight[picParams.num_tile_rows_minus1] = heightInCtb & 0xffff;
-        for (auto i = 0; i < picParams.num_tile_rows_minus1; i++)
+        rowHeight[key.numTileRowsMinus1] = heightInCtb & 0xffff;
+        for (auto i = 0; i < key.numTileRowsMinus1; i++)
         {
-            m_tileRowHeight[i] = picParams.row_height_minus1[i] + 1;
-            m_tileRowHeight[picParams.num_tile_rows_minus1] -= m_tileRowHeight[i];
+            rowHeight[i] = key.rowHeightMinus1[i] + 1;
+            rowHeight[key.numTileRowsMinus1] -= rowHeight[i];
+        }
+    }
+
+    // Ctb offset of each tile and tile index of each ctb, so that no tile
+    // table needs to be walked per slice and per tile
+    layout.colCtbStart[0] = 0;
+    for (auto i = 0; i < HEVC_NUM_MAX_TILE_COLUMN; i++)
+    {
+        layout.colCtbStart[i + 1] = layout.colCtbStart[i] + colWidth[i];
+    }
+    layout.rowCtbStart[0] = 0;
+    for (auto i = 0; i < HEVC_NUM_MAX_TILE_ROW; i++)
+    {
+        layout.rowCtbStart[i + 1] = layout.rowCtbStart[i] + rowHeight[i];
+    }
+
+    layout.ctbXToTileX.assign(widthInCtb, 0);
+    for (uint16_t i = 0; i <= key.numTileColumnsMinus1; i++)
+    {
+        for (uint32_t ctbX = layout.colCtbStart[i]; ctbX < layout.colCtbStart[i + 1] && ctbX < widthInCtb; ctbX++)
+        {
+            layout.ctbXToTileX[ctbX] = i;
+        }
+    }
+    layout.ctbYToTileY.assign(heightInCtb, 0);
+    for (uint16_t i = 0; i <= key.numTileRowsMinus1; i++)
+    {
+        for (uint32_t ctbY = layout.rowCtbStart[i]; ctbY < layout.rowCtbStart[i + 1] && ctbY < heightInCtb; ctbY++)
+        {
+            layout.ctbYToTileY[ctbY] = i;
         }
     }
 
@@ -313,12 +400,12 @@ MOS_STATUS HevcTileCoding::GetAllTileInfo(const CODEC_HEVC_PIC_PARAMS & picParam
 
 const uint16_t *HevcTileCoding::GetTileColWidth()
 {
-    return m_tileColWidth;
+    return m_curTileLayout->colWidth;
 }
 
 const uint16_t *HevcTileCoding::GetTileRowHeight()
 {
-    return m_tileRowHeight;
+    return m_curTileLayout->rowHeight;
 }
 
 const HevcTileCoding::SliceTileInfo *HevcTileCoding::GetSliceTileInfo(uint32_t sliceIndex)
@@ -335,18 +422,12 @@ uint16_t HevcTileCoding::ComputeSliceTileX(const CODEC_HEVC_PIC_PARAMS & picPara
 {
     DECODE_FUNC_CALL();
 
-    uint16_t ctbX, ctbStart = 0;
-
-    ctbX = slc.slice_segment_address % m_basicFeature->m_widthInCtb;
-    for (uint16_t i = 0; i <= picParams.num_tile_columns_minus1; i++)
+    uint32_t ctbX = slc.slice_segment_address % m_basicFeature->m_widthInCtb;
+    if (ctbX >= m_curTileLayout->ctbXToTileX.size())
     {
-        if (ctbX >= ctbStart && ctbX < ctbStart + m_tileColWidth[i])
-        {
-            return i;
-        }
-        ctbStart += m_tileColWidth[i];
+        return 0;
     }
-    return 0;
+    return m_curTileLayout->ctbXToTileX[ctbX];
 }
 
 uint16_t HevcTileCoding::ComputeSliceTileY(const CODEC_HEVC_PIC_PARAMS & picParams,
@@ -354,18 +435,12 @@ uint16_t HevcTileCoding::ComputeSliceTileY(const CODEC_HEVC_PIC_PARAMS & picPara
 {
     DECODE_FUNC_CALL();
 
-    uint32_t ctbY, ctbStart = 0;
-
-    ctbY = slc.slice_segment_address / m_basicFeature->m_widthInCtb;
-    for (uint16_t i = 0; i <= picParams.num_tile_rows_minus1; i++)
+    uint32_t ctbY = slc.slice_segment_address / m_basicFeature->m_widthInCtb;
+    if (ctbY >= m_curTileLayout->ctbYToTileY.size())
     {
-        if (ctbY >= ctbStart && ctbY < ctbStart + m_tileRowHeight[i])
-        {
-            return i;
-        }
-        ctbStart += m_tileRowHeight[i];
+        return 0;
     }
-    return 0;
+    return m_curTileLayout->ctbYToTileY[ctbY];
 }
 
 uint16_t HevcTileCoding::ComputeTileNumForSlice(const CODEC_HEVC_PIC_PARAMS & picParams,
@@ -394,24 +469,22 @@ uint16_t HevcTileCoding::GetTileCtbX(uint16_t col)
 {
     DECODE_FUNC_CALL();
 
-    uint16_t ctbX = 0;
-    for (uint16_t i = 0; i < col; i++)
+    if (col > HEVC_NUM_MAX_TILE_COLUMN)
     {
-        ctbX += m_tileColWidth[i];
+        col = HEVC_NUM_MAX_TILE_COLUMN;
     }
-    return ctbX;
+    return m_curTileLayout->colCtbStart[col];
 }
 
 uint16_t HevcTileCoding::GetTileCtbY(uint16_t row)
 {
     DECODE_FUNC_CALL();
 
-    uint16_t ctbY = 0;
-    for (uint16_t i = 0; i < row; i++)
+    if (row > HEVC_NUM_MAX_TILE_ROW)
     {
-        ctbY += m_tileRowHeight[i];
+        row = HEVC_NUM_MAX_TILE_ROW;
     }
-    return ctbY;
+    return m_curTileLayout->rowCtbStart[row];
 }
 
 }
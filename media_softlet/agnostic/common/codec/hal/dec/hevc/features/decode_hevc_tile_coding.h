@@ -29,6 +29,7 @@
 #include "codec_def_decode_hevc.h"
 #include "mhw_vdbox.h"
 #include "codechal_setting.h"
+#include <vector>
 
 namespace decode
 {
@@ -240,9 +241,54 @@ protected:
                                  const CODEC_HEVC_SLICE_PARAMS & sliceParams,
                                  SliceTileInfo &sliceTileInfo);
 
+    //!
+    //! \struct TileLayoutKey
+    //! \brief  Picture parameters which decide the tile layout
+    //!
+    struct TileLayoutKey
+    {
+        uint32_t widthInCtb;
+        uint32_t heightInCtb;
+        uint8_t  numTileColumnsMinus1;
+        uint8_t  numTileRowsMinus1;
+        uint8_t  uniformSpacingFlag;
+        uint16_t columnWidthMinus1[HEVC_NUM_MAX_TILE_COLUMN - 1];  //!< Zero if uniform spacing
+        uint16_t rowHeightMinus1[HEVC_NUM_MAX_TILE_ROW - 1];       //!< Zero if uniform spacing
+    };
+
+    //!
+    //! \struct TileLayout
+    //! \brief  Tile geometry derived from TileLayoutKey
+    //!
+    struct TileLayout
+    {
+        bool                  valid = false;
+        TileLayoutKey         key   = {};
+        uint16_t              colWidth[HEVC_NUM_MAX_TILE_COLUMN]        = {};  //!< Table of tile column width
+        uint16_t              rowHeight[HEVC_NUM_MAX_TILE_ROW]          = {};  //!< Table of tile row height
+        uint16_t              colCtbStart[HEVC_NUM_MAX_TILE_COLUMN + 1] = {};  //!< First ctb column of tile column
+        uint16_t              rowCtbStart[HEVC_NUM_MAX_TILE_ROW + 1]    = {};  //!< First ctb row of tile row
+        std::vector<uint16_t> ctbXToTileX;                                     //!< Tile column of ctb column
+        std::vector<uint16_t> ctbYToTileY;                                     //!< Tile row of ctb row
+    };
+
+    //!
+    //! \brief    Compute tile geometry for a layout
+    //! \param  [in, out] layout
+    //!         Tile layout with key set
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ComputeTileLayout(TileLayout &layout);
+
     HevcBasicFeature *  m_basicFeature = nullptr;                   //!<  HEVC paramter
-    uint16_t            m_tileColWidth[HEVC_NUM_MAX_TILE_COLUMN];   //!< Table of tile column width
-    uint16_t            m_tileRowHeight[HEVC_NUM_MAX_TILE_ROW];     //!< Table of tile row height
+
+    // PPS tile layout rarely changes within a stream, so the geometry of the
+    // last few layouts is kept and only computed again for a new layout.
+    static const uint32_t m_maxTileLayoutNum = 4;
+    TileLayout            m_tileLayouts[m_maxTileLayoutNum];
+    uint32_t              m_nextTileLayout = 0;                     //!< Next layout to replace
+    TileLayout           *m_curTileLayout  = &m_tileLayouts[0];     //!< Layout of current picture
 
     bool                m_shortFormatInUse = false;                 //!< Indicate if short format
 
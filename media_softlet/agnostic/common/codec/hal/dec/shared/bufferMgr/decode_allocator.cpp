@@ -29,6 +29,7 @@
 #include "decode_allocator.h"
 #include "decode_utils.h"
 #include "decode_resource_array.h"
+#include "media_task.h"
 
 namespace decode {
 
@@ -52,7 +53,7 @@ MOS_BUFFER* DecodeAllocator::AllocateBuffer(
     ResourceUsage resUsageType, ResourceAccessReq accessReq,
     bool initOnAllocate, uint8_t initValue, bool bPersistent)
 {
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     MOS_ALLOC_GFXRES_PARAMS allocParams;
@@ -198,7 +199,7 @@ SurfaceArray * DecodeAllocator::AllocateSurfaceArray(
     const uint32_t numberOfSurface, MOS_FORMAT format, bool isCompressed,
     ResourceUsage resUsageType, ResourceAccessReq accessReq)
 {
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     SurfaceArray * surfaceArray = MOS_New(SurfaceArray, this);
@@ -254,7 +255,7 @@ BatchBufferArray * DecodeAllocator::AllocateBatchBufferArray(
     const uint32_t numberOfBatchBuffer, bool secondLevel,
     ResourceAccessReq accessReq)
 {
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     BatchBufferArray * batchBufferArray = MOS_New(BatchBufferArray, this);
@@ -279,7 +280,7 @@ BatchBufferArray * DecodeAllocator::AllocateBatchBufferArray(
 
 void* DecodeAllocator::Lock(MOS_RESOURCE* resource, MOS_LOCK_PARAMS* lockFlag)
 {
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     return m_allocator->Lock(resource, lockFlag);
@@ -291,7 +292,7 @@ void* DecodeAllocator::LockResourceForWrite(MOS_RESOURCE* resource)
     MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
     lockFlags.WriteOnly = 1;
 
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     return m_allocator->Lock(resource, &lockFlags);
@@ -304,7 +305,7 @@ void* DecodeAllocator::LockResourceWithNoOverwrite(MOS_RESOURCE* resource)
     lockFlags.WriteOnly   = 1;
     lockFlags.NoOverWrite = 1;
 
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     return m_allocator->Lock(resource, &lockFlags);
@@ -316,7 +317,7 @@ void* DecodeAllocator::LockResourceForRead(MOS_RESOURCE* resource)
     MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
     lockFlags.ReadOnly = 1;
 
-    if (!m_allocator)
+    if (!m_allocator || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     return m_allocator->Lock(resource, &lockFlags);
@@ -328,7 +329,7 @@ void* DecodeAllocator::LockResourceForRead(MOS_BUFFER* buffer)
     MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
     lockFlags.ReadOnly = 1;
 
-    if (m_allocator == nullptr || buffer == nullptr)
+    if (m_allocator == nullptr || buffer == nullptr || SubmitPendingTask() != MOS_STATUS_SUCCESS)
         return nullptr;
 
     return m_allocator->Lock(&buffer->OsResource, &lockFlags);
@@ -337,6 +338,7 @@ void* DecodeAllocator::LockResourceForRead(MOS_BUFFER* buffer)
 MOS_STATUS DecodeAllocator::Lock(PMHW_BATCH_BUFFER batchBuffer)
 {
     DECODE_CHK_NULL(batchBuffer);
+    DECODE_CHK_STATUS(SubmitPendingTask());
     return Mhw_LockBb(m_osInterface, batchBuffer);
 }
 
@@ -368,6 +370,7 @@ MOS_STATUS DecodeAllocator::Resize(MOS_BUFFER* &buffer, const uint32_t sizeNew,
     {
         if (clearData)
         {
+            DECODE_CHK_STATUS(SubmitPendingTask());
             if(m_allocator->OsFillResource(&buffer->OsResource, buffer->size, 0) != MOS_STATUS_SUCCESS)
             {
                 DECODE_ASSERTMESSAGE("Failed to clear buffer data");
@@ -448,6 +451,7 @@ MOS_STATUS DecodeAllocator::Destroy(MOS_BUFFER* & buffer)
         return MOS_STATUS_SUCCESS;
     }
 
+    DECODE_CHK_STATUS(SubmitPendingTask());
     DECODE_CHK_STATUS(m_allocator->DestroyBuffer(buffer));
     buffer = nullptr;
     return MOS_STATUS_SUCCESS;
@@ -461,6 +465,8 @@ MOS_STATUS DecodeAllocator::Destroy(MOS_SURFACE* & surface)
         return MOS_STATUS_SUCCESS;
     }
 
+    DECODE_CHK_STATUS(SubmitPendingTask());
+
     //if free the compressed surface, need set the sync dealloc flag as 1 for sync dealloc for aux table update
     MOS_GFXRES_FREE_FLAGS resFreeFlags = {0};
     resFreeFlags.SynchronousDestroy = m_allocator->isSyncFreeNeededForMMCSurface(surface) ? 1 : 0;
@@ -474,6 +480,7 @@ MOS_STATUS DecodeAllocator::Destroy(MOS_SURFACE* & surface)
 MOS_STATUS DecodeAllocator::Destroy(MOS_SURFACE& surface)
 {
     DECODE_CHK_NULL(m_allocator);
+    DECODE_CHK_STATUS(SubmitPendingTask());
 
     MOS_SURFACE* dup = MOS_New(MOS_SURFACE);
     DECODE_CHK_NULL(dup);
@@ -522,6 +529,7 @@ MOS_STATUS DecodeAllocator::Destroy(PMHW_BATCH_BUFFER &batchBuffer)
         return MOS_STATUS_SUCCESS;
     }
 
+    DECODE_CHK_STATUS(SubmitPendingTask());
     DECODE_CHK_STATUS(Mhw_FreeBb(m_osInterface, batchBuffer, nullptr));
     MOS_Delete(batchBuffer);
     batchBuffer = nullptr;
@@ -544,6 +552,7 @@ MOS_STATUS DecodeAllocator::Destroy(BatchBufferArray* & batchBufferArray)
 MOS_STATUS DecodeAllocator::DestroyAllResources()
 {
     DECODE_CHK_NULL(m_allocator);
+    DECODE_CHK_STATUS(SubmitPendingTask());
 
     return m_allocator->DestroyAllResources();
 }
@@ -661,6 +670,18 @@ ResourceUsage DecodeAllocator::ConvertGmmResourceUsage(const GMM_RESOURCE_USAGE_
     return resUsageType;
 }
 
+MOS_STATUS DecodeAllocator::SubmitPendingTask()
+{
+    // Resources referenced by a recorded but unsubmitted command buffer must not be
+    // touched by CPU or released before the command buffer reaches the GPU.
+    if (m_pendingTask == nullptr || m_pendingTask->GetPendingCount() == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    return m_pendingTask->SubmitPending();
+}
+
 void DecodeAllocator::SetAccessRequirement(
     ResourceAccessReq accessReq, MOS_ALLOC_GFXRES_PARAMS &allocParams)
 {
@@ -32,6 +32,8 @@
 #include "media_allocator.h"
 #include "mhw_utilities.h"
 
+class MediaTask;
+
 namespace decode {
 
 template <class T>
@@ -527,7 +529,24 @@ public:
     //!
     ResourceUsage ConvertGmmResourceUsage(const GMM_RESOURCE_USAGE_TYPE gmmResUsage);
 
+    //!
+    //! \brief    Set the task which may hold command buffers recorded but not submitted
+    //! \details  Pending command buffers of this task are submitted before any resource
+    //!           is locked by CPU, resized or destroyed through this allocator
+    //! \param    MediaTask task
+    //!           [in] Pointer to media task, nullptr to clear
+    //! \return   void
+    //!
+    void SetPendingTask(MediaTask *task) { m_pendingTask = task; }
+
 protected:
+    //!
+    //! \brief    Submit pending command buffers of the task set by SetPendingTask
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SubmitPendingTask();
+
     //!
     //! \brief    Apply resource access requirement to allocate parameters
     //! \details  Apply resource access requirement to allocate parameters
@@ -542,6 +561,7 @@ protected:
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
     Allocator *m_allocator = nullptr;
     bool m_limitedLMemBar = false; //!< Indicate if running with limited LMem bar config
+    MediaTask *m_pendingTask = nullptr; //!< Task whose pending command buffers may reference resources
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     bool m_forceLockable = false;
@@ -78,11 +78,14 @@ public:
     {
         DECODE_FUNC_CALL();
 
-        for (auto& buf : m_activeBuffers)
+        for (uint32_t frameIdx = 0; frameIdx < m_maxFrameIdxNum; frameIdx++)
         {
-            m_bufferOp.Destroy(buf.second);
+            if (IsActive(frameIdx))
+            {
+                m_bufferOp.Destroy(m_activeBuffers[frameIdx]);
+                SetActive(frameIdx, nullptr);
+            }
         }
-        m_activeBuffers.clear();
 
         for (auto& buf : m_availableBuffers)
         {
@@ -112,7 +115,12 @@ public:
         DECODE_CHK_STATUS(m_bufferOp.Init(hwInterface, allocator, basicFeature));
 
         DECODE_ASSERT(m_availableBuffers.empty());
-        DECODE_ASSERT(m_activeBuffers.empty());
+        DECODE_ASSERT(GetActiveNum() == 0);
+
+        // Every buffer is either active or available, reserve once so that
+        // moving buffers between the two never allocates
+        uint32_t minCapacity = m_minAvailableCapacity;
+        m_availableBuffers.reserve(MOS_MAX(initialAllocNum, minCapacity));
 
         for (uint32_t i = 0; i < initialAllocNum; i++)
         {
@@ -187,14 +195,13 @@ public:
     {
         DECODE_FUNC_CALL();
 
-        auto iter = m_activeBuffers.find(frameIndex);
-        if (iter != m_activeBuffers.end())
+        if (!IsActive(frameIndex))
         {
-            DECODE_ASSERT(iter->second != nullptr);
-            return iter->second;
+            return nullptr;
         }
 
-        return nullptr;
+        DECODE_ASSERT(m_activeBuffers[frameIndex] != nullptr);
+        return m_activeBuffers[frameIndex];
     }
 
     //!
@@ -241,13 +248,13 @@ protected:
 
         m_currentBuffer = nullptr;
 
-        for (auto iter = m_activeBuffers.begin(); iter != m_activeBuffers.end(); iter++)
+        DECODE_CHK_COND(curFrameIdx >= m_maxFrameIdxNum,
+            "Frame index %d of reference associated buffer is out of range", curFrameIdx);
+
+        if (IsActive(curFrameIdx))
         {
-            if (curFrameIdx == iter->first)
-            {
-                m_currentBuffer = iter->second;
-                return MOS_STATUS_SUCCESS;
-            }
+            m_currentBuffer = m_activeBuffers[curFrameIdx];
+            return MOS_STATUS_SUCCESS;
         }
 
         // The function UpdateRefList always attach the retired buffers to end of
@@ -270,10 +277,7 @@ protected:
         }
         m_bufferOp.Resize(m_currentBuffer);
 
-        auto ret = m_activeBuffers.insert(std::make_pair(curFrameIdx, m_currentBuffer));
-        DECODE_CHK_COND(ret.second == false,
-            "Failed to acitve reference associated buffer with index %d, maybe it is already existed",
-            ret.first->first);
+        SetActive(curFrameIdx, m_currentBuffer);
 
         return MOS_STATUS_SUCCESS;
     }
@@ -293,27 +297,42 @@ protected:
     {
         DECODE_FUNC_CALL();
 
-        auto iter = m_activeBuffers.begin();
-        while (iter != m_activeBuffers.end())
+        // Membership of reference list as bitmask, current frame is never a reference
+        uint64_t refMask[m_maskWordNum] = {};
+        for (auto frameIdx : refFrameList)
         {
-            if (iter->first == fixedFrameIdx)
+            if (frameIdx < m_maxFrameIdxNum)
             {
-                ++iter;
-                continue;
+                refMask[frameIdx / 64] |= 1ULL << (frameIdx % 64);
             }
+        }
+        if (curFrameIdx < m_maxFrameIdxNum)
+        {
+            refMask[curFrameIdx / 64] &= ~(1ULL << (curFrameIdx % 64));
+        }
+        if (fixedFrameIdx < m_maxFrameIdxNum)
+        {
+            refMask[fixedFrameIdx / 64] |= 1ULL << (fixedFrameIdx % 64);
+        }
 
-            if (!IsReference(iter->first, curFrameIdx, refFrameList))
+        // Retire in frame index order to keep the order of available buffers
+        for (uint32_t word = 0; word < m_maskWordNum; word++)
+        {
+            uint64_t retired = m_activeMask[word] & ~refMask[word];
+            for (uint32_t bit = 0; retired != 0; bit++, retired >>= 1)
             {
-                auto buffer = iter->second;
-                iter = m_activeBuffers.erase(iter);
+                if ((retired & 1) == 0)
+                {
+                    continue;
+                }
+
+                uint32_t frameIdx = word * 64 + bit;
+                auto     buffer   = m_activeBuffers[frameIdx];
+                SetActive(frameIdx, nullptr);
 
                 m_availableBuffers.push_back(buffer);
                 DECODE_CHK_STATUS(m_bufferOp.Deactive(buffer));
             }
-            else
-            {
-                ++iter;
-            }
         }
 
         return MOS_STATUS_SUCCESS;
@@ -350,10 +369,53 @@ protected:
         return false;
     }
 
-    BufferOp                        m_bufferOp;                //!< Buffer operation
-    std::map<uint32_t, BufferType*> m_activeBuffers;           //!< Active buffers corresponding to current reference frame list
-    std::vector<BufferType*>        m_availableBuffers;        //!< Buffers in idle
-    BufferType*                     m_currentBuffer = nullptr; //!< Point to buffer of current picture
+    //!
+    //! \brief  Check if a frame index has an active buffer
+    //!
+    bool IsActive(uint32_t frameIdx) const
+    {
+        return frameIdx < m_maxFrameIdxNum &&
+               (m_activeMask[frameIdx / 64] & (1ULL << (frameIdx % 64))) != 0;
+    }
+
+    //!
+    //! \brief  Set active buffer of a frame index, nullptr to deactive
+    //!
+    void SetActive(uint32_t frameIdx, BufferType *buffer)
+    {
+        m_activeBuffers[frameIdx] = buffer;
+        if (buffer != nullptr)
+        {
+            m_activeMask[frameIdx / 64] |= 1ULL << (frameIdx % 64);
+        }
+        else
+        {
+            m_activeMask[frameIdx / 64] &= ~(1ULL << (frameIdx % 64));
+        }
+    }
+
+    //!
+    //! \brief  Get number of active buffers
+    //!
+    uint32_t GetActiveNum() const
+    {
+        uint32_t num = 0;
+        for (uint32_t frameIdx = 0; frameIdx < m_maxFrameIdxNum; frameIdx++)
+        {
+            num += IsActive(frameIdx) ? 1 : 0;
+        }
+        return num;
+    }
+
+    static constexpr uint32_t m_maxFrameIdxNum      = 256;                     //!< Frame indices are 8 bits
+    static constexpr uint32_t m_maskWordNum         = m_maxFrameIdxNum / 64;
+    static constexpr uint32_t m_minAvailableCapacity = 32;
+
+    BufferOp                 m_bufferOp;                                //!< Buffer operation
+    BufferType*              m_activeBuffers[m_maxFrameIdxNum] = {};    //!< Active buffers indexed by frame index of current reference frame list
+    uint64_t                 m_activeMask[m_maskWordNum]       = {};    //!< Frame indices which have active buffer
+    std::vector<BufferType*> m_availableBuffers;                        //!< Buffers in idle
+    BufferType*              m_currentBuffer = nullptr;                 //!< Point to buffer of current picture
 
 MEDIA_CLASS_DEFINE_END(RefrenceAssociatedBuffer)
 };
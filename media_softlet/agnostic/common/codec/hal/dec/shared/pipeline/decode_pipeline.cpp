@@ -39,6 +39,7 @@
 #include "decode_sfc_histogram_postsubpipeline.h"
 #include "decode_common_feature_defs.h"
 #include "decode_resource_auto_lock.h"
+#include "mos_cpu_profiler.h"
 
 namespace decode {
 
@@ -145,6 +146,7 @@ MOS_STATUS DecodePipeline::Initialize(void *settings)
 
     DECODE_CHK_NULL(settings);
 
+    DECODE_CHK_STATUS(InitUserSetting(m_userSettingPtr));
     DECODE_CHK_STATUS(MediaPipeline::InitPlatform());
     DECODE_CHK_STATUS(MediaPipeline::CreateMediaCopy());
 
@@ -165,6 +167,20 @@ MOS_STATUS DecodePipeline::Initialize(void *settings)
     bool limitedLMemBar = MEDIA_IS_SKU(m_skuTable, FtrLimitedLMemBar) ? true : false;
     m_allocator = MOS_New(DecodeAllocator, m_osInterface, limitedLMemBar);
     DECODE_CHK_NULL(m_allocator);
+    m_allocator->SetPendingTask(m_task);
+
+    MediaUserSetting::Value outValue;
+    ReadUserSetting(
+        m_userSettingPtr,
+        outValue,
+        "Decode Batched Submission Frames",
+        MediaUserSetting::Group::Sequence);
+    int32_t batchedFrames = outValue.Get<int32_t>();
+    m_batchedFramesMax    = (batchedFrames <= 0) ? 0 : (uint32_t)batchedFrames;
+    if (m_batchedFramesMax > m_maxBatchedFrames)
+    {
+        m_batchedFramesMax = m_maxBatchedFrames;
+    }
 
     DECODE_CHK_STATUS(CreateStatusReport());
 
@@ -186,6 +202,11 @@ MOS_STATUS DecodePipeline::Uninitialize()
 {
     DECODE_FUNC_CALL();
 
+    if (FlushBatchedSubmission() != MOS_STATUS_SUCCESS)
+    {
+        DECODE_ASSERTMESSAGE("Failed to submit batched frames!");
+    }
+
     Delete_DecodeCpInterface(m_decodecp);
     m_decodecp = nullptr;
 
@@ -243,6 +264,7 @@ uint8_t DecodePipeline::GetSystemVdboxNumber()
 MOS_STATUS DecodePipeline::Prepare(void *params)
 {
     DECODE_FUNC_CALL();
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_PIPELINE_PREPARE);
 
     DECODE_CHK_NULL(params);
     DecodePipelineParams *pipelineParams = (DecodePipelineParams *)params;
@@ -269,11 +291,18 @@ MOS_STATUS DecodePipeline::Prepare(void *params)
 MOS_STATUS DecodePipeline::ExecuteActivePackets()
 {
     DECODE_FUNC_CALL();
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_PIPELINE_EXECUTE);
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_START, nullptr, 0, nullptr, 0);
 
     // Last element in m_activePacketList must be immediately submitted
     m_activePacketList.back().immediateSubmit = true;
 
+    m_batchedSubmission = IsActivePacketsBatchable();
+    if (!m_batchedSubmission)
+    {
+        DECODE_CHK_STATUS(FlushBatchedSubmission());
+    }
+
     for (PacketProperty prop : m_activePacketList)
     {
         prop.stateProperty.singleTaskPhaseSupported = m_singleTaskPhaseSupported;
@@ -284,15 +313,63 @@ MOS_STATUS DecodePipeline::ExecuteActivePackets()
         DECODE_CHK_STATUS(task->AddPacket(&prop));
         if (prop.immediateSubmit)
         {
-            DECODE_CHK_STATUS(task->Submit(true, m_scalability, m_debugInterface));
+            DECODE_CHK_STATUS(task->Submit(!m_batchedSubmission, m_scalability, m_debugInterface));
         }
     }
 
+    if (m_batchedSubmission && GetBatchedFrameCount() >= m_batchedFramesMax)
+    {
+        DECODE_CHK_STATUS(FlushBatchedSubmission());
+    }
+
     m_activePacketList.clear();
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return MOS_STATUS_SUCCESS;
 }
 
+bool DecodePipeline::IsActivePacketsBatchable()
+{
+    if (m_batchedFramesMax <= 1 || m_scalability == nullptr || m_scalability->GetPipeNumber() > 1)
+    {
+        return false;
+    }
+
+    // KMD frame tracking updates the tag at the end of command buffer, it can not tell frames apart
+    if (m_osInterface->bEnableKmdMediaFrameTracking)
+    {
+        return false;
+    }
+
+    if (m_osInterface->osCpInterface != nullptr && m_osInterface->osCpInterface->IsHMEnabled())
+    {
+        return false;
+    }
+
+    for (PacketProperty &prop : m_activePacketList)
+    {
+        if (prop.packet == nullptr || prop.packet->GetActiveTask() != m_task || !prop.packet->IsBatchable())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MOS_STATUS DecodePipeline::FlushBatchedSubmission()
+{
+    DECODE_FUNC_CALL();
+
+    if (GetBatchedFrameCount() == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Packets added for a frame which is not executed must not be submitted with the batch
+    DECODE_CHK_STATUS(m_task->Clear());
+    return m_task->SubmitPending();
+}
+
 bool DecodePipeline::IsCompleteBitstream()
 {
     return (m_bitstream == nullptr) ? false : m_bitstream->IsComplete();
@@ -313,6 +313,27 @@ public:
     //!
     bool IsFirstProcessPipe(const DecodePipelineParams &pipelineParams);
 
+    //!
+    //! \brief  Indicates whether command buffer of current frame is recorded for batched submission
+    //! \return bool
+    //!         true if current frame is submitted together with later frames
+    //!
+    bool IsBatchedSubmission() { return m_batchedSubmission; }
+
+    //!
+    //! \brief  Submit the frames recorded for batched submission
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS FlushBatchedSubmission();
+
+    //!
+    //! \brief  Get the number of frames recorded but not submitted
+    //! \return uint32_t
+    //!         Number of pending frames
+    //!
+    uint32_t GetBatchedFrameCount() { return (m_task == nullptr) ? 0 : m_task->GetPendingCount(); }
+
 protected:
     //!
     //! \brief  Initialize the decode pipeline
@@ -337,6 +358,13 @@ protected:
     //!
     virtual MOS_STATUS UserFeatureReport() override;
 
+    //!
+    //! \brief  Declare Regkeys in the scope of decode
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS InitUserSetting(MediaUserSettingSharedPtr userSettingPtr) override;
+
     //!
     //! \brief  Get the number of Vdbox
     //! \return uint8_t
@@ -358,6 +386,15 @@ protected:
     //!
     MOS_STATUS ExecuteActivePackets() override;
 
+    //!
+    //! \brief  Check whether the active packets can be recorded for batched submission
+    //! \details Batched submission needs single pipe, no KMD frame tracking, no CP
+    //!          and only packets which never lock resources by CPU
+    //! \return bool
+    //!         true if the active packets can be batched
+    //!
+    virtual bool IsActivePacketsBatchable();
+
     //!
     //! \brief  Create pre sub pipelines
     //! \param  [in] subPipelineManager
@@ -491,6 +528,10 @@ protected:
 
     bool                    m_singleTaskPhaseSupported = true; //!< Indicates whether sumbit packets in single phase
 
+    static constexpr uint32_t m_maxBatchedFrames = 8;   //!< Upper limit of frames per batched submission
+    uint32_t                m_batchedFramesMax  = 0;    //!< Frames per batched submission, 0 or 1 to disable
+    bool                    m_batchedSubmission = false; //!< Indicates whether current frame is recorded for batched submission
+
     MOS_GPU_CONTEXT         m_decodeContext = MOS_GPU_CONTEXT_INVALID_HANDLE;    //!< decode context inuse
 
 #if (_DEBUG || _RELEASE_INTERNAL)
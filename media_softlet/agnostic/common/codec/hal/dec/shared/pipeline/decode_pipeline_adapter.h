@@ -65,6 +65,20 @@ public:
     virtual uint32_t GetCompletedReport() = 0;
     virtual MOS_GPU_CONTEXT GetDecodeContext() = 0;
 
+    //!
+    //! \brief  Submit the frames recorded for batched submission
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS FlushBatchedSubmission() { return MOS_STATUS_SUCCESS; }
+
+    //!
+    //! \brief  Get the number of frames recorded but not submitted
+    //! \return uint32_t
+    //!         Number of pending frames
+    //!
+    virtual uint32_t GetBatchedFrameCount() { return 0; }
+
 MEDIA_CLASS_DEFINE_END(DecodePipelineAdapter)
 };
 #endif // !__DECODE_PIPELINE_ADAPTER_H__
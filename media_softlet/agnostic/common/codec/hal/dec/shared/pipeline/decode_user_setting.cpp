@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2018-2021, Intel Corporation
+* Copyright (c) 2022, Intel Corporation
 *
 * Permission is hereby granted, free of charge, to any person obtaining a
 * copy of this software and associated documentation files (the "Software"),
@@ -19,15 +19,28 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
-#include <cstring>
-#include "mos_utilities.h"
-using namespace std;
+//!
+//! \file     decode_user_setting.cpp
+//! \brief    Initialize user setting of decode
+//!
 
-void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
+#include "decode_pipeline.h"
+#include "decode_utils.h"
+
+namespace decode
+{
+MOS_STATUS DecodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSettingPtr)
 {
-    if(pDestination != nullptr)
-    {
-        memset(pDestination, 0, stLength);
-    }
+    DECODE_FUNC_CALL();
+    DECODE_CHK_STATUS(MediaPipeline::InitUserSetting(userSettingPtr));
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Batched Submission Frames",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
+
+    return MOS_STATUS_SUCCESS;
 }
 
+}  // namespace decode
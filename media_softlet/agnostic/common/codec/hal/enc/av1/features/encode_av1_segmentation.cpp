@@ -292,13 +292,16 @@ namespace encode
 
         ENCODE_CHK_STATUS_RETURN(CheckSegmentationMap());
 
-        auto streamInData = m_streamIn->GetStreamInBuffer();
+        // Stream in buffer is only locked if any block has a different segment id
+        VdencStreamInState *streamInData = nullptr;
+        MOS_STATUS          status       = FillSegmentationMap(streamInData);
 
-        FillSegmentationMap(streamInData);
-
-        m_streamIn->ReturnStreamInBuffer();
+        if (streamInData != nullptr)
+        {
+            m_streamIn->ReturnStreamInBuffer();
+        }
 
-        return MOS_STATUS_SUCCESS;
+        return status;
     }
 
     MOS_STATUS Av1Segmentation::CheckSegmentationMap() const
@@ -328,10 +331,11 @@ namespace encode
         return (coord * oldUnit) / newUnit;
     }
 
-    MOS_STATUS Av1Segmentation::FillSegmentationMap(VdencStreamInState* streamInData) const
+    MOS_STATUS Av1Segmentation::FillSegmentationMap(VdencStreamInState *&streamInData) const
     {
         ENCODE_FUNC_CALL();
-        ENCODE_CHK_NULL_RETURN(streamInData);
+        ENCODE_CHK_NULL_RETURN(m_streamIn);
+        ENCODE_CHK_NULL_RETURN(m_pSegmentMap);
         ENCODE_CHK_NULL_RETURN(m_basicFeature->m_av1PicParams);
 
         const uint8_t blockSize = Av1StreamIn::m_streamInBlockSize;
@@ -341,24 +345,51 @@ namespace encode
         uint16_t FrameWidthInStreamInBlocks  = MOS_ALIGN_CEIL(CurFrameWidth, blockSize) / blockSize;
         uint16_t FrameHeightInStreamInBlocks = MOS_ALIGN_CEIL(CurFrameHeight, blockSize) / blockSize;
 
-        for (int yIdx = 0; yIdx < FrameHeightInStreamInBlocks; yIdx++)
+        const uint32_t segMapPitch = MOS_ALIGN_CEIL(CurFrameWidth, m_segmentMapBlockSize) / m_segmentMapBlockSize;
+
+        // Segment ids already in the recycled stream in buffer
+        uint16_t *blockSegIds = m_streamIn->GetBlockSegIds();
+        ENCODE_CHK_NULL_RETURN(blockSegIds);
+        const uint32_t blockNum = m_streamIn->GetBlockNum();
+
+        // Column of the segment map is the same for all rows
+        std::vector<uint32_t> segMapXs(FrameWidthInStreamInBlocks);
+        for (uint32_t xIdx = 0; xIdx < FrameWidthInStreamInBlocks; xIdx++)
+        {
+            segMapXs[xIdx] = ScaleCoord(xIdx, blockSize, m_segmentMapBlockSize);
+        }
+
+        for (uint32_t yIdx = 0; yIdx < FrameHeightInStreamInBlocks; yIdx++)
         {
+            const uint8_t *segMapRow = m_pSegmentMap + ScaleCoord(yIdx, blockSize, m_segmentMapBlockSize) * segMapPitch;
+
             for (uint32_t xIdx = 0; xIdx < FrameWidthInStreamInBlocks; xIdx++)
             {
                 const uint32_t IdxBlockInStreamIn = m_streamIn->GetCuOffset(xIdx, yIdx);
-                const uint32_t segMapPitch = MOS_ALIGN_CEIL(CurFrameWidth, m_segmentMapBlockSize) / m_segmentMapBlockSize;
-                const uint32_t segMapY = ScaleCoord(yIdx, blockSize, m_segmentMapBlockSize);
-                const uint32_t segMapX = ScaleCoord(xIdx, blockSize, m_segmentMapBlockSize);
+                ENCODE_CHK_COND_RETURN(IdxBlockInStreamIn >= blockNum, "Stream in block out of range");
 
-                ENCODE_ASSERT(m_pSegmentMap);
+                const uint8_t segId = segMapRow[segMapXs[xIdx]];
+                if (blockSegIds[IdxBlockInStreamIn] == segId)
+                {
+                    continue;
+                }
 
-                const uint8_t segId = m_pSegmentMap[segMapY * segMapPitch + segMapX];
+                if (streamInData == nullptr)
+                {
+                    streamInData = m_streamIn->GetStreamInBuffer();
+                    ENCODE_CHK_NULL_RETURN(streamInData);
+                }
 
-                streamInData[IdxBlockInStreamIn].DW7.SegIDEnable = 1;
+                // DW7 is only written here and is zero after stream in init, so
+                // the whole dword is stored instead of updating the bitfields.
                 // Minimum size for a SegID is a 32x32 block.
                 // All four 16x16 blocks within a 32x32 should share the same Segmentation ID.
-                streamInData[IdxBlockInStreamIn].DW7.SegID = segId | (segId << 4) | (segId << 8) | (segId << 12);
+                VdencStreamInState block = {};
+                block.DW7.SegIDEnable = 1;
+                block.DW7.SegID       = segId | (segId << 4) | (segId << 8) | (segId << 12);
+                streamInData[IdxBlockInStreamIn].DW7.Value = block.DW7.Value;
 
+                blockSegIds[IdxBlockInStreamIn] = segId;
             }
         }
         return MOS_STATUS_SUCCESS;
@@ -108,13 +108,15 @@ protected:
     MOS_STATUS CheckSegmentationMap() const;
 
     //!
-    //! \brief  Fill segmentation map into provided stream in buffer
-    //! \param  [in] streamInData
-    //!         pointer to stream in buffer locked address
+    //! \brief  Fill segmentation map into stream in buffer
+    //! \details Blocks whose segment id is already in the recycled stream in
+    //!          buffer are skipped, the buffer is locked on first changed block
+    //! \param  [in, out] streamInData
+    //!         pointer to stream in buffer locked address, nullptr if not locked
     //! \return MOS_STATUS
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
-    MOS_STATUS FillSegmentationMap(VdencStreamInState* streamInData) const;
+    MOS_STATUS FillSegmentationMap(VdencStreamInState *&streamInData) const;
 
     CodecAv1SegmentsParams m_segmentParams = {};             //!< Segment Params
     uint8_t                m_segmentNum = 0;                 //!< Segment number
@@ -118,6 +118,14 @@ namespace encode
                 m_LcuMap = static_cast<uint32_t*>(MOS_AllocAndZeroMemory(m_widthInLCU * m_widthInLCU * sizeof(uint32_t)));
             }
             ENCODE_CHK_STATUS_RETURN(SetupLCUMap());
+
+            // Block layout changed, content of recycled buffers is stale
+            for (auto &state : m_bufferStates)
+            {
+                state = BufferState();
+            }
+            m_currBufferState = nullptr;
+
             m_initialized = true;
         }
 
@@ -133,18 +141,60 @@ namespace encode
 
             ENCODE_CHK_NULL_RETURN(m_streamInBuffer);
 
-            uint8_t* streaminBuffer = (uint8_t*)m_allocator->LockResourceForWrite(m_streamInBuffer);
-            ENCODE_CHK_NULL_RETURN(streaminBuffer);
+            CommonStreamInParams initParams = {};
+            ENCODE_CHK_STATUS_RETURN(GetInitParams(initParams));
 
-            ENCODE_CHK_STATUS_RETURN(StreamInInit(streaminBuffer));
+            // Recycled buffer still holds the blocks of an earlier frame, only
+            // initialize it again when the init parameters are different
+            BufferState &state = GetBufferState(m_streamInBuffer);
+            m_currBufferState  = nullptr;
+            if (!state.initialized || memcmp(&state.initParams, &initParams, sizeof(initParams)) != 0)
+            {
+                uint8_t* streaminBuffer = (uint8_t*)m_allocator->LockResourceForWrite(m_streamInBuffer);
+                ENCODE_CHK_NULL_RETURN(streaminBuffer);
 
-            m_allocator->UnLock(m_streamInBuffer);
+                MOS_STATUS status = StreamInInit(streaminBuffer, initParams);
+
+                m_allocator->UnLock(m_streamInBuffer);
+                ENCODE_CHK_STATUS_RETURN(status);
+
+                state.initialized = true;
+                state.initParams  = initParams;
+                state.segIds.assign(GetBlockNum(), m_invalidSegId);
+            }
+            m_currBufferState = &state;
 
             m_enabled = true;
         }
         return MOS_STATUS_SUCCESS;
     }
 
+    Av1StreamIn::BufferState &Av1StreamIn::GetBufferState(PMOS_RESOURCE resource)
+    {
+        for (auto &state : m_bufferStates)
+        {
+            if (state.resource == resource)
+            {
+                return state;
+            }
+        }
+
+        BufferState &state = m_bufferStates[m_nextBufferState];
+        m_nextBufferState  = (m_nextBufferState + 1) % m_maxBufferStateNum;
+        state              = BufferState();
+        state.resource     = resource;
+        return state;
+    }
+
+    uint16_t *Av1StreamIn::GetBlockSegIds()
+    {
+        if (!m_enabled || m_currBufferState == nullptr || m_currBufferState->segIds.size() != GetBlockNum())
+        {
+            return nullptr;
+        }
+        return m_currBufferState->segIds.data();
+    }
+
     static MOS_STATUS CalculateTilesBoundary(
         PCODEC_AV1_ENCODE_PICTURE_PARAMS av1PicParams,
         uint32_t* rowBd,
@@ -265,42 +315,52 @@ namespace encode
         return MOS_STATUS_SUCCESS;
     }
 
-    MOS_STATUS Av1StreamIn::StreamInInit(uint8_t *streamInBuffer)
+    MOS_STATUS Av1StreamIn::GetInitParams(CommonStreamInParams &params)
     {
         ENCODE_CHK_NULL_RETURN(m_osInterface);
-        uint16_t numLCUs = m_widthInLCU * m_heightInLCU;
-        memset(streamInBuffer, 0, numLCUs * m_num32x32BlocksInLCU * sizeof(VdencStreamInState));
+        ENCODE_CHK_NULL_RETURN(m_basicFeature);
+        ENCODE_CHK_NULL_RETURN(m_basicFeature->m_av1PicParams);
+
         Av1FrameType frame_type = static_cast<Av1FrameType>(m_basicFeature->m_av1PicParams->PicFlags.fields.frame_type);
         MEDIA_WA_TABLE *pWaTable   = m_osInterface->pfnGetWaTable(m_osInterface);
         ENCODE_CHK_NULL_RETURN(pWaTable);
 
-        for (uint16_t LcuAddr = 0; LcuAddr < numLCUs; LcuAddr++)
+        if (MEDIA_IS_WA(pWaTable, Wa_22011549751) && frame_type == keyFrame && !m_osInterface->bSimIsActive && !Mos_Solo_Extension(m_osInterface->pOsContext))
         {
-            for (uint16_t CuAddr = 0; CuAddr < m_num32x32BlocksInLCU; CuAddr++)
-            {
-                VdencStreamInState* pStreamIn32x32 = (VdencStreamInState *)(streamInBuffer) + LcuAddr * m_num32x32BlocksInLCU + CuAddr;
-
-                if (MEDIA_IS_WA(pWaTable, Wa_22011549751) && frame_type == keyFrame && !m_osInterface->bSimIsActive && !Mos_Solo_Extension(m_osInterface->pOsContext))
-                {
-                    pStreamIn32x32->DW0.MaxCuSize                = 3;
-                    pStreamIn32x32->DW0.MaxTuSize                = 3;
-                    pStreamIn32x32->DW0.NumImePredictors         = 0;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu8x8   = 2;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu16x16 = 0;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu32x32 = 0;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu64x64 = 0;
-                }
-                else
-                {
-                    pStreamIn32x32->DW0.MaxCuSize                = m_commonPar.MaxCuSize;
-                    pStreamIn32x32->DW0.MaxTuSize                = m_commonPar.MaxTuSize;
-                    pStreamIn32x32->DW0.NumImePredictors         = m_commonPar.NumImePredictors;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu8x8   = m_commonPar.NumMergeCandidateCu8x8;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu16x16 = m_commonPar.NumMergeCandidateCu16x16;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu32x32 = m_commonPar.NumMergeCandidateCu32x32;
-                    pStreamIn32x32->DW6.NumMergeCandidateCu64x64 = m_commonPar.NumMergeCandidateCu64x64;
-                }
-            }
+            params.MaxCuSize                = 3;
+            params.MaxTuSize                = 3;
+            params.NumImePredictors         = 0;
+            params.NumMergeCandidateCu8x8   = 2;
+            params.NumMergeCandidateCu16x16 = 0;
+            params.NumMergeCandidateCu32x32 = 0;
+            params.NumMergeCandidateCu64x64 = 0;
+        }
+        else
+        {
+            params = m_commonPar;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS Av1StreamIn::StreamInInit(uint8_t *streamInBuffer, const CommonStreamInParams &params)
+    {
+        ENCODE_CHK_NULL_RETURN(streamInBuffer);
+
+        // All blocks start out the same, so set the bitfields once and copy the block
+        VdencStreamInState streamIn32x32 = {};
+        streamIn32x32.DW0.MaxCuSize                = params.MaxCuSize;
+        streamIn32x32.DW0.MaxTuSize                = params.MaxTuSize;
+        streamIn32x32.DW0.NumImePredictors         = params.NumImePredictors;
+        streamIn32x32.DW6.NumMergeCandidateCu8x8   = params.NumMergeCandidateCu8x8;
+        streamIn32x32.DW6.NumMergeCandidateCu16x16 = params.NumMergeCandidateCu16x16;
+        streamIn32x32.DW6.NumMergeCandidateCu32x32 = params.NumMergeCandidateCu32x32;
+        streamIn32x32.DW6.NumMergeCandidateCu64x64 = params.NumMergeCandidateCu64x64;
+
+        VdencStreamInState *pStreamIn32x32 = (VdencStreamInState *)streamInBuffer;
+        uint32_t            numBlocks      = GetBlockNum();
+        for (uint32_t i = 0; i < numBlocks; i++)
+        {
+            pStreamIn32x32[i] = streamIn32x32;
         }
         return MOS_STATUS_SUCCESS;
     }
@@ -31,6 +31,7 @@
 #include "mhw_vdbox_vdenc_interface.h"
 #include "mhw_vdbox_vdenc_itf.h"
 #include "mhw_vdbox_avp_itf.h"
+#include <vector>
 
 namespace encode
 {
@@ -271,7 +272,26 @@ public:
 
     const CommonStreamInParams& GetCommonParams() const;
 
+    //!
+    //! \brief  Get segment ids already written to current stream in buffer
+    //! \details One entry per 32x32 block in stream in buffer order,
+    //!          m_invalidSegId if the block has not been written since init.
+    //!          Callers writing SegID update it so that unchanged blocks can
+    //!          be skipped when the buffer is recycled.
+    //! \return uint16_t*
+    //!         pointer to segment id per block, nullptr if stream in not updated
+    //!
+    uint16_t *GetBlockSegIds();
+
+    //!
+    //! \brief  Get number of 32x32 blocks in stream in buffer
+    //! \return uint32_t
+    //!         number of blocks
+    //!
+    uint32_t GetBlockNum() const { return m_widthInLCU * m_heightInLCU * m_num32x32BlocksInLCU; }
+
     static const uint8_t m_streamInBlockSize = 32;              //!< size of stream in block in one dimension
+    static const uint16_t m_invalidSegId = 0xFFFF;              //!< segment id of block not written
 
 protected:
     //!
@@ -294,12 +314,44 @@ protected:
     //!
     uint32_t GetLCUAddr(uint32_t x, uint32_t y) const;
 
+    //!
+    //! \brief  Get parameters all stream in blocks are initialized with
+    //! \param  [out] params
+    //!         Init parameters of current frame
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetInitParams(CommonStreamInParams &params);
+
     //!
     //! \brief  Initialize all stream in blocks
     //! \param  [in] streamInBuffer
     //!         pointer to stream in buffer locked address
+    //! \param  [in] params
+    //!         Init parameters from GetInitParams
+    //!
+    MOS_STATUS StreamInInit(uint8_t *streamInBuffer, const CommonStreamInParams &params);
+
+    //!
+    //! \struct BufferState
+    //! \brief  Content of a recycled stream in buffer written by the driver
     //!
-    MOS_STATUS StreamInInit(uint8_t *streamInBuffer);
+    struct BufferState
+    {
+        PMOS_RESOURCE         resource    = nullptr;  //!< Stream in buffer
+        bool                  initialized = false;    //!< Blocks initialized with initParams
+        CommonStreamInParams  initParams  = {};       //!< Parameters the blocks were initialized with
+        std::vector<uint16_t> segIds;                 //!< Segment id per block
+    };
+
+    //!
+    //! \brief  Find the state of a stream in buffer, or recycle the oldest one
+    //! \param  [in] resource
+    //!         Stream in buffer
+    //! \return BufferState&
+    //!         State of the buffer
+    //!
+    BufferState &GetBufferState(PMOS_RESOURCE resource);
 
     Av1BasicFeature *m_basicFeature = nullptr;        //!< AV1 paramter
     EncodeAllocator *m_allocator = nullptr;           //!< Encode allocator
@@ -317,6 +369,11 @@ protected:
 
     CommonStreamInParams m_commonPar = {};
 
+    static const uint8_t m_maxBufferStateNum = 6;               //!< Same as depth of the recycle queue
+    BufferState  m_bufferStates[m_maxBufferStateNum];
+    uint8_t      m_nextBufferState = 0;                         //!< Next state to recycle
+    BufferState *m_currBufferState = nullptr;                   //!< State of m_streamInBuffer
+
 MEDIA_CLASS_DEFINE_END(Av1StreamIn)
 };
 
@@ -98,7 +98,9 @@ namespace encode
             // Const Data buffer
             allocParamsForBufferLinear.dwBytes = MOS_ALIGN_CEIL(m_vdencBrcConstDataBufferSize, CODECHAL_PAGE_SIZE);
             allocParamsForBufferLinear.pBufName = "VDENC BRC Const Data Buffer";
+            allocParamsForBufferLinear.Flags.bPersistentMap = true;  // rewritten every frame
             allocatedbuffer       = m_allocator->AllocateResource(allocParamsForBufferLinear, true);
+            allocParamsForBufferLinear.Flags.bPersistentMap = false;
             ENCODE_CHK_NULL_RETURN(allocatedbuffer);
             m_vdencBrcConstDataBuffer[k] = *allocatedbuffer;
 
@@ -121,7 +123,9 @@ namespace encode
                 // BRC update DMEM
                 allocParamsForBufferLinear.dwBytes = MOS_ALIGN_CEIL(m_vdencBrcUpdateDmemBufferSize, CODECHAL_CACHELINE_SIZE);
                 allocParamsForBufferLinear.pBufName = "VDENC BrcUpdate DmemBuffer";
+                allocParamsForBufferLinear.Flags.bPersistentMap = true;  // rewritten every pass
                 allocatedbuffer                     = m_allocator->AllocateResource(allocParamsForBufferLinear, true);
+                allocParamsForBufferLinear.Flags.bPersistentMap = false;
                 ENCODE_CHK_NULL_RETURN(allocatedbuffer);
                 m_vdencBrcUpdateDmemBuffer[k][i] = *allocatedbuffer;
             }
@@ -75,6 +75,10 @@ MOS_STATUS HevcBasicFeature::Init(void *setting)
         outValue,
         "Disable HEVC RDOQ Perf",
         MediaUserSetting::Group::Sequence);
+    m_roundingEnableSettingId = GetUserSettingId(
+        m_userSettingPtr,
+        "HEVC VDEnc Rounding Enable",
+        MediaUserSetting::Group::Sequence);
 #endif  // _DEBUG || _RELEASE_INTERNAL
     m_hevcRDOQPerfDisabled = outValue.Get<bool>();
 
@@ -152,8 +156,7 @@ MOS_STATUS HevcBasicFeature::Update(void *params)
     ReadUserSetting(
         m_userSettingPtr,
         outValue,
-        "HEVC VDEnc Rounding Enable",
-        MediaUserSetting::Group::Sequence);
+        m_roundingEnableSettingId);
     m_hevcVdencRoundingPrecisionEnabled = outValue.Get<bool>();
     ReportUserSettingForDebug(
         m_userSettingPtr,
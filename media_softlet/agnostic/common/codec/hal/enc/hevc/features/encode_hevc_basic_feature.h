@@ -147,6 +147,10 @@ public:
 
     uint32_t m_picStateCmdStartInBytes = 0;       //!< Offset of PIC_STATE cmd in batch buffer
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MediaUserSetting::SettingId m_roundingEnableSettingId = MediaUserSetting::InvalidSettingId;  //!< "HEVC VDEnc Rounding Enable", read per frame
+#endif
+
 #ifdef _ENCODE_RESERVED
     HevcBasicFeatureRsvd *m_rsvdState = nullptr;
     MOS_STATUS            InitRsvdState();
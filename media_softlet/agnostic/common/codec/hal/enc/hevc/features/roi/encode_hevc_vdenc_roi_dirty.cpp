@@ -44,6 +44,9 @@ MOS_STATUS DirtyROI::PrepareParams(
     m_dirtyRegions  = hevcPicParams->pDirtyRect;
     ENCODE_CHK_NULL_RETURN(m_dirtyRegions);
 
+    m_bkTemplateValid[0] = false;
+    m_bkTemplateValid[1] = false;
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -198,32 +201,40 @@ MOS_STATUS DirtyROI::WriteStreaminData(
 {
     ENCODE_CHK_NULL_RETURN(rawStreamIn);
 
-    StreamInParams streaminDataParams;
-    MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
-
     switch (marker)
     {
     case RoiOverlap::mkDirtyRoi:
-        SetStreaminParamByTU(true, streaminDataParams);
+        ApplyStreaminTemplate(GetStreaminTemplateByTU(true), rawStreamIn + (lcuIndex * 64));
         break;
     case RoiOverlap::mkDirtyRoiNone64Align:
-        SetStreaminParamByTU(false, streaminDataParams);
+        ApplyStreaminTemplate(GetStreaminTemplateByTU(false), rawStreamIn + (lcuIndex * 64));
         break;
     case RoiOverlap::mkDirtyRoiBk:
-        SetStreaminBackgroundData(true, streaminDataParams);
+        ApplyStreaminTemplate(GetStreaminBackgroundTemplate(true), rawStreamIn + (lcuIndex * 64));
         break;
     case RoiOverlap::mkDirtyRoiBkNone64Align:
-        SetStreaminBackgroundData(false, streaminDataParams);
-        
+        ApplyStreaminTemplate(GetStreaminBackgroundTemplate(false), rawStreamIn + (lcuIndex * 64));
         break;
     default:
         return MOS_STATUS_INVALID_PARAMETER;
     }
 
-    SetStreaminDataPerLcu(&streaminDataParams, rawStreamIn + (lcuIndex * 64));
     return MOS_STATUS_SUCCESS;
 }
 
+const RoiStrategy::StreaminTemplate &DirtyROI::GetStreaminBackgroundTemplate(bool cu64Align)
+{
+    uint32_t index = cu64Align ? 1 : 0;
+    if (!m_bkTemplateValid[index])
+    {
+        StreamInParams streaminDataParams = {};
+        SetStreaminBackgroundData(cu64Align, streaminDataParams);
+        BuildStreaminTemplate(streaminDataParams, m_bkTemplate[index]);
+        m_bkTemplateValid[index] = true;
+    }
+    return m_bkTemplate[index];
+}
+
 void DirtyROI::HandleRightNot64CuAligned(
     uint16_t  right,
     uint16_t  top,
@@ -389,11 +400,8 @@ void DirtyROI::StreaminSetDirtyRectRegion(
 {
     ENCODE_FUNC_CALL();
 
-    std::vector<uint32_t> lcuVector;
-    GetLCUsInRoiRegion(streamInWidth, top, bottom, left, right, lcuVector);
-
-    overlap.MarkLcus(lcuVector, cu64Align ? 
-        RoiOverlap::mkDirtyRoi : 
+    MarkLcusInRoiRegion(overlap, streamInWidth, top, bottom, left, right, cu64Align ?
+        RoiOverlap::mkDirtyRoi :
         RoiOverlap::mkDirtyRoiNone64Align);
 }
 
@@ -407,13 +415,8 @@ void DirtyROI::StreaminSetBorderNon64AlignStaticRegion(
 {
     ENCODE_FUNC_CALL();
 
-    std::vector<uint32_t> lcuVector;
-    GetLCUsInRoiRegion(streamInWidth, top, bottom, left, right, lcuVector);
-
-    for (uint32_t lcu : lcuVector)
-    {
-        overlap.MarkLcus(lcuVector, RoiOverlap::mkDirtyRoiBkNone64Align);
-    }
+    MarkLcusInRoiRegion(overlap, streamInWidth, top, bottom, left, right,
+        RoiOverlap::mkDirtyRoiBkNone64Align);
 }
 
 void DirtyROI::SetStreaminBackgroundData(
@@ -243,10 +243,24 @@ private:
     void SetStreaminBackgroundData(bool cu64Align,
         StreamInParams &                streaminDataParams);
 
+    //!
+    //! \brief    Get the template of SetStreaminBackgroundData for current frame
+    //!
+    //! \param    [in] cu64Align
+    //!           Is 64 CU aligned
+    //!
+    //! \return   const StreaminTemplate &
+    //!           Template of the background params
+    //!
+    const StreaminTemplate &GetStreaminBackgroundTemplate(bool cu64Align);
+
 protected:
     uint8_t    m_numDirtyRects = 0;
     CODEC_ROI *m_dirtyRegions  = nullptr;
 
+    StreaminTemplate m_bkTemplate[2]      = {};  //!< Background templates of current frame, indexed by cu64Align
+    bool             m_bkTemplateValid[2] = {};
+
 MEDIA_CLASS_DEFINE_END(DirtyROI)
 };
 
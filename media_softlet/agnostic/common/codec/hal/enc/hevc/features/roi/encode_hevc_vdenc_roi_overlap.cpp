@@ -102,6 +102,26 @@ void RoiOverlap::MarkLcu(uint32_t lcu, OverlapMarker marker)
     }
 }
 
+void RoiOverlap::MarkRegion(
+    uint32_t streamInWidth,
+    uint32_t top,
+    uint32_t bottom,
+    uint32_t left,
+    uint32_t right,
+    OverlapMarker marker,
+    int32_t roiRegionIndex)
+{
+    for (uint32_t y = top; y < bottom; y++)
+    {
+        // 32x32 LCUs are stored in zig zag order inside each 64x64 LCU
+        uint32_t rowBase = streamInWidth * (y & ~1u) + ((y & 1) ? 2 : 0);
+        for (uint32_t x = left; x < right; x++)
+        {
+            MarkLcu(rowBase + 2 * (x & ~1u) + (x & 1), marker, roiRegionIndex);
+        }
+    }
+}
+
 MOS_STATUS RoiOverlap::WriteStreaminData(
     RoiStrategy *roi,
     RoiStrategy *dirtyRoi,
@@ -110,14 +130,32 @@ MOS_STATUS RoiOverlap::WriteStreaminData(
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
     ENCODE_CHK_NULL_RETURN(m_overlapMap);
 
-    for (uint32_t i = 0; i < m_lcuNumber; i++)
+    if (roi)
+    {
+        ENCODE_CHK_STATUS_RETURN(roi->BeginStreaminData());
+    }
+    MOS_STATUS status = dirtyRoi ? dirtyRoi->BeginStreaminData() : MOS_STATUS_SUCCESS;
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        if (roi)
+        {
+            roi->EndStreaminData();
+        }
+        ENCODE_CHK_STATUS_RETURN(status);
+    }
+
+    for (uint32_t i = 0; i < m_lcuNumber && status == MOS_STATUS_SUCCESS; i++)
     {
         OverlapMarker marker = GetMarker(m_overlapMap[i]);
         uint32_t      roiRegionIndex = GetRoiRegionIndex(m_overlapMap[i]);
 
         if (IsRoiMarker(marker))
         {
-            ENCODE_CHK_NULL_RETURN(roi);
+            if (roi == nullptr)
+            {
+                status = MOS_STATUS_NULL_POINTER;
+                break;
+            }
 
             roi->WriteStreaminData(
                 i, marker, roiRegionIndex, streaminBuffer);
@@ -125,11 +163,27 @@ MOS_STATUS RoiOverlap::WriteStreaminData(
         }
         else if (IsDirtyRoiMarker(marker))
         {
-            ENCODE_CHK_NULL_RETURN(dirtyRoi);
+            if (dirtyRoi == nullptr)
+            {
+                status = MOS_STATUS_NULL_POINTER;
+                break;
+            }
             dirtyRoi->WriteStreaminData(
                 i, marker, roiRegionIndex, streaminBuffer);
         }
     }
+
+    // Always pair the begin calls, strategies may hold locked resources
+    if (roi)
+    {
+        roi->EndStreaminData();
+    }
+    if (dirtyRoi)
+    {
+        dirtyRoi->EndStreaminData();
+    }
+
+    ENCODE_CHK_STATUS_RETURN(status);
     return MOS_STATUS_SUCCESS;
 }
 
@@ -86,7 +86,7 @@ public:
     //! \return void
     //!
     void MarkLcus(
-        const UintVector lcus, 
+        const UintVector &lcus, 
         OverlapMarker marker, 
         int32_t roiRegionIndex = m_maskRoiRegionIndex)
     {
@@ -107,6 +107,32 @@ public:
     //!
     void MarkLcu(uint32_t lcu, OverlapMarker marker);
 
+    //!
+    //! \brief  Mark all LCUs of a rectangle in a frame without tiles
+    //!
+    //! \detail The LCU indexes are computed row by row in the same zig zag
+    //!         order as RoiStrategy::StreaminZigZagToLinearMap, so no LCU
+    //!         vector needs to be built for the region.
+    //!
+    //! \param  [in] streamInWidth
+    //!         Width of stream-in in 32x32 LCU
+    //! \param  [in] top, bottom, left, right
+    //!         Region in 32x32 LCU, bottom and right are exclusive
+    //! \param  [in] marker
+    //!         overlap marker
+    //! \param  [in] roiRegionIndex
+    //!         Index of ROI region
+    //! \return void
+    //!
+    void MarkRegion(
+        uint32_t streamInWidth,
+        uint32_t top,
+        uint32_t bottom,
+        uint32_t left,
+        uint32_t right,
+        OverlapMarker marker,
+        int32_t roiRegionIndex = m_maskRoiRegionIndex);
+
     //!
     //! \brief  Write streamin data according to the overlap map
     //!
@@ -79,6 +79,39 @@ namespace encode
         }
     }
 
+    MOS_STATUS QPMapROI::BeginStreaminData()
+    {
+        ENCODE_CHK_NULL_RETURN(m_allocator);
+        ENCODE_CHK_NULL_RETURN(m_basicFeature);
+
+        m_qpDataWidth  = m_basicFeature->m_mbQpDataSurface.dwWidth;
+        m_qpDataHeight = m_basicFeature->m_mbQpDataSurface.dwHeight;
+        m_qpDataPitch  = m_basicFeature->m_mbQpDataSurface.dwPitch;
+
+        // Only the QP map rows are read, not the padding of the surface allocation.
+        // SetRoiCtrlMode may read the two rows below the map for the last LCU row.
+        m_qpData = (uint8_t *)m_allocator->LockResourceRegionForRead(
+            &(m_basicFeature->m_mbQpDataSurface.OsResource), 0, m_qpDataHeight + 2);
+        ENCODE_CHK_NULL_RETURN(m_qpData);
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS QPMapROI::EndStreaminData()
+    {
+        if (m_qpData == nullptr)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+        m_qpData = nullptr;
+
+        ENCODE_CHK_NULL_RETURN(m_allocator);
+        ENCODE_CHK_NULL_RETURN(m_basicFeature);
+        ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(&(m_basicFeature->m_mbQpDataSurface.OsResource)));
+
+        return MOS_STATUS_SUCCESS;
+    }
+
     MOS_STATUS QPMapROI::WriteStreaminData(
         uint32_t                  lcuIndex,
         RoiOverlap::OverlapMarker marker,
@@ -86,21 +119,16 @@ namespace encode
         uint8_t *                 rawStreamIn)
     {
         ENCODE_CHK_NULL_RETURN(rawStreamIn);
+        // QP data is locked once per frame by BeginStreaminData
+        ENCODE_CHK_NULL_RETURN(m_qpData);
         bool cu64Align = false;
 
         StreamInParams streaminDataParams;
         MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
-        uint8_t *QpData = (uint8_t *)m_allocator->LockResourceForRead(&(m_basicFeature->m_mbQpDataSurface.OsResource));
-        ENCODE_CHK_NULL_RETURN(QpData);
-
-        uint32_t w_in16 = m_basicFeature->m_mbQpDataSurface.dwWidth;
-        uint32_t h_in16 = m_basicFeature->m_mbQpDataSurface.dwHeight;
-        uint32_t Pitch  = m_basicFeature->m_mbQpDataSurface.dwPitch;
 
-        SetRoiCtrlMode(lcuIndex, streaminDataParams, w_in16, h_in16, Pitch, QpData);
+        SetRoiCtrlMode(lcuIndex, streaminDataParams, m_qpDataWidth, m_qpDataHeight, m_qpDataPitch, m_qpData);
         SetQpRoiCtrlPerLcu(&streaminDataParams, (HevcVdencStreamInState *)(rawStreamIn + (lcuIndex * 64)));
 
-        m_allocator->UnLock(&(m_basicFeature->m_mbQpDataSurface.OsResource));
         HevcVdencStreamInState *data = (HevcVdencStreamInState *)(rawStreamIn + (lcuIndex * 64));
 
         if (lcuIndex % 4 == 3)
@@ -111,11 +139,10 @@ namespace encode
             {
                 cu64Align = true;
             }
+            const StreaminTemplate &streaminTemplate = GetStreaminTemplateByTU(cu64Align);
             for (int i = 0; i < 4; i++)
             {
-                MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
-                SetStreaminParamByTU(cu64Align, streaminDataParams);
-                SetStreaminDataPerLcu(&streaminDataParams, rawStreamIn + (lcuIndex-i) * 64);
+                ApplyStreaminTemplate(streaminTemplate, rawStreamIn + (lcuIndex - i) * 64);
             }
         }
         return MOS_STATUS_SUCCESS;
@@ -104,7 +104,25 @@ namespace encode
             uint32_t                  roiRegionIndex,
             uint8_t *                 rawStreamIn) override;
 
+        //!
+        //! \brief    Lock the MB QP data surface once for the LCUs of a frame
+        //! \return   MOS_STATUS
+        //!           MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        virtual MOS_STATUS BeginStreaminData() override;
+
+        //!
+        //! \brief    Unlock the MB QP data surface locked by BeginStreaminData
+        //! \return   MOS_STATUS
+        //!           MOS_STATUS_SUCCESS if success, else fail reason
+        //!
+        virtual MOS_STATUS EndStreaminData() override;
+
     private:
+        uint8_t *m_qpData = nullptr;  //!< MB QP data locked between BeginStreaminData and EndStreaminData
+        uint32_t m_qpDataWidth  = 0;
+        uint32_t m_qpDataHeight = 0;
+        uint32_t m_qpDataPitch  = 0;
 
 
     MEDIA_CLASS_DEFINE_END(QPMapROI)
@@ -64,6 +64,9 @@ MOS_STATUS RoiStrategy::PrepareParams(
     m_roiDistinctDeltaQp = hevcPicParams->ROIDistinctDeltaQp;
     ENCODE_CHK_NULL_RETURN(m_roiDistinctDeltaQp);
 
+    m_tuTemplateValid[0] = false;
+    m_tuTemplateValid[1] = false;
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -144,6 +147,75 @@ void RoiStrategy::SetStreaminDataPerLcu(
     data->DW6.NumMergeCandidateCu8x8   = streaminParams->numMergeCandidateCu8x8;
 }
 
+void RoiStrategy::BuildStreaminTemplate(
+    StreamInParams   &streaminParams,
+    StreaminTemplate &streaminTemplate)
+{
+    ENCODE_FUNC_CALL();
+
+    // Bits which end up the same in both records are the ones written
+    uint32_t zeros[16] = {};
+    uint32_t ones[16];
+    memset(ones, 0xff, sizeof(ones));
+
+    SetStreaminDataPerLcu(&streaminParams, zeros);
+    SetStreaminDataPerLcu(&streaminParams, ones);
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        streaminTemplate.mask[i]  = ~(zeros[i] ^ ones[i]);
+        streaminTemplate.value[i] = zeros[i] & streaminTemplate.mask[i];
+    }
+}
+
+const RoiStrategy::StreaminTemplate &RoiStrategy::GetStreaminTemplateByTU(bool cu64Align)
+{
+    uint32_t index = cu64Align ? 1 : 0;
+    if (!m_tuTemplateValid[index])
+    {
+        StreamInParams streaminDataParams = {};
+        SetStreaminParamByTU(cu64Align, streaminDataParams);
+        BuildStreaminTemplate(streaminDataParams, m_tuTemplate[index]);
+        m_tuTemplateValid[index] = true;
+    }
+    return m_tuTemplate[index];
+}
+
+void RoiStrategy::MarkLcusInRoiRegion(
+    RoiOverlap               &overlap,
+    uint32_t                  streamInWidth,
+    uint32_t                  top,
+    uint32_t                  bottom,
+    uint32_t                  left,
+    uint32_t                  right,
+    RoiOverlap::OverlapMarker marker,
+    int32_t                   roiRegionIndex)
+{
+    if (!m_isTileModeEnabled)
+    {
+        if (roiRegionIndex < 0)
+        {
+            overlap.MarkRegion(streamInWidth, top, bottom, left, right, marker);
+        }
+        else
+        {
+            overlap.MarkRegion(streamInWidth, top, bottom, left, right, marker, roiRegionIndex);
+        }
+        return;
+    }
+
+    UintVector lcuVector;
+    GetLCUsInRoiRegion(streamInWidth, top, bottom, left, right, lcuVector);
+    if (roiRegionIndex < 0)
+    {
+        overlap.MarkLcus(lcuVector, marker);
+    }
+    else
+    {
+        overlap.MarkLcus(lcuVector, marker, roiRegionIndex);
+    }
+}
+
 MOS_STATUS RoiStrategy::SetupRoi(RoiOverlap &overlap)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
@@ -195,10 +267,7 @@ MOS_STATUS RoiStrategy::SetupRoi(RoiOverlap &overlap)
         uint16_t right  = (uint16_t)
             CodecHal_Clip3(0, streamInWidth, m_roiRegions[i].Right);
 
-        UintVector lcuVector;
-        GetLCUsInRoiRegion(streamInWidth, top, bottom, left, right, lcuVector);
-
-        overlap.MarkLcus(lcuVector, cu64Align ? 
+        MarkLcusInRoiRegion(overlap, streamInWidth, top, bottom, left, right, cu64Align ?
             RoiOverlap::mkRoi : RoiOverlap::mkRoiNone64Align, i);
     }
 
@@ -250,9 +319,7 @@ MOS_STATUS RoiStrategy::WriteStreaminData(
     SetRoiCtrlMode(lcuIndex, roiRegionIndex, streaminDataParams);
     SetQpRoiCtrlPerLcu(&streaminDataParams, (HevcVdencStreamInState *)(rawStreamIn + (lcuIndex * 64)));
 
-    MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
-    SetStreaminParamByTU(cu64Align, streaminDataParams);
-    SetStreaminDataPerLcu(&streaminDataParams, rawStreamIn + (lcuIndex * 64));
+    ApplyStreaminTemplate(GetStreaminTemplateByTU(cu64Align), rawStreamIn + (lcuIndex * 64));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -184,6 +184,8 @@ struct HevcVdencStreamInState
         return false;
     }
 };
+C_ASSERT(sizeof(HevcVdencStreamInState) == 64);
+
 //!
 //! \struct    DeltaQpForRoi
 //! \brief     This struct is defined for BRC Update HUC kernel
@@ -275,6 +277,20 @@ public:
         uint32_t roiRegionIndex,
         uint8_t *streamInBuffer);
 
+    //!
+    //! \brief    Called before WriteStreaminData is called for the LCUs of a frame
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS BeginStreaminData() { return MOS_STATUS_SUCCESS; }
+
+    //!
+    //! \brief    Called after WriteStreaminData is called for the LCUs of a frame
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS EndStreaminData() { return MOS_STATUS_SUCCESS; }
+
     //!
     //! \brief    Set VDENC_PIPE_BUF_ADDR parameters
     //!
@@ -506,6 +522,94 @@ protected:
         StreamInParams *streaminParams,
         HevcVdencStreamInState *data) {}
 
+    //!
+    //! \struct   StreaminTemplate
+    //! \brief    Bits SetStreaminDataPerLcu writes for a fixed set of params
+    //!
+    struct StreaminTemplate
+    {
+        uint32_t mask[16];   //!< Bits written by SetStreaminDataPerLcu
+        uint32_t value[16];  //!< Values of the written bits
+    };
+
+    //!
+    //! \brief    Record the bits SetStreaminDataPerLcu writes for the params
+    //!
+    //! \param    [in] streaminParams
+    //!           Params to write into stream in surface
+    //! \param    [out] streaminTemplate
+    //!           Template to apply with ApplyStreaminTemplate
+    //!
+    //! \return   void
+    //!
+    void BuildStreaminTemplate(
+        StreamInParams   &streaminParams,
+        StreaminTemplate &streaminTemplate);
+
+    //!
+    //! \brief    Write a stream-in template to one LCU
+    //! \details  Same result as SetStreaminDataPerLcu with the params of the
+    //!           template, with whole dword masked stores instead of bitfields
+    //!
+    //! \param    [in] streaminTemplate
+    //!           Template built by BuildStreaminTemplate
+    //! \param    [out] streaminData
+    //!           Pointer to the stream-in record of the LCU
+    //!
+    //! \return   void
+    //!
+    static void ApplyStreaminTemplate(
+        const StreaminTemplate &streaminTemplate,
+        void                   *streaminData)
+    {
+        uint32_t *data = (uint32_t *)streaminData;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            data[i] = (data[i] & ~streaminTemplate.mask[i]) | streaminTemplate.value[i];
+        }
+    }
+
+    //!
+    //! \brief    Get the template of SetStreaminParamByTU for current frame
+    //! \details  The TU params only depend on the alignment, so they are
+    //!           derived once per frame instead of once per LCU
+    //!
+    //! \param    [in] cu64Align
+    //!           Whether CU is 64 aligned
+    //!
+    //! \return   const StreaminTemplate &
+    //!           Template of the TU params
+    //!
+    const StreaminTemplate &GetStreaminTemplateByTU(bool cu64Align);
+
+    //!
+    //! \brief    Mark the LCUs of a region in the overlap map
+    //! \details  Without tiles the region is marked row by row, otherwise the
+    //!           LCU list of the region is built with GetLCUsInRoiRegion
+    //!
+    //! \param    [out] overlap
+    //!           Roi overlap
+    //! \param    [in] streamInWidth
+    //!           Width of the streamin
+    //! \param    [in] top, bottom, left, right
+    //!           Region in 32x32 LCU, bottom and right are exclusive
+    //! \param    [in] marker
+    //!           overlap marker
+    //! \param    [in] roiRegionIndex
+    //!           Index of ROI region, negative if the LCUs do not belong to a ROI region
+    //!
+    //! \return   void
+    //!
+    void MarkLcusInRoiRegion(
+        RoiOverlap               &overlap,
+        uint32_t                  streamInWidth,
+        uint32_t                  top,
+        uint32_t                  bottom,
+        uint32_t                  left,
+        uint32_t                  right,
+        RoiOverlap::OverlapMarker marker,
+        int32_t                   roiRegionIndex = -1);
+
     static constexpr uint8_t m_maxNumRoi             = 16;  //!< VDEnc maximum number of ROI supported
     static constexpr uint8_t m_maxNumNativeRoi       = 3;   //!< Number of native ROI supported by VDEnc HW
     static constexpr uint8_t m_imgStateImePredictors = 8;   //!< Number of predictors for IME
@@ -531,6 +635,9 @@ protected:
     HevcVdencFeatureSettings *m_FeatureSettings = nullptr;
     PMOS_INTERFACE m_osInterface = nullptr;
 
+    StreaminTemplate m_tuTemplate[2]      = {};     //!< TU templates of current frame, indexed by cu64Align
+    bool             m_tuTemplateValid[2] = {};
+
 MEDIA_CLASS_DEFINE_END(RoiStrategy)
 };
 
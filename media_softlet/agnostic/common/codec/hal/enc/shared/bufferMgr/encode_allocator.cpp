@@ -136,6 +136,18 @@ void* EncodeAllocator::LockResourceForRead(MOS_RESOURCE* resource)
     return m_allocator->Lock(resource, &lockFlags);
 }
 
+void* EncodeAllocator::LockResourceRegionForRead(MOS_RESOURCE* resource, uint32_t rowStart, uint32_t rowNum)
+{
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(MOS_LOCK_PARAMS));
+    lockFlags.ReadOnly = 1;
+
+    if (!m_allocator)
+        return nullptr;
+
+    return m_allocator->LockRegion(resource, &lockFlags, rowStart, rowNum);
+}
+
 MOS_STATUS EncodeAllocator::UnLock(MOS_RESOURCE* resource)
 {
     ENCODE_CHK_NULL_RETURN(m_allocator);
@@ -141,6 +141,19 @@ public:
     //!
     virtual void* LockResourceForRead(MOS_RESOURCE *resource);
 
+    //!
+    //! \brief  Lock rows of resource only for reading
+    //! \param  [in] resource
+    //!         Pointer to MOS_RESOURCE
+    //! \param  [in] rowStart
+    //!         First row to read
+    //! \param  [in] rowNum
+    //!         Number of rows to read
+    //! \return void*
+    //!         a poniter to data, only the locked rows are valid
+    //!
+    void* LockResourceRegionForRead(MOS_RESOURCE *resource, uint32_t rowStart, uint32_t rowNum);
+
     //!
     //! \brief  UnLock resource
     //! \param  [in] resource
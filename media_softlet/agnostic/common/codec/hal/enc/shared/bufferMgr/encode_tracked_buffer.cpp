@@ -38,6 +38,19 @@ TrackedBuffer::TrackedBuffer(EncodeAllocator *allocator, uint8_t maxRefCnt, uint
       m_allocator(allocator)
 {
     m_maxSlotCnt = m_maxRefSlotCnt + m_maxNonRefSlotCnt;
+
+    for (auto &resType : m_resourceTypes)
+    {
+        resType = ResourceType::invalidResource;
+    }
+    for (auto pair : m_mapBufferResourceType)
+    {
+        uint32_t index = GetBufferTypeIndex(pair.buffer);
+        if (index < bufferTypeCount)
+        {
+            m_resourceTypes[index] = pair.type;
+        }
+    }
     for (uint8_t i = 0; i < m_maxSlotCnt; i++)
     {
         m_bufferSlots.push_back(MOS_New(BufferSlot, this));
@@ -53,7 +66,10 @@ TrackedBuffer::~TrackedBuffer()
         (*it)->Reset();
         MOS_Delete(*it);
     }
-    m_bufferQueue.clear();
+    for (auto &queue : m_bufferQueue)
+    {
+        queue = nullptr;
+    }
     m_oldQueue.clear();
 
     MosUtilities::MosDestroyMutex(m_mutex);
@@ -61,18 +77,40 @@ TrackedBuffer::~TrackedBuffer()
 
 MOS_STATUS TrackedBuffer::RegisterParam(BufferType type, MOS_ALLOC_GFXRES_PARAMS param)
 {
-    auto iter = m_allocParams.find(type);
-    if (iter == m_allocParams.end())
+    uint32_t index = GetBufferTypeIndex(type);
+    ENCODE_CHK_COND_RETURN(index >= bufferTypeCount, "Invalid buffer type");
+
+    // overwrite the older param when resultion change happens
+    m_allocParams[index]     = param;
+    m_allocParamValid[index] = true;
+
+    if (m_preallocate && m_bufferQueue[index] == nullptr)
     {
-        m_allocParams.insert(std::make_pair(type, param));
+        ENCODE_CHK_STATUS_RETURN(Preallocate(type));
     }
-    else
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS TrackedBuffer::Preallocate(BufferType type)
+{
+    // Expect the new size to need as many buffers as the latest retired queue of this type
+    uint32_t count = 0;
+    for (auto iter = m_oldQueue.rbegin(); iter != m_oldQueue.rend(); iter++)
     {
-        // erase the older param and insert new one when resultion change happens
-        m_allocParams.erase(iter);
-        m_allocParams.insert(std::make_pair(type, param));
+        if (iter->type == type)
+        {
+            count = iter->queue->GetAllocatedCount();
+            break;
+        }
     }
-    return MOS_STATUS_SUCCESS;
+    if (count == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    std::shared_ptr<BufferQueue> queue = GetBufferQueue(type);
+    ENCODE_CHK_NULL_RETURN(queue);
+    return queue->Preallocate(count);
 }
 
 MOS_STATUS TrackedBuffer::ReleaseUnusedSlots(
@@ -197,46 +235,62 @@ MOS_STATUS TrackedBuffer::Release(CODEC_REF_LIST* refList)
         m_condition.Signal();
     }
 
-    if (!m_oldQueue.empty())
+    DestroyOldQueues();
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS TrackedBuffer::OnSizeChange()
+{
+    m_sizeChangeCount++;
+
+    // Queues of the last two sizes are kept even if idle, so that they can be
+    // taken back if the stream switches back to one of them
+    for (uint32_t index = 0; index < bufferTypeCount; index++)
     {
-        for (auto iter = m_oldQueue.begin(); iter != m_oldQueue.end();)
+        if (m_bufferQueue[index] != nullptr)
         {
-            if (iter->second->SafeToDestory())
-            {
-                iter = m_oldQueue.erase(iter);
-            }
-            else
-            {
-                iter++;
-            }
+            m_oldQueue.push_back({static_cast<BufferType>(index), m_sizeChangeCount, m_bufferQueue[index]});
+            m_bufferQueue[index] = nullptr;
         }
     }
 
+    DestroyOldQueues();
+
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS TrackedBuffer::OnSizeChange()
+void TrackedBuffer::DestroyOldQueues()
 {
-    for (auto iter = m_bufferQueue.begin(); iter != m_bufferQueue.end();)
+    for (auto iter = m_oldQueue.begin(); iter != m_oldQueue.end();)
     {
-        if (iter->second->SafeToDestory())
+        // Queues retired by the previous size change belong to the size a stream
+        // switching back (A->B->A) returns to, keep them until one more change
+        if (iter->sizeChange + 1 < m_sizeChangeCount && iter->queue->SafeToDestory())
         {
-            iter = m_bufferQueue.erase(iter);
+            iter = m_oldQueue.erase(iter);
         }
         else
         {
             iter++;
         }
     }
+}
 
-    if (!m_bufferQueue.empty())
+std::shared_ptr<BufferQueue> TrackedBuffer::ReviveOldQueue(BufferType type)
+{
+    uint32_t index = GetBufferTypeIndex(type);
+
+    for (auto iter = m_oldQueue.begin(); iter != m_oldQueue.end(); iter++)
     {
-        m_oldQueue.insert(std::make_move_iterator(m_bufferQueue.begin()),
-            std::make_move_iterator(m_bufferQueue.end()));
-        m_bufferQueue.clear();
+        if (iter->type == type && iter->queue->IsParamMatched(m_allocParams[index]))
+        {
+            std::shared_ptr<BufferQueue> queue = iter->queue;
+            m_oldQueue.erase(iter);
+            return queue;
+        }
     }
-
-    return MOS_STATUS_SUCCESS;
+    return nullptr;
 }
 
 MOS_SURFACE *TrackedBuffer::GetSurface(BufferType type, uint32_t index)
@@ -264,26 +318,29 @@ MOS_RESOURCE *TrackedBuffer::GetBuffer(BufferType type, uint32_t index)
 
 std::shared_ptr<BufferQueue> TrackedBuffer::GetBufferQueue(BufferType type)
 {
-    auto iter = m_bufferQueue.find(type);
-    if (iter == m_bufferQueue.end())
+    uint32_t index = GetBufferTypeIndex(type);
+    if (index >= bufferTypeCount)
     {
-        auto param = m_allocParams.find(type);
-        if (param == m_allocParams.end())
+        return nullptr;
+    }
+
+    if (m_bufferQueue[index] == nullptr)
+    {
+        if (!m_allocParamValid[index])
         {
             return nullptr;
         }
 
-        ResourceType resType = GetResourceType(type);
-
-        auto alloc = std::make_shared<BufferQueue>(m_allocator, param->second, m_maxSlotCnt);
-        alloc->SetResourceType(resType);
-        m_bufferQueue.insert(std::make_pair(type, alloc));
-        return alloc;
-    }
-    else
-    {
-        return iter->second;
+        auto alloc = ReviveOldQueue(type);
+        if (alloc == nullptr)
+        {
+            alloc = std::make_shared<BufferQueue>(m_allocator, m_allocParams[index], m_maxSlotCnt);
+            alloc->SetResourceType(GetResourceType(type));
+        }
+        m_bufferQueue[index] = alloc;
     }
+
+    return m_bufferQueue[index];
 }
 
-}
\ No newline at end of file
+}
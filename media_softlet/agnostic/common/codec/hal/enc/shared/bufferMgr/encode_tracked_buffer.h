@@ -58,8 +58,19 @@ enum class BufferType
 #include "encode_tracked_buffer_ext.h"
 #undef BUFFER_TYPE_EXT
 #endif
+    bufferTypeNum,  //!< Number of buffer types, must be the last one
 };
 
+//!
+//! \brief  Get array index of buffer type
+//!
+inline uint32_t GetBufferTypeIndex(BufferType type)
+{
+    return static_cast<uint32_t>(type);
+}
+
+static constexpr uint32_t bufferTypeCount = static_cast<uint32_t>(BufferType::bufferTypeNum);
+
 struct MapBufferResourceType
 {
     BufferType   buffer;
@@ -105,6 +116,18 @@ public:
     //!
     MOS_STATUS RegisterParam(BufferType type, MOS_ALLOC_GFXRES_PARAMS param);
 
+    //!
+    //! \brief  Enable predictive preallocation
+    //! \details When a parameter is registered after a size change, the queue
+    //!          for it is created right away and filled with as many buffers as
+    //!          the queue of the same type retired by the size change had, so
+    //!          the frames at the new size do not allocate one by one
+    //! \param  [in] enable
+    //!         true to enable, it is disabled by default
+    //! \return void
+    //!
+    void EnablePreallocation(bool enable) { m_preallocate = enable; }
+
     //!
     //! \brief  Acquire buffer before encoding start for each frame
     //! \param  [in] refList
@@ -171,17 +194,33 @@ protected:
     //!
     ResourceType GetResourceType(BufferType buffer)
     {
-        for (auto pair : m_mapBufferResourceType)
-        {
-            if (pair.buffer == buffer)
-            {
-                return pair.type;
-            }
-        }
-
-        return ResourceType::invalidResource;
+        uint32_t index = GetBufferTypeIndex(buffer);
+        return index < bufferTypeCount ? m_resourceTypes[index] : ResourceType::invalidResource;
     }
 
+    //!
+    //! \brief  Take back a retired queue with the same allocate parameter
+    //! \details Streams switching between a few resolutions get the buffers
+    //!          of the earlier resolution back instead of allocating them again
+    //! \param  [in]type
+    //!         BufferType
+    //! \return shared_ptr<BufferQueue>
+    //!         shared_ptr<BufferQueue> if found, else nullptr
+    std::shared_ptr<BufferQueue> ReviveOldQueue(BufferType type);
+
+    //!
+    //! \brief  Destroy retired queues which are idle and not from the last two size changes
+    //! \return void
+    void DestroyOldQueues();
+
+    //!
+    //! \brief  Allocate the buffers the queue of given type is expected to need
+    //! \param  [in]type
+    //!         BufferType
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    MOS_STATUS Preallocate(BufferType type);
+
     //!
     //! \brief  Reset the unused slots then can use them for other frames
     //! \param  [in]refList
@@ -232,9 +271,24 @@ protected:
     EncodeAllocator *         m_allocator = nullptr;  //!< encoder allocator
     std::vector<BufferSlot *> m_bufferSlots = {};          //!< buffer slots
 
-    std::map<BufferType, MOS_ALLOC_GFXRES_PARAMS>       m_allocParams = {};  //!< allocate parameters
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_bufferQueue = {};  //!< buffer queues
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_oldQueue = {};     //!< old queues for resolution change
+    //!
+    //! \struct OldQueue
+    //! \brief  Queue retired by resolution change
+    //!
+    struct OldQueue
+    {
+        BufferType                   type;        //!< Buffer type of the queue
+        uint32_t                     sizeChange;  //!< m_sizeChangeCount when retired
+        std::shared_ptr<BufferQueue> queue;       //!< Retired queue
+    };
+
+    ResourceType                 m_resourceTypes[bufferTypeCount]   = {};  //!< resource type of each buffer type
+    MOS_ALLOC_GFXRES_PARAMS      m_allocParams[bufferTypeCount]     = {};  //!< allocate parameters
+    bool                         m_allocParamValid[bufferTypeCount] = {};  //!< whether allocate parameter registered
+    std::shared_ptr<BufferQueue> m_bufferQueue[bufferTypeCount]     = {};  //!< buffer queues
+    std::vector<OldQueue>        m_oldQueue                         = {};  //!< old queues for resolution change
+    uint32_t                     m_sizeChangeCount                  = 0;   //!< number of OnSizeChange calls
+    bool                         m_preallocate                      = false;  //!< predictive preallocation enabled
 
 MEDIA_CLASS_DEFINE_END(TrackedBuffer)
 };
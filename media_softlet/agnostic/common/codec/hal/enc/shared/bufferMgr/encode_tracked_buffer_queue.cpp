@@ -107,6 +107,29 @@ bool BufferQueue::SafeToDestory()
     return m_resourcePool.size() == m_resources.size();
 }
 
+uint32_t BufferQueue::GetAllocatedCount()
+{
+    AutoLock lock(m_mutex);
+
+    return m_allocCount;
+}
+
+MOS_STATUS BufferQueue::Preallocate(uint32_t count)
+{
+    AutoLock lock(m_mutex);
+
+    count = MOS_MIN(count, m_maxCount);
+    while (m_allocCount < count)
+    {
+        void *resource = AllocateResource();
+        ENCODE_CHK_NULL_RETURN(resource);
+        m_allocCount++;
+        m_resources.push_back(resource);
+        m_resourcePool.push_back(resource);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
 
 void *BufferQueue::AllocateResource()
 {
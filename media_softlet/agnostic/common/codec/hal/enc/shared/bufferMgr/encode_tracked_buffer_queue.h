@@ -83,8 +83,36 @@ public:
     //!
     bool SafeToDestory();
 
+    //!
+    //! \brief  Get the number of buffers allocated by the queue
+    //! \return uint32_t
+    //!         allocated buffer count
+    //!
+    uint32_t GetAllocatedCount();
+
+    //!
+    //! \brief  Allocate buffers to the pool ahead of the first acquire
+    //! \param  [in] count
+    //!         number of buffers the queue should own, limited by max count
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Preallocate(uint32_t count);
+
     void SetResourceType(ResourceType resType) { m_resourceType = resType; }
 
+    //!
+    //! \brief  Check whether the queue allocates with the given parameter
+    //! \param  [in] param
+    //!         reference to MOS_ALLOC_GFXRES_PARAMS
+    //! \return bool
+    //!         true if the parameter is the same as the one of the queue
+    //!
+    bool IsParamMatched(const MOS_ALLOC_GFXRES_PARAMS &param) const
+    {
+        return memcmp(&m_allocParam, &param, sizeof(param)) == 0;
+    }
+
 protected:
     //!
     //! \brief  Allocate resource
@@ -36,25 +36,28 @@ BufferSlot::BufferSlot(TrackedBuffer* tracker) :
 
 BufferSlot::~BufferSlot()
 {
-    for (auto iter = m_buffers.begin(); iter != m_buffers.end(); iter++)
+    ReleaseBuffers();
+}
+
+void BufferSlot::ReleaseBuffers()
+{
+    for (uint32_t i = 0; i < m_usedTypeNum; i++)
     {
-        std::shared_ptr<BufferQueue> queue = m_bufferQueues[iter->first];
-        queue->ReleaseResource(iter->second);
+        uint32_t index = m_usedTypes[i];
+        if (m_bufferQueues[index] != nullptr)
+        {
+            m_bufferQueues[index]->ReleaseResource(m_buffers[index]);
+        }
+        m_buffers[index]      = nullptr;
+        m_bufferQueues[index] = nullptr;
     }
-    m_buffers.clear();
-    m_bufferQueues.clear();
+    m_usedTypeNum = 0;
 }
 
 MOS_STATUS BufferSlot::Reset()
 {
     m_isBusy = false;
-    for (auto iter = m_buffers.begin(); iter != m_buffers.end(); iter++)
-    {
-        std::shared_ptr<BufferQueue> queue = m_bufferQueues[iter->first];
-        queue->ReleaseResource(iter->second);
-    }
-    m_buffers.clear();
-    m_bufferQueues.clear();
+    ReleaseBuffers();
 
     return MOS_STATUS_SUCCESS;
 }
@@ -67,11 +70,16 @@ void *BufferSlot::GetResource(BufferType type)
         return nullptr;
     }
 
+    uint32_t index = GetBufferTypeIndex(type);
+    if (index >= bufferTypeCount)
+    {
+        return nullptr;
+    }
+
     // if surface already in the pool, return it directly
-    auto iter = m_buffers.find(type);
-    if (iter != m_buffers.end())
+    if (m_bufferQueues[index] != nullptr)
     {
-        return iter->second;
+        return m_buffers[index];
     }
 
     std::shared_ptr<BufferQueue> queue = m_tracker->GetBufferQueue(type);
@@ -82,9 +90,9 @@ void *BufferSlot::GetResource(BufferType type)
 
     void* resource = queue->AcquireResource();
     // record the surface acquired, only one surface for each type should be kept in the slot
-    m_buffers.insert(std::make_pair(type, resource));
-    m_bufferQueues.insert(std::make_pair(type, queue));
+    m_buffers[index]              = resource;
+    m_bufferQueues[index]         = queue;
+    m_usedTypes[m_usedTypeNum++]  = index;
     return resource;
 }
-
-}
\ No newline at end of file
+}
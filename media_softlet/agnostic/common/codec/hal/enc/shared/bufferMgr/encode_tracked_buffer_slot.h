@@ -97,13 +97,22 @@ public:
     //!
     void *GetResource(BufferType type);
 
+protected:
+    //!
+    //! \brief  Return all buffers to the queues they are from
+    //! \return void
+    //!
+    void ReleaseBuffers();
+
 protected:
     uint8_t        m_frameIndex = 0;       //!< frame index associated with current slot
     TrackedBuffer *m_tracker  = nullptr;   //!< pointer to TrackedBuffer
     bool           m_isBusy   = false;     //!< whether the slot is been using
 
-    std::map<BufferType, void *>                        m_buffers      = {};  //!< buffers attached with current slot
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_bufferQueues = {};  //!< buffer queue for all types
+    void                        *m_buffers[bufferTypeCount]      = {};  //!< buffers attached with current slot
+    std::shared_ptr<BufferQueue> m_bufferQueues[bufferTypeCount] = {};  //!< buffer queue for all types
+    uint32_t                     m_usedTypes[bufferTypeCount]    = {};  //!< indices of types attached
+    uint32_t                     m_usedTypeNum                   = 0;   //!< number of types attached
 
 MEDIA_CLASS_DEFINE_END(BufferSlot)
 };
@@ -71,6 +71,14 @@ MOS_STATUS EncodePipeline::Initialize(void *settings)
     m_trackedBuf = MOS_New(TrackedBuffer, m_allocator, (uint8_t)CODEC_NUM_REF_BUFFERS, (uint8_t)CODEC_NUM_NON_REF_BUFFERS);
     ENCODE_CHK_NULL_RETURN(m_trackedBuf);
 
+    MediaUserSetting::Value outValue;
+    ReadUserSetting(
+        m_userSettingPtr,
+        outValue,
+        "Encode Tracked Buffer Preallocation",
+        MediaUserSetting::Group::Sequence);
+    m_trackedBuf->EnablePreallocation(outValue.Get<bool>());
+
     m_recycleBuf = MOS_New(RecycleResource, m_allocator);
     ENCODE_CHK_NULL_RETURN(m_recycleBuf);
 
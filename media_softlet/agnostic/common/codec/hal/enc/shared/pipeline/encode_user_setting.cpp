@@ -69,6 +69,12 @@ MOS_STATUS EncodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         MediaUserSetting::Group::Sequence,
         int32_t(0),
         true);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Tracked Buffer Preallocation",
+        MediaUserSetting::Group::Sequence,
+        false,
+        false);
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
@@ -29,6 +29,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_cmdbufmgr_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_commandbuffer_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_user_setting.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_cpu_profiler.cpp
 )
 
 set(TMP_HEADERS_
@@ -44,6 +45,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_interface_next.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_interface.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_user_setting.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_cpu_profiler.h
 )
 
 set(SOURCES_
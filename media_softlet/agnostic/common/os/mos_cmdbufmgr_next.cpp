@@ -30,7 +30,11 @@ CmdBufMgrNext::CmdBufMgrNext()
 {
     MOS_OS_FUNCTION_ENTER;
 
-    m_availableCmdBufPool.clear();
+    for (auto &sizeClass : m_sizeClasses)
+    {
+        sizeClass.retired.clear();
+        sizeClass.pending.clear();
+    }
     m_inUseCmdBufPool.clear();
     m_initialized = false;
 }
@@ -56,6 +60,9 @@ MOS_STATUS CmdBufMgrNext::Initialize(OsContextNext *osContext, uint32_t cmdBufSi
     if (!m_initialized)
     {
         m_osContext          = osContext;
+        m_baseSize           = MOS_MAX(cmdBufSize, 1u);
+        m_availableNum       = 0;
+        MosUtilities::MosZeroMemory(&m_stats, sizeof(m_stats));
 
         m_inUsePoolMutex     = MosUtilities::MosCreateMutex();
         MOS_OS_CHK_NULL_RETURN(m_inUsePoolMutex);
@@ -82,7 +89,7 @@ MOS_STATUS CmdBufMgrNext::Initialize(OsContextNext *osContext, uint32_t cmdBufSi
             }
 
             MosUtilities::MosLockMutex(m_availablePoolMutex);
-            m_availableCmdBufPool.push_back(cmdBuf);
+            UpperInsert(cmdBuf);
             MosUtilities::MosUnlockMutex(m_availablePoolMutex);
 
             m_cmdBufTotalNum++;
@@ -98,7 +105,6 @@ MOS_STATUS CmdBufMgrNext::Reset()
 {
     MOS_OS_FUNCTION_ENTER;
 
-    CommandBufferNext *cmdBuf = nullptr;
     auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
     MOS_OS_CHK_NULL_RETURN(gpuContextMgr);
 
@@ -118,34 +124,40 @@ MOS_STATUS CmdBufMgrNext::Reset()
     m_inUseCmdBufPool.clear();
     MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
 
-    for (auto& cmdBuf : m_availableCmdBufPool)
+    for (auto &sizeClass : m_sizeClasses)
     {
-        if (cmdBuf != nullptr)
+        for (auto queue : {&sizeClass.retired, &sizeClass.pending})
         {
-            auto nativeGpuContext         = cmdBuf->GetLastNativeGpuContext();
-            auto nativeGpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
-            if (nativeGpuContext != nullptr && nativeGpuContext == gpuContextMgr->GetGpuContext(nativeGpuContextHandle))
+            for (auto &cmdBuf : *queue)
             {
-                cmdBuf->UnBindToGpuContext(true);
-                nativeGpuContext->ResetCmdBuffer();
-            }
-            cmdBuf->ResetLastNativeGpuContext();
-
-            auto gpuContext         = cmdBuf->GetGpuContext();
-            auto gpuContextHandle   = cmdBuf->GetGpuContextHandle();
-            if (gpuContext != nullptr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
-            {
-                cmdBuf->UnBindToGpuContext(false);
-                gpuContext->ResetCmdBuffer();
+                if (cmdBuf != nullptr)
+                {
+                    auto nativeGpuContext         = cmdBuf->GetLastNativeGpuContext();
+                    auto nativeGpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
+                    if (nativeGpuContext != nullptr && nativeGpuContext == gpuContextMgr->GetGpuContext(nativeGpuContextHandle))
+                    {
+                        cmdBuf->UnBindToGpuContext(true);
+                        nativeGpuContext->ResetCmdBuffer();
+                    }
+                    cmdBuf->ResetLastNativeGpuContext();
+
+                    auto gpuContext         = cmdBuf->GetGpuContext();
+                    auto gpuContextHandle   = cmdBuf->GetGpuContextHandle();
+                    if (gpuContext != nullptr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
+                    {
+                        cmdBuf->UnBindToGpuContext(false);
+                        gpuContext->ResetCmdBuffer();
+                    }
+                    cmdBuf->ResetGpuContext();
+                }
+                else
+                {
+                    MOS_OS_ASSERTMESSAGE("Unexpected, found null command buffer!");
+                }
             }
-            cmdBuf->ResetGpuContext();
-        }
-        else
-        {
-            MOS_OS_ASSERTMESSAGE("Unexpected, found null command buffer!");
         }
     }
-    m_cmdBufTotalNum = m_availableCmdBufPool.size();
+    m_cmdBufTotalNum = m_availableNum;
     MosUtilities::MosUnlockMutex(m_availablePoolMutex);
     return MOS_STATUS_SUCCESS;
 }
@@ -154,31 +166,44 @@ void CmdBufMgrNext::CleanUp()
 {
     MOS_OS_FUNCTION_ENTER;
 
-    CommandBufferNext *cmdBuf = nullptr;
     MosUtilities::MosLockMutex(m_availablePoolMutex);
 
-    for (auto& cmdBuf : m_availableCmdBufPool)
+    for (auto &sizeClass : m_sizeClasses)
     {
-        if (cmdBuf != nullptr)
+        for (auto queue : {&sizeClass.retired, &sizeClass.pending})
         {
-            auto gpuContext         = cmdBuf->GetLastNativeGpuContext();
-            auto gpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
-            auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
-            if (gpuContext != nullptr && gpuContextMgr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
+            for (auto &cmdBuf : *queue)
             {
-                cmdBuf->UnBindToGpuContext(true);
+                if (cmdBuf != nullptr)
+                {
+                    auto gpuContext         = cmdBuf->GetLastNativeGpuContext();
+                    auto gpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
+                    auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
+                    if (gpuContext != nullptr && gpuContextMgr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
+                    {
+                        cmdBuf->UnBindToGpuContext(true);
+                    }
+                    cmdBuf->Free();
+                    MOS_Delete(cmdBuf);
+                }
+                else
+                {
+                    MOS_OS_ASSERTMESSAGE("Unexpected, found null command buffer!");
+                }
             }
-            cmdBuf->Free();
-            MOS_Delete(cmdBuf);
-        }
-        else
-        {
-            MOS_OS_ASSERTMESSAGE("Unexpected, found null command buffer!");
+            // clear available command buffer pool
+            queue->clear();
         }
     }
+    m_availableNum = 0;
+
+    MOS_OS_NORMALMESSAGE("Cmd buf pool: %llu pickups, %llu hits, %llu pending skips, %llu allocations of %llu bytes",
+        (unsigned long long)m_stats.pickupCount,
+        (unsigned long long)m_stats.hitCount,
+        (unsigned long long)m_stats.pendingSkipCount,
+        (unsigned long long)m_stats.allocCount,
+        (unsigned long long)m_stats.allocBytes);
 
-    // clear available command buffer pool
-    m_availableCmdBufPool.clear();
     MosUtilities::MosUnlockMutex(m_availablePoolMutex);
     MosUtilities::MosLockMutex(m_inUsePoolMutex);
 
@@ -206,6 +231,83 @@ void CmdBufMgrNext::CleanUp()
     m_availablePoolMutex = nullptr;
 }
 
+uint32_t CmdBufMgrNext::GetSizeClass(uint32_t size)
+{
+    uint32_t sizeClass = 0;
+    while (sizeClass < m_sizeClassNum - 1 && ((uint64_t)m_baseSize << (sizeClass + 1)) <= size)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+CommandBufferNext *CmdBufMgrNext::PopReadyCmdBuf(uint32_t sizeClass, uint32_t size)
+{
+    auto &retired = m_sizeClasses[sizeClass].retired;
+    auto &pending = m_sizeClasses[sizeClass].pending;
+
+    // move the command buffers retired by HW back to the retired queue
+    for (size_t i = 0; i < pending.size();)
+    {
+        if (!pending[i]->IsUsedByHw() && !pending[i]->IsInCmdList())
+        {
+            retired.push_back(pending[i]);
+            pending[i] = pending.back();
+            pending.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // most recently released first, only the lowest visited class may hold smaller buffers
+    for (size_t i = retired.size(); i > 0; i--)
+    {
+        CommandBufferNext *cmdBuf = retired[i - 1];
+        if (cmdBuf->GetCmdBufSize() < size)
+        {
+            continue;
+        }
+
+        retired[i - 1] = retired.back();
+        retired.pop_back();
+
+        if (cmdBuf->IsUsedByHw() || cmdBuf->IsInCmdList())
+        {
+            pending.push_back(cmdBuf);
+            m_stats.pendingSkipCount++;
+            continue;
+        }
+        return cmdBuf;
+    }
+
+    return nullptr;
+}
+
+CommandBufferNext *CmdBufMgrNext::AllocateCmdBuf(uint32_t size)
+{
+    auto cmdBuf = CommandBufferNext::CreateCmdBuf(this);
+    if (cmdBuf == nullptr)
+    {
+        MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
+        return nullptr;
+    }
+
+    if (cmdBuf->Allocate(m_osContext, size) != MOS_STATUS_SUCCESS)
+    {
+        MOS_OS_ASSERTMESSAGE("Allocate CmdBuf failed");
+        cmdBuf->Free();
+        MOS_Delete(cmdBuf);
+        return nullptr;
+    }
+
+    m_cmdBufTotalNum++;
+    m_stats.allocCount++;
+    m_stats.allocBytes += size;
+    return cmdBuf;
+}
+
 CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
 {
     MOS_OS_FUNCTION_ENTER;
@@ -220,56 +322,37 @@ CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
     MosUtilities::MosLockMutex(m_inUsePoolMutex);
     MosUtilities::MosLockMutex(m_availablePoolMutex);
 
-    CommandBufferNext* cmdBuf = nullptr;
     CommandBufferNext* retbuf  = nullptr;
-    MOS_STATUS     eStatus = MOS_STATUS_SUCCESS;
 
-    if (!m_availableCmdBufPool.empty())
+    m_stats.pickupCount++;
+
+    if (m_availableNum > 0)
     {
-        cmdBuf = *(m_availableCmdBufPool.begin());
-        if (cmdBuf == nullptr)
+        for (uint32_t sizeClass = GetSizeClass(size); sizeClass < m_sizeClassNum && retbuf == nullptr; sizeClass++)
         {
-            MOS_OS_ASSERTMESSAGE("available command buf pool is null.");
-            MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
-            MosUtilities::MosUnlockMutex(m_availablePoolMutex);
-            return nullptr;
+            retbuf = PopReadyCmdBuf(sizeClass, size);
         }
 
-        // find available buf
-        if (size <= cmdBuf->GetCmdBufSize() && !cmdBuf->IsUsedByHw() && !cmdBuf->IsInCmdList())
+        if (retbuf != nullptr)
         {
-            m_inUseCmdBufPool.push_back(cmdBuf);
-
-            m_availableCmdBufPool.erase(m_availableCmdBufPool.begin());
+            m_availableNum--;
+            m_stats.hitCount++;
+            m_inUseCmdBufPool.push_back(retbuf);
 
             MOS_OS_VERBOSEMESSAGE("successfully get available buf from pool");
         }
-        // available buf  is not large enough, need reallocate
+        // no available buf large enough or all are used by HW, need reallocate
         else
         {
             MOS_OS_VERBOSEMESSAGE("find available buf, but is not large enough or it is still used by HW");
 
-            cmdBuf = CommandBufferNext::CreateCmdBuf(this);
-            if (cmdBuf == nullptr)
-            {
-                MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
-            }
-            else
+            retbuf = AllocateCmdBuf(size);
+            if (retbuf != nullptr)
             {
-                eStatus = cmdBuf->Allocate(m_osContext, size);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    MOS_OS_ASSERTMESSAGE("Allocate CmdBuf failed");
-                }
-
                 // directly push into inuse pool
-                m_inUseCmdBufPool.push_back(cmdBuf);
-                m_cmdBufTotalNum++;
-
+                m_inUseCmdBufPool.push_back(retbuf);
             }
         }
-
-        retbuf = cmdBuf;
     }
     // no available buf in the pool, will allocate in batch
     else
@@ -281,23 +364,13 @@ CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
             MOS_OS_VERBOSEMESSAGE("Increase the cmd buf pool size by %d", m_bufIncStepSize);
             for (uint32_t i = 0; i < m_bufIncStepSize; i++)
             {
-                cmdBuf = CommandBufferNext::CreateCmdBuf(this);
+                auto cmdBuf = AllocateCmdBuf(size);
                 if (cmdBuf == nullptr)
                 {
-                    MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
                     continue;
                 }
 
-                eStatus = cmdBuf->Allocate(m_osContext, size);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    MOS_OS_ASSERTMESSAGE("Allocate CmdBuf#%d failed", i);
-                    cmdBuf->Free();
-                    MOS_Delete(cmdBuf);
-                    continue;
-                }
-
-                if (i == 0)
+                if (retbuf == nullptr)
                 {
                     // directly push into inuse pool
                     m_inUseCmdBufPool.push_back(cmdBuf);
@@ -305,13 +378,9 @@ CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
                 }
                 else
                 {
-                    m_availableCmdBufPool.insert(m_availableCmdBufPool.begin(), cmdBuf);
+                    UpperInsert(cmdBuf);
                 }
-                m_cmdBufTotalNum++;
             }
-
-            // sort by decent order
-            std::sort(m_availableCmdBufPool.begin(), m_availableCmdBufPool.end(), &CmdBufMgrNext::GreaterSizeSort);
         }
         else
         {
@@ -329,8 +398,16 @@ CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
 
 void CmdBufMgrNext::UpperInsert(CommandBufferNext *cmdBuf)
 {
-    auto it = std::find_if(m_availableCmdBufPool.begin(), m_availableCmdBufPool.end(), [=](CommandBufferNext * p1){return p1->GetCmdBufSize() < cmdBuf->GetCmdBufSize();});
-    m_availableCmdBufPool.emplace(it, cmdBuf);
+    auto &sizeClass = m_sizeClasses[GetSizeClass(cmdBuf->GetCmdBufSize())];
+    if (cmdBuf->IsUsedByHw() || cmdBuf->IsInCmdList())
+    {
+        sizeClass.pending.push_back(cmdBuf);
+    }
+    else
+    {
+        sizeClass.retired.push_back(cmdBuf);
+    }
+    m_availableNum++;
 }
 
 MOS_STATUS CmdBufMgrNext::ReleaseCmdBuf(CommandBufferNext *cmdBuf)
@@ -351,24 +428,16 @@ MOS_STATUS CmdBufMgrNext::ReleaseCmdBuf(CommandBufferNext *cmdBuf)
     MosUtilities::MosLockMutex(m_inUsePoolMutex);
     MosUtilities::MosLockMutex(m_availablePoolMutex);
 
-    bool           found = false;
-    for (auto iter = m_inUseCmdBufPool.begin(); iter != m_inUseCmdBufPool.end(); iter++)
-    {
-        if (cmdBuf == *iter)
-        {
-            found = true;
-            m_inUseCmdBufPool.erase(iter);
-            break;
-        }
-    }
-
-    if (!found)
+    auto iter = std::find(m_inUseCmdBufPool.begin(), m_inUseCmdBufPool.end(), cmdBuf);
+    if (iter == m_inUseCmdBufPool.end())
     {
         MOS_OS_ASSERTMESSAGE("Cannot find the specified cmdbuf in inusepool, sth must be wrong!");
         eStatus = MOS_STATUS_UNKNOWN;
     }
     else
     {
+        *iter = m_inUseCmdBufPool.back();
+        m_inUseCmdBufPool.pop_back();
         UpperInsert(cmdBuf);
     }
 
@@ -394,8 +463,15 @@ MOS_STATUS CmdBufMgrNext::ResizeOneCmdBuf(CommandBufferNext *cmdBufToResize, uin
     return cmdBufToResize->ReSize(newSize);
 }
 
-
-bool CmdBufMgrNext::GreaterSizeSort(CommandBufferNext *a, CommandBufferNext *b)
+void CmdBufMgrNext::GetPoolStatistics(PoolStatistics &stats)
 {
-    return (a->GetCmdBufSize() > b->GetCmdBufSize());
-}
\ No newline at end of file
+    if (m_availablePoolMutex == nullptr)
+    {
+        stats = m_stats;
+        return;
+    }
+
+    MosUtilities::MosLockMutex(m_availablePoolMutex);
+    stats = m_stats;
+    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+}
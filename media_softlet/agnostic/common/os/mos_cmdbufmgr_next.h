@@ -36,6 +36,18 @@
 class CmdBufMgrNext
 {
 public:
+    //!
+    //! \brief  Command buffer pool statistics
+    //!
+    struct PoolStatistics
+    {
+        uint64_t pickupCount;       //!< Number of PickupOneCmdBuf calls
+        uint64_t hitCount;          //!< Pickups served by a pooled command buffer
+        uint64_t pendingSkipCount;  //!< Pooled command buffers skipped as still used by HW
+        uint64_t allocCount;        //!< Command buffers allocated after initialization
+        uint64_t allocBytes;        //!< Bytes of command buffers allocated after initialization
+    };
+
     //!
     //! \brief  Constructor
     //!
@@ -73,16 +85,18 @@ public:
     void CleanUp();
 
     //!
-    //! \brief    Clean up the command buffer manager
-    //! \details  This function will pick up one proper command buffer from 
+    //! \brief    Pick up one command buffer
+    //! \details  This function will pick up one proper command buffer from
     //!           available pool, internal logic in below 3 conditions:
-    //!           1: if available pool has command buffer and its size bigger than
-    //!              required, directly put it into in use pool and return;
-    //!           2: if available pool has command buffer but size smaller than
-    //!              required, only create one command buffer as reqired and put
-    //!              it to in  use pool directly;
+    //!           1: starting from the size class of the required size, the first
+    //!              retired command buffer not used by HW and large enough is
+    //!              moved to in use pool and returned. Buffers found still used
+    //!              by HW are parked in the pending queue of their size class;
+    //!           2: if available pool has command buffer but none is ready and
+    //!              large enough, only create one command buffer as reqired and
+    //!              put it to in use pool directly;
     //!           3: if available pool is empty, will re-allocate bunch of command
-    //!              buffers, buffer number base on m_initBufNum, buffer size
+    //!              buffers, buffer number base on m_bufIncStepSize, buffer size
     //!              base on input required size. After re-allocate, put first buf
     //!              into inuse pool, remains push to available pool.
     //! \param    [in] size
@@ -94,8 +108,9 @@ public:
 
     //!
     //! \brief    insert the command buffer into available pool in proper location.
-    //! \details  This function will find a the first cmd buffer which equal or  
-    //!           small cmd buf size in available pool, and then insert it.
+    //! \details  The command buffer is pushed to the retired queue of its size
+    //!           class, or to the pending queue if it is still used by HW.
+    //!           Caller must hold m_availablePoolMutex.
     //! \param    [in] cmdBuf
     //!           command buffer to be released
     //!
@@ -167,18 +182,54 @@ public:
         return m_handle;
     }
 
+    //!
+    //! \brief    Get the pool hit rate and allocation statistics
+    //! \param    [out] stats
+    //!           Statistics of this command buffer manager
+    //!
+    void GetPoolStatistics(PoolStatistics &stats);
+
  protected:
     //!
-    //! \brief    Self define compare method as std:sort input 
-    //! \detail   Command buffer size will be compared 
-    //! \param    [in] a
-    //!           Input command buffer to be compared
-    //! \param    [in] b
-    //!           Input command buffer to be compared
-    //! \return   bool
-    //!           true if a size bigger than b, otherwise false
+    //! \brief   Command buffers of one size class
+    //!
+    struct SizeClass
+    {
+        std::vector<CommandBufferNext *> retired;   //!< Idle command buffers which can be picked up
+        std::vector<CommandBufferNext *> pending;   //!< Released command buffers still used by HW
+    };
+
+    //!
+    //! \brief    Get the size class of a command buffer size
+    //! \details  Class k holds buffers of at least m_baseSize << k bytes
+    //! \param    [in] size
+    //!           Command buffer size
+    //! \return   uint32_t
+    //!           Size class index
     //!
-    static bool GreaterSizeSort(CommandBufferNext *a, CommandBufferNext *b);
+    uint32_t GetSizeClass(uint32_t size);
+
+    //!
+    //! \brief    Pop one ready command buffer of at least size bytes from a size class
+    //! \details  Pending command buffers retired by HW are moved back to the
+    //!           retired queue first. Caller must hold m_availablePoolMutex.
+    //! \param    [in] sizeClass
+    //!           Size class index
+    //! \param    [in] size
+    //!           Required command buffer size
+    //! \return   CommandBufferNext*
+    //!           Command buffer if found, otherwise nullptr
+    //!
+    CommandBufferNext *PopReadyCmdBuf(uint32_t sizeClass, uint32_t size);
+
+    //!
+    //! \brief    Create and allocate one command buffer
+    //! \param    [in] size
+    //!           Command buffer size
+    //! \return   CommandBufferNext*
+    //!           Command buffer if success, otherwise nullptr
+    //!
+    CommandBufferNext *AllocateCmdBuf(uint32_t size);
 
     //! \brief   Max comamnd buffer number for per manager, including all
     //!          command buffer in availble pool and in-use pool
@@ -193,8 +244,20 @@ public:
     //! \brief   Initial command buffer number
     constexpr static uint32_t m_initBufNum = 32;
 
-    //! \brief   Sorted List of available command buffer pool
-    std::vector<CommandBufferNext *> m_availableCmdBufPool;
+    //! \brief   Number of command buffer size classes
+    constexpr static uint32_t m_sizeClassNum = 8;
+
+    //! \brief   Available command buffer pool segregated by size class
+    SizeClass m_sizeClasses[m_sizeClassNum];
+
+    //! \brief   Minimum size of size class 0, the initial command buffer size
+    uint32_t m_baseSize = 0;
+
+    //! \brief   Command buffer number in available pool, retired and pending
+    uint32_t m_availableNum = 0;
+
+    //! \brief   Pool hit rate and allocation statistics
+    PoolStatistics m_stats = {};
 
     //! \brief   Mutex for available command buffer pool
     PMOS_MUTEX m_availablePoolMutex = nullptr;
@@ -0,0 +1,254 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_cpu_profiler.cpp
+//! \brief    Scoped CPU timers aggregated into per stage histograms.
+//!
+
+#include "mos_cpu_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <mutex>
+
+static const char *s_stageNames[MOS_CPU_PROFILE_STAGE_NUM] =
+{
+    "DdiRenderPicture",
+    "DdiEndPicture",
+    "PipelinePrepare",
+    "PipelineExecute",
+    "PacketSubmit",
+    "MosSubmitCommandBuffer",
+    "KmdExec",
+    "ResourceLock",
+};
+
+static const char *s_counterNames[MOS_CPU_PROFILE_COUNTER_NUM] =
+{
+    "LockMap",
+    "LockBusyCheck",
+    "LockWait",
+};
+
+const char                    *MosCpuProfiler::m_outputFile = getenv("GFX_MEDIA_CPU_PROFILE");
+bool                           MosCpuProfiler::m_enabled    = (MosCpuProfiler::m_outputFile != nullptr);
+MosCpuProfiler::StageCounters  MosCpuProfiler::m_stages[MOS_CPU_PROFILE_STAGE_NUM];
+std::atomic<uint64_t>          MosCpuProfiler::m_counters[MOS_CPU_PROFILE_COUNTER_NUM];
+
+void MosCpuProfiler::Record(MOS_CPU_PROFILE_STAGE stage, uint64_t ns)
+{
+    if (stage >= MOS_CPU_PROFILE_STAGE_NUM)
+    {
+        return;
+    }
+    StageCounters &counters = m_stages[stage];
+
+    uint64_t us     = ns / 1000;
+    uint32_t bucket = 0;
+    while (us > 1 && bucket < m_bucketNum - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+
+    counters.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    counters.totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+    // min is stored as ns + 1 so that zero means no sample
+    uint64_t minNs = counters.minNs.load(std::memory_order_relaxed);
+    while ((minNs == 0 || ns + 1 < minNs) &&
+           !counters.minNs.compare_exchange_weak(minNs, ns + 1, std::memory_order_relaxed))
+    {
+    }
+    uint64_t maxNs = counters.maxNs.load(std::memory_order_relaxed);
+    while (ns > maxNs &&
+           !counters.maxNs.compare_exchange_weak(maxNs, ns, std::memory_order_relaxed))
+    {
+    }
+    counters.count.fetch_add(1, std::memory_order_release);
+}
+
+MOS_STATUS MosCpuProfiler::GetHistogram(MOS_CPU_PROFILE_STAGE stage, Histogram &histogram)
+{
+    if (stage >= MOS_CPU_PROFILE_STAGE_NUM)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    StageCounters &counters = m_stages[stage];
+
+    histogram.count   = counters.count.load(std::memory_order_acquire);
+    histogram.totalNs = counters.totalNs.load(std::memory_order_relaxed);
+    uint64_t minNs    = counters.minNs.load(std::memory_order_relaxed);
+    histogram.minNs   = minNs ? minNs - 1 : 0;
+    histogram.maxNs   = counters.maxNs.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < m_bucketNum; i++)
+    {
+        histogram.buckets[i] = counters.buckets[i].load(std::memory_order_relaxed);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+const char *MosCpuProfiler::GetStageName(MOS_CPU_PROFILE_STAGE stage)
+{
+    return (stage < MOS_CPU_PROFILE_STAGE_NUM) ? s_stageNames[stage] : "Unknown";
+}
+
+void MosCpuProfiler::Reset()
+{
+    for (auto &counters : m_stages)
+    {
+        counters.count.store(0, std::memory_order_relaxed);
+        counters.totalNs.store(0, std::memory_order_relaxed);
+        counters.minNs.store(0, std::memory_order_relaxed);
+        counters.maxNs.store(0, std::memory_order_relaxed);
+        for (auto &bucket : counters.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto &counter : m_counters)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void MosCpuProfiler::TakeSnapshot(Snapshot &snapshot)
+{
+    for (uint32_t stage = 0; stage < MOS_CPU_PROFILE_STAGE_NUM; stage++)
+    {
+        GetHistogram((MOS_CPU_PROFILE_STAGE)stage, snapshot.stages[stage]);
+    }
+    for (uint32_t counter = 0; counter < MOS_CPU_PROFILE_COUNTER_NUM; counter++)
+    {
+        snapshot.counters[counter] = GetCounter((MOS_CPU_PROFILE_COUNTER)counter);
+    }
+}
+
+std::mutex                                     MosCpuProfiler::m_intervalMutex;
+std::map<const void *, MosCpuProfiler::Snapshot> MosCpuProfiler::m_intervals;
+
+void MosCpuProfiler::BeginInterval(const void *key)
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    Snapshot snapshot = {};
+    TakeSnapshot(snapshot);
+
+    std::lock_guard<std::mutex> lock(m_intervalMutex);
+    m_intervals[key] = snapshot;
+}
+
+void MosCpuProfiler::DumpInterval(const void *key, const char *tag)
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    Snapshot snapshot = {};
+    bool     found    = false;
+    {
+        std::lock_guard<std::mutex> lock(m_intervalMutex);
+        auto it = m_intervals.find(key);
+        if (it != m_intervals.end())
+        {
+            snapshot = it->second;
+            found    = true;
+            m_intervals.erase(it);
+        }
+    }
+    DumpSince(tag, found ? &snapshot : nullptr);
+}
+
+void MosCpuProfiler::Dump(const char *tag)
+{
+    DumpSince(tag, nullptr);
+}
+
+void MosCpuProfiler::DumpSince(const char *tag, const Snapshot *base)
+{
+    if (!m_enabled || m_outputFile == nullptr)
+    {
+        return;
+    }
+
+    static std::mutex dumpMutex;
+    std::lock_guard<std::mutex> lock(dumpMutex);
+
+    FILE *fp = fopen(m_outputFile, "a");
+    if (fp == nullptr)
+    {
+        return;
+    }
+
+    fprintf(fp, "==== CPU profile: %s%s ====\n", tag ? tag : "", base ? " (min/max process wide)" : "");
+    fprintf(fp, "%-24s %10s %12s %12s %12s  histogram(us: count)\n", "stage", "count", "avg(us)", "min(us)", "max(us)");
+    for (uint32_t stage = 0; stage < MOS_CPU_PROFILE_STAGE_NUM; stage++)
+    {
+        Histogram histogram = {};
+        GetHistogram((MOS_CPU_PROFILE_STAGE)stage, histogram);
+        if (base)
+        {
+            // samples recorded meanwhile may be partly counted, clamp rather than wrap
+            const Histogram &since = base->stages[stage];
+            histogram.count   = (histogram.count > since.count) ? histogram.count - since.count : 0;
+            histogram.totalNs = (histogram.totalNs > since.totalNs) ? histogram.totalNs - since.totalNs : 0;
+            for (uint32_t i = 0; i < m_bucketNum; i++)
+            {
+                histogram.buckets[i] = (histogram.buckets[i] > since.buckets[i]) ? histogram.buckets[i] - since.buckets[i] : 0;
+            }
+        }
+        if (histogram.count == 0)
+        {
+            continue;
+        }
+        fprintf(fp, "%-24s %10llu %12.1f %12.1f %12.1f ",
+            s_stageNames[stage],
+            (unsigned long long)histogram.count,
+            histogram.totalNs / 1000.0 / histogram.count,
+            histogram.minNs / 1000.0,
+            histogram.maxNs / 1000.0);
+        for (uint32_t i = 0; i < m_bucketNum; i++)
+        {
+            if (histogram.buckets[i])
+            {
+                fprintf(fp, " <%llu:%llu", 2ull << i, (unsigned long long)histogram.buckets[i]);
+            }
+        }
+        fprintf(fp, "\n");
+    }
+    for (uint32_t counter = 0; counter < MOS_CPU_PROFILE_COUNTER_NUM; counter++)
+    {
+        uint64_t value = GetCounter((MOS_CPU_PROFILE_COUNTER)counter);
+        if (base)
+        {
+            value = (value > base->counters[counter]) ? value - base->counters[counter] : 0;
+        }
+        if (value)
+        {
+            fprintf(fp, "%-24s %10llu\n", s_counterNames[counter], (unsigned long long)value);
+        }
+    }
+    fclose(fp);
+}
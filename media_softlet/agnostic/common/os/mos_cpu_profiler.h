@@ -0,0 +1,239 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_cpu_profiler.h
+//! \brief    Scoped CPU timers aggregated into per stage histograms.
+//! \details  The timers are always compiled in and only take a timestamp when
+//!           enabled through the GFX_MEDIA_CPU_PROFILE environment variable,
+//!           whose value is the file the histograms are appended to.
+//!
+#ifndef __MOS_CPU_PROFILER_H__
+#define __MOS_CPU_PROFILER_H__
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include "mos_defs.h"
+
+//!
+//! \brief CPU stages measured per frame, from DDI down to the KMD submission
+//!
+enum MOS_CPU_PROFILE_STAGE
+{
+    MOS_CPU_PROFILE_DDI_RENDER_PICTURE = 0,
+    MOS_CPU_PROFILE_DDI_END_PICTURE,
+    MOS_CPU_PROFILE_PIPELINE_PREPARE,
+    MOS_CPU_PROFILE_PIPELINE_EXECUTE,
+    MOS_CPU_PROFILE_PACKET_SUBMIT,
+    MOS_CPU_PROFILE_MOS_SUBMIT,
+    MOS_CPU_PROFILE_KMD_EXEC,
+    MOS_CPU_PROFILE_RESOURCE_LOCK,
+    MOS_CPU_PROFILE_STAGE_NUM
+};
+
+//!
+//! \brief Event counters, dumped along with the stage histograms
+//!
+enum MOS_CPU_PROFILE_COUNTER
+{
+    MOS_CPU_PROFILE_COUNTER_LOCK_MAP = 0,       //!< bufmgr map on lock, one set-domain or wait ioctl
+    MOS_CPU_PROFILE_COUNTER_LOCK_BUSY_CHECK,    //!< Busy check on lock of a persistent mapping, at most one ioctl
+    MOS_CPU_PROFILE_COUNTER_LOCK_WAIT,          //!< Wait ioctl on lock of a busy persistent mapping
+    MOS_CPU_PROFILE_COUNTER_NUM
+};
+
+class MosCpuProfiler
+{
+public:
+    //! Bucket i holds samples in [2^i, 2^(i+1)) us, bucket 0 holds everything below 2us
+    static const uint32_t m_bucketNum = 24;
+
+    struct Histogram
+    {
+        uint64_t count;
+        uint64_t totalNs;
+        uint64_t minNs;
+        uint64_t maxNs;
+        uint64_t buckets[m_bucketNum];
+    };
+
+    //!
+    //! \brief    Check whether CPU profiling is enabled
+    //!
+    static bool IsEnabled()
+    {
+        return m_enabled;
+    }
+
+    //!
+    //! \brief    Get monotonic time stamp in ns
+    //!
+    static uint64_t GetTimeNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //!
+    //! \brief    Add one sample to the histogram of a stage
+    //! \param    [in] stage
+    //!           Measured stage
+    //! \param    [in] ns
+    //!           Elapsed CPU time in ns
+    //!
+    static void Record(MOS_CPU_PROFILE_STAGE stage, uint64_t ns);
+
+    //!
+    //! \brief    Increment an event counter when profiling is enabled
+    //!
+    static void Count(MOS_CPU_PROFILE_COUNTER counter)
+    {
+        if (m_enabled && counter < MOS_CPU_PROFILE_COUNTER_NUM)
+        {
+            m_counters[counter].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    //!
+    //! \brief    Query an event counter
+    //!
+    static uint64_t GetCounter(MOS_CPU_PROFILE_COUNTER counter)
+    {
+        return (counter < MOS_CPU_PROFILE_COUNTER_NUM) ? m_counters[counter].load(std::memory_order_relaxed) : 0;
+    }
+
+    //!
+    //! \brief    Query the histogram of a stage
+    //! \param    [in] stage
+    //!           Queried stage
+    //! \param    [out] histogram
+    //!           Snapshot of the histogram
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS GetHistogram(MOS_CPU_PROFILE_STAGE stage, Histogram &histogram);
+
+    //!
+    //! \brief    Get the printable name of a stage
+    //!
+    static const char *GetStageName(MOS_CPU_PROFILE_STAGE stage);
+
+    //!
+    //! \brief    Clear all histograms and counters
+    //!
+    static void Reset();
+
+    //!
+    //! \brief    Append all histograms to the output file
+    //! \param    [in] tag
+    //!           Text printed ahead of the histograms, e.g. the destroyed context
+    //!
+    static void Dump(const char *tag);
+
+    //!
+    //! \brief    Start an interval, e.g. the lifetime of a context
+    //! \details  The histograms stay process wide. The interval keeps a snapshot of
+    //!           them, which DumpInterval subtracts.
+    //! \param    [in] key
+    //!           Identifies the interval, e.g. the context
+    //!
+    static void BeginInterval(const void *key);
+
+    //!
+    //! \brief    Append the samples recorded since BeginInterval to the output file
+    //!           and end the interval
+    //! \details  Samples of all threads are counted, min and max cover the whole process.
+    //! \param    [in] key
+    //!           Key passed to BeginInterval, the whole histograms are dumped if unknown
+    //! \param    [in] tag
+    //!           Text printed ahead of the histograms
+    //!
+    static void DumpInterval(const void *key, const char *tag);
+
+private:
+    struct Snapshot
+    {
+        Histogram stages[MOS_CPU_PROFILE_STAGE_NUM];
+        uint64_t  counters[MOS_CPU_PROFILE_COUNTER_NUM];
+    };
+
+    //!
+    //! \brief    Copy all histograms and counters
+    //!
+    static void TakeSnapshot(Snapshot &snapshot);
+
+    //!
+    //! \brief    Append the histograms, less a snapshot taken before, to the output file
+    //!
+    static void DumpSince(const char *tag, const Snapshot *base);
+
+    struct StageCounters
+    {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> totalNs;
+        std::atomic<uint64_t> minNs;
+        std::atomic<uint64_t> maxNs;
+        std::atomic<uint64_t> buckets[m_bucketNum];
+    };
+
+    static bool          m_enabled;
+    static const char   *m_outputFile;
+
+    static StageCounters m_stages[MOS_CPU_PROFILE_STAGE_NUM];
+    static std::atomic<uint64_t> m_counters[MOS_CPU_PROFILE_COUNTER_NUM];
+
+    static std::mutex                       m_intervalMutex;
+    static std::map<const void *, Snapshot> m_intervals;  //!< Snapshot per open interval
+};
+
+//!
+//! \brief Measures the lifetime of the enclosing scope when profiling is enabled
+//!
+class MosCpuProfileScope
+{
+public:
+    MosCpuProfileScope(MOS_CPU_PROFILE_STAGE stage) :
+        m_stage(stage),
+        m_startNs(MosCpuProfiler::IsEnabled() ? MosCpuProfiler::GetTimeNs() : 0)
+    {
+    }
+
+    ~MosCpuProfileScope()
+    {
+        if (m_startNs)
+        {
+            MosCpuProfiler::Record(m_stage, MosCpuProfiler::GetTimeNs() - m_startNs);
+        }
+    }
+
+private:
+    MOS_CPU_PROFILE_STAGE m_stage;
+    uint64_t              m_startNs;
+};
+
+#define MOS_CPU_PROFILE_CONCAT_(a, b) a##b
+#define MOS_CPU_PROFILE_CONCAT(a, b) MOS_CPU_PROFILE_CONCAT_(a, b)
+#define MOS_CPU_PROFILE_SCOPE(stage) \
+    MosCpuProfileScope MOS_CPU_PROFILE_CONCAT(_cpuProfileScope, __LINE__)(stage)
+
+#endif // __MOS_CPU_PROFILER_H__
@@ -204,6 +204,8 @@ public:
         bool m_uncached     = false;
         bool m_writeRequest = false;
         bool m_noOverWrite  = false;
+        uint32_t m_rowStart = 0;        //!< First row of the region to lock
+        uint32_t m_rowNum   = 0;        //!< Rows of the region to lock, 0 for the whole resource
 
         //!
         //! \brief   For wrapper usage, to be removed
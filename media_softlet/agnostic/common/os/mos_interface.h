@@ -1121,6 +1121,36 @@ public:
         MOS_RESOURCE_HANDLE resource,
         PMOS_LOCK_PARAMS flags);
 
+    //!
+    //! \brief    Lock Resource Region
+    //! \details  [Resource Interface] Same as LockMosResource, but only rows [rowStart, rowStart + rowNum)
+    //!           of the returned data are guaranteed to be valid, and only they may be written.
+    //! \details  For tiled resources locked through a s/w untiling shadow, only the tile rows covering
+    //!           the region are de-swizzled, and only written tile rows are swizzled back on unlock.
+    //!           Other resources are locked as a whole.
+    //!           Regions of one resource can be locked several times before UnlockMosResource.
+    //!
+    //! \param    [in] streamState
+    //!           Handle of Os Stream State
+    //! \param    [in] resource
+    //!           MOS Resource handle of the resource to lock.
+    //! \param    [in] flags
+    //!           Control flags of locking resource.
+    //! \param    [in] rowStart
+    //!           First row of the region
+    //! \param    [in] rowNum
+    //!           Number of rows of the region
+    //!
+    //! \return   void *
+    //!           Locked memory data pointer of the whole resource, nullptr if lock failed.
+    //!
+    static void *LockMosResourceRegion(
+        MOS_STREAM_HANDLE streamState,
+        MOS_RESOURCE_HANDLE resource,
+        PMOS_LOCK_PARAMS flags,
+        uint32_t rowStart,
+        uint32_t rowNum);
+
     //!
     //! \brief    Unlock Resource
     //! \details  [Resource Interface] Unlock the gfx resource which is locked out.
@@ -1247,6 +1247,31 @@ public:
     //! \brief    Uninitialize reg related resources
     //!
     static MOS_STATUS MosUninitializeReg(RegBufferMap &regBufferMap);
+
+    //!
+    //! \brief    Start watching the reg file for modifications
+    //! \return   int32_t
+    //!           Watch handle, -1 if the reg file can not be watched
+    //!
+    static int32_t MosWatchRegFile();
+
+    //!
+    //! \brief    Check whether the reg file was modified since the last check
+    //! \details  Never blocks, pending modification events are consumed. The
+    //!           watch is added again when the file is deleted or replaced.
+    //! \param    [in] watchHandle
+    //!           Handle returned by MosWatchRegFile
+    //! \return   bool
+    //!           true if the reg file was modified
+    //!
+    static bool MosIsRegFileChanged(int32_t watchHandle);
+
+    //!
+    //! \brief    Stop watching the reg file
+    //! \param    [in] watchHandle
+    //!           Handle returned by MosWatchRegFile
+    //!
+    static void MosUnwatchRegFile(int32_t watchHandle);
     //!
     //! \brief    Creates the specified reg key
     //! \details  Creates the specified reg key. If the key already exists,
@@ -27,6 +27,7 @@
 //!
 #include <algorithm>
 #include "media_allocator.h"
+#include "mos_interface.h"
 
 Allocator::Allocator(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
 {
@@ -368,6 +369,21 @@ void* Allocator::Lock(MOS_RESOURCE* resource, MOS_LOCK_PARAMS* lockFlag)
     return (m_osInterface->pfnLockResource(m_osInterface, resource, lockFlag));
 }
 
+void* Allocator::LockRegion(MOS_RESOURCE* resource, MOS_LOCK_PARAMS* lockFlag, uint32_t rowStart, uint32_t rowNum)
+{
+    if (nullptr == resource || nullptr == lockFlag)
+    {
+        return nullptr;
+    }
+
+    if (m_osInterface->apoMosEnabled)
+    {
+        return MosInterface::LockMosResourceRegion(m_osInterface->osStreamState, resource, lockFlag, rowStart, rowNum);
+    }
+
+    return (m_osInterface->pfnLockResource(m_osInterface, resource, lockFlag));
+}
+
 MOS_STATUS Allocator::UnLock(MOS_RESOURCE* resource)
 {
     if (nullptr == resource)
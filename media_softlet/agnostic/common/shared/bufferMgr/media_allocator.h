@@ -165,6 +165,23 @@ public:
     //!
     void *Lock(MOS_RESOURCE *resource, MOS_LOCK_PARAMS *lockFlag);
 
+    //!
+    //! \brief  Lock rows of Surface
+    //! \details Only rows [rowStart, rowStart + rowNum) of the returned data are valid,
+    //!          see MosInterface::LockMosResourceRegion
+    //! \param  [in] resource
+    //!         Pointer to MOS_RESOURCE
+    //! \param  [in] lockFlag
+    //!         Pointer to MOS_LOCK_PARAMS
+    //! \param  [in] rowStart
+    //!         First row to lock
+    //! \param  [in] rowNum
+    //!         Number of rows to lock
+    //! \return void*
+    //!         a poniter to data of the whole surface
+    //!
+    void *LockRegion(MOS_RESOURCE *resource, MOS_LOCK_PARAMS *lockFlag, uint32_t rowStart, uint32_t rowNum);
+
     //!
     //! \brief  UnLock Surface
     //! \param  [in] resource
@@ -27,8 +27,15 @@
 //!           this file is for the base interface which is shared by all components.
 //!
 
+#include <atomic>
 #include "media_feature_manager.h"
 
+uint32_t MediaParSettingCache::NewTypeId()
+{
+    static std::atomic<uint32_t> nextId(0);
+    return nextId++;
+}
+
 MOS_STATUS MediaFeatureManager::RegisterFeatures(
     int                featureID,
     MediaFeature *     feature,
@@ -54,6 +61,7 @@ MOS_STATUS MediaFeatureManager::RegisterFeatures(
     }
     m_packetIdList[featureID]      = std::move(packetIds);
     m_packetIdListTypes[featureID] = packetIdListType;
+    m_parSettings.Clear();
 
     return MOS_STATUS_SUCCESS;
 }
@@ -118,6 +126,7 @@ MOS_STATUS MediaFeatureManager::Destroy()
         };
     }
     m_features.clear();
+    m_parSettings.Clear();
 
     if (m_featureConstSettings != nullptr)
     {
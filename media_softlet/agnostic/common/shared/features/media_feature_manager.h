@@ -29,6 +29,7 @@
 
 #ifndef __MEDIA_FEATURE_MANAGER_H__
 #define __MEDIA_FEATURE_MANAGER_H__
+#include <deque>
 #include <vector>
 #include "media_feature.h"
 #include "media_feature_const_settings.h"
@@ -94,6 +95,62 @@ struct FeatureIDs
 
 class MediaFeature;
 
+//!
+//! \brief  Per setting interface list of the features which implement it
+//! \details Built with dynamic_cast on the first SETPAR of each interface and replayed
+//!          afterwards, so a command no longer casts every feature on every frame.
+//!          Must be cleared whenever the feature list changes.
+//!
+class MediaParSettingCache
+{
+public:
+    template <typename Setting, typename Container>
+    const std::vector<const void *> &Get(const Container &features)
+    {
+        uint32_t id = TypeId<Setting>();
+        if (id >= m_entries.size())
+        {
+            // deque keeps the lists of other interfaces in place, a nested SETPAR may be iterating one
+            m_entries.resize(id + 1);
+        }
+        Entry &entry = m_entries[id];
+        if (!entry.valid)
+        {
+            entry.settings.clear();
+            for (const auto &e : features)
+            {
+                const Setting *setting = dynamic_cast<const Setting *>(e.second);
+                if (setting)
+                {
+                    entry.settings.push_back(setting);
+                }
+            }
+            entry.valid = true;
+        }
+        return entry.settings;
+    }
+
+    void Clear() { m_entries.clear(); }
+
+private:
+    struct Entry
+    {
+        bool                      valid = false;
+        std::vector<const void *> settings;  //!< Setting pointers in feature ID order
+    };
+
+    template <typename Setting>
+    static uint32_t TypeId()
+    {
+        static const uint32_t id = NewTypeId();
+        return id;
+    }
+
+    static uint32_t NewTypeId();
+
+    std::deque<Entry> m_entries;  //!< Indexed by TypeId
+};
+
 enum class LIST_TYPE
 {
     BLOCK_LIST,
@@ -135,8 +192,20 @@ public:
             return iter->second;
         }
 
+        //!
+        //! \brief  Get the features implementing a par setting interface
+        //! \return const std::vector<const void *> &
+        //!         Pointers to Setting, in feature ID order
+        //!
+        template <typename Setting>
+        const std::vector<const void *> &GetParSettings()
+        {
+            return m_parSettings.Get<Setting>(m_features);
+        }
+
     private:
-        container_t m_features;
+        container_t          m_features;
+        MediaParSettingCache m_parSettings;
     };
 
 public:
@@ -237,6 +306,18 @@ public:
         }
         return iter->second;
     }
+
+    //!
+    //! \brief  Get the features implementing a par setting interface
+    //! \return const std::vector<const void *> &
+    //!         Pointers to Setting, in feature ID order
+    //!
+    template <typename Setting>
+    const std::vector<const void *> &GetParSettings()
+    {
+        return m_parSettings.Get<Setting>(m_features);
+    }
+
     //!
     //! \brief  Get Pass Number
     //! \return uint8_t
@@ -284,6 +365,7 @@ protected:
     MediaFeatureConstSettings *m_featureConstSettings = nullptr;
     uint8_t m_targetUsage = 0;
     uint8_t m_passNum = 1;
+    MediaParSettingCache m_parSettings;  //!< Cleared whenever m_features changes
     // Media user setting instance
     MediaUserSettingSharedPtr m_userSettingPtr = nullptr;
 };
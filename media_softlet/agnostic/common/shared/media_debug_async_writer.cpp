@@ -0,0 +1,223 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_async_writer.cpp
+//! \brief    Implements the background writer used by the media debug interface.
+//!
+#include "media_debug_async_writer.h"
+#if USE_MEDIA_DEBUG_TOOL
+#include <fstream>
+
+MediaDebugAsyncWriter::MediaDebugAsyncWriter(uint32_t queueDepth, bool dropOnFull) :
+    m_queueDepth(queueDepth ? queueDepth : 1),
+    m_dropOnFull(dropOnFull)
+{
+    m_worker = std::thread(&MediaDebugAsyncWriter::Worker, this);
+}
+
+MediaDebugAsyncWriter::~MediaDebugAsyncWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_jobReady.notify_all();
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+
+    MEDIA_DEBUG_NORMALMESSAGE("Async dump: submitted %llu, written %llu, failed %llu, dropped %llu, stalled %llu, bytes %llu, max queue depth %u",
+        (unsigned long long)m_stats.submitted,
+        (unsigned long long)m_stats.written,
+        (unsigned long long)m_stats.failed,
+        (unsigned long long)m_stats.dropped,
+        (unsigned long long)m_stats.stalled,
+        (unsigned long long)m_stats.bytesWritten,
+        m_stats.maxQueueDepth);
+}
+
+bool MediaDebugAsyncWriter::ReserveSlot(std::unique_lock<std::mutex> &lock)
+{
+    m_stats.submitted++;
+
+    if (m_jobs.size() + m_reserved >= m_queueDepth)
+    {
+        if (m_dropOnFull)
+        {
+            m_stats.dropped++;
+            return false;
+        }
+
+        m_stats.stalled++;
+        m_slotFree.wait(lock, [this] { return m_jobs.size() + m_reserved < m_queueDepth; });
+    }
+
+    m_reserved++;
+    m_inFlight++;
+    return true;
+}
+
+void MediaDebugAsyncWriter::Enqueue(Job &job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reserved--;
+        m_jobs.push_back(std::move(job));
+        m_stats.maxQueueDepth = MOS_MAX(m_stats.maxQueueDepth, (uint32_t)m_jobs.size());
+    }
+    m_jobReady.notify_one();
+}
+
+MOS_STATUS MediaDebugAsyncWriter::Submit(const uint8_t *data, uint32_t size, WriteFunc write)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
+
+    return Submit2D(data, size, 1, size, write);
+}
+
+MOS_STATUS MediaDebugAsyncWriter::Submit2D(
+    const uint8_t *data,
+    uint32_t       width,
+    uint32_t       height,
+    uint32_t       pitch,
+    WriteFunc      write)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
+
+    if (width == 0 || height == 0 || width > pitch)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    Job job;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!ReserveSlot(lock))
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
+        if (!m_stagingPool.empty())
+        {
+            job.data = std::move(m_stagingPool.back());
+            m_stagingPool.pop_back();
+        }
+    }
+
+    // Staging buffers keep their capacity across jobs, so steady-state dumps of the same size do not allocate
+    job.size  = width * height;
+    job.write = write;
+    job.data.resize(job.size);
+
+    uint8_t *dst = job.data.data();
+    for (uint32_t h = 0; h < height; h++)
+    {
+        MOS_SecureMemcpy(dst, width, data, width);
+        dst  += width;
+        data += pitch;
+    }
+
+    Enqueue(job);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaDebugAsyncWriter::SubmitBinaryFile(const std::string &filePath, const uint8_t *data, uint32_t size)
+{
+    return Submit(data, size, [filePath](const uint8_t *staging, uint32_t stagingSize) {
+        return WriteBinaryFile(filePath, staging, stagingSize);
+    });
+}
+
+void MediaDebugAsyncWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_inFlight == 0; });
+}
+
+MediaDebugAsyncWriter::Statistics MediaDebugAsyncWriter::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+MOS_STATUS MediaDebugAsyncWriter::WriteBinaryFile(const std::string &filePath, const uint8_t *data, uint32_t size)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
+
+    std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
+    if (ofs.fail())
+    {
+        return MOS_STATUS_UNKNOWN;
+    }
+
+    ofs.write((const char *)data, size);
+    ofs.close();
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaDebugAsyncWriter::Worker()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobReady.wait(lock, [this] { return m_exit || !m_jobs.empty(); });
+
+            // Queued jobs are still written on exit, the worker only quits once the queue is drained
+            if (m_jobs.empty())
+            {
+                break;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        m_slotFree.notify_one();
+
+        MOS_STATUS status = job.write ? job.write(job.data.data(), job.size) : MOS_STATUS_NULL_POINTER;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (status == MOS_STATUS_SUCCESS)
+            {
+                m_stats.written++;
+                m_stats.bytesWritten += job.size;
+            }
+            else
+            {
+                m_stats.failed++;
+            }
+
+            if (m_stagingPool.size() <= m_queueDepth)
+            {
+                m_stagingPool.push_back(std::move(job.data));
+            }
+            m_inFlight--;
+        }
+        m_idle.notify_all();
+    }
+}
+
+#endif  // USE_MEDIA_DEBUG_TOOL
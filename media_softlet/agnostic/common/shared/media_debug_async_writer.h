@@ -0,0 +1,133 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_async_writer.h
+//! \brief    Defines the background writer used by the media debug interface.
+//! \details  Dump data is snapshotted into pooled staging memory on the caller thread,
+//!           then converted and written to disk by a worker thread with a bounded queue.
+//!
+#ifndef __MEDIA_DEBUG_ASYNC_WRITER_H__
+#define __MEDIA_DEBUG_ASYNC_WRITER_H__
+
+#include "media_debug_utils.h"
+#if USE_MEDIA_DEBUG_TOOL
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class MediaDebugAsyncWriter
+{
+public:
+    //!
+    //! \brief  Write callback run on the worker thread with the staging data of one job
+    //!
+    using WriteFunc = std::function<MOS_STATUS(const uint8_t *data, uint32_t size)>;
+
+    struct Statistics
+    {
+        uint64_t submitted     = 0;  //!< Jobs passed to Submit
+        uint64_t written       = 0;  //!< Jobs written successfully
+        uint64_t failed        = 0;  //!< Jobs whose write callback failed
+        uint64_t dropped       = 0;  //!< Jobs dropped because the queue was full
+        uint64_t stalled       = 0;  //!< Jobs which waited for a free queue slot
+        uint64_t bytesWritten  = 0;  //!< Staging bytes of successfully written jobs
+        uint32_t maxQueueDepth = 0;  //!< Max number of jobs queued at the same time
+    };
+
+    //!
+    //! \brief    Constructor
+    //! \param    [in] queueDepth
+    //!           Max number of jobs waiting to be written
+    //! \param    [in] dropOnFull
+    //!           Drop new jobs when the queue is full instead of stalling the caller
+    //!
+    MediaDebugAsyncWriter(uint32_t queueDepth, bool dropOnFull);
+
+    //!
+    //! \brief    Destructor, writes all queued jobs before returning
+    //!
+    virtual ~MediaDebugAsyncWriter();
+
+    //!
+    //! \brief    Snapshot data into staging memory and queue it for writing
+    //! \param    [in] data
+    //!           Data to snapshot, may be released by caller once Submit returns
+    //! \param    [in] size
+    //!           Size of data
+    //! \param    [in] write
+    //!           Callback consuming the snapshot on the worker thread
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if the job is queued or dropped by policy
+    //!
+    MOS_STATUS Submit(const uint8_t *data, uint32_t size, WriteFunc write);
+
+    //!
+    //! \brief    Snapshot a 2D region row by row and queue it for writing
+    //! \details  Only width bytes of each row are kept, so the write callback sees packed rows
+    //!
+    MOS_STATUS Submit2D(const uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, WriteFunc write);
+
+    //!
+    //! \brief    Queue a binary file write of data
+    //!
+    MOS_STATUS SubmitBinaryFile(const std::string &filePath, const uint8_t *data, uint32_t size);
+
+    //!
+    //! \brief    Wait until all queued jobs are written
+    //!
+    void Flush();
+
+    Statistics GetStatistics();
+
+    static MOS_STATUS WriteBinaryFile(const std::string &filePath, const uint8_t *data, uint32_t size);
+
+protected:
+    struct Job
+    {
+        std::vector<uint8_t> data;
+        uint32_t             size = 0;
+        WriteFunc            write;
+    };
+
+    bool ReserveSlot(std::unique_lock<std::mutex> &lock);
+    void Enqueue(Job &job);
+    void Worker();
+
+    std::thread                       m_worker;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_jobReady;    //!< Signalled when a job is queued or on exit
+    std::condition_variable           m_slotFree;    //!< Signalled when a job leaves the queue
+    std::condition_variable           m_idle;        //!< Signalled when a job finished writing
+    std::deque<Job>                   m_jobs;
+    std::vector<std::vector<uint8_t>> m_stagingPool;
+    uint32_t                          m_queueDepth = 0;
+    uint32_t                          m_reserved   = 0;  //!< Slots taken by jobs being snapshotted
+    uint32_t                          m_inFlight   = 0;  //!< Jobs reserved, queued or being written
+    bool                              m_dropOnFull = false;
+    bool                              m_exit       = false;
+    Statistics                        m_stats;
+};
+
+#endif  // USE_MEDIA_DEBUG_TOOL
+#endif  // __MEDIA_DEBUG_ASYNC_WRITER_H__
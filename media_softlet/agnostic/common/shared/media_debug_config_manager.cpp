@@ -353,6 +353,17 @@ bool MediaDebugConfigMgr::AttrIsEnabled(std::string attrName)
     return false;
 }
 
+int32_t MediaDebugConfigMgr::GetAllFramesAttrValue(std::string attrName)
+{
+    if (nullptr == m_debugAllConfigs)
+    {
+        return 0;
+    }
+
+    auto it = m_debugAllConfigs->cmdAttribs.find(attrName);
+    return it != m_debugAllConfigs->cmdAttribs.end() ? it->second : 0;
+}
+
 bool MediaDebugConfigMgr::AttrIsEnabled(
     MEDIA_DEBUG_STATE_TYPE mediaState,
     std::string            attrName)
@@ -458,6 +469,8 @@ void MediaDebugConfigMgr::GenerateDefaultConfig(std::string configFileName)
     ofs << "#" << MediaDbgAttr::attrDumpBufferInBinary << ":0" << std::endl;
     ofs << "#" << MediaDbgAttr::attrDumpToThreadFolder << ":0" << std::endl;
     ofs << "#" << MediaDbgAttr::attrDumpCmdBufInBinary << ":0" << std::endl;
+    ofs << "#" << MediaDbgAttr::attrAsyncDump << ":0" << std::endl;
+    ofs << "#" << MediaDbgAttr::attrAsyncDumpDropOnFull << ":0" << std::endl;
     ofs << "#" << MediaDbgAttr::attrStatusReport << ":0" << std::endl;
     ofs << std::endl;
 
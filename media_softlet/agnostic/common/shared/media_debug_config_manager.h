@@ -74,6 +74,7 @@ public:
 
     bool AttrIsEnabled(std::string attrName);
     bool AttrIsEnabled(MEDIA_DEBUG_STATE_TYPE mediaState, std::string attrName);
+    int32_t GetAllFramesAttrValue(std::string attrName);
 
  protected:
     void     GenerateDefaultConfig(std::string configFileName);
@@ -46,6 +46,9 @@ MediaDebugInterface::MediaDebugInterface()
 
 MediaDebugInterface::~MediaDebugInterface()
 {
+    // Write out all queued dumps before the resources they came from go away
+    MOS_Delete(m_asyncWriter);
+
     if (nullptr != m_configMgr)
     {
         MOS_Delete(m_configMgr);
@@ -67,6 +70,14 @@ MOS_STATUS MediaDebugInterface::InitDumpLocation()
         MosUtilities::MosCreateDirectory(const_cast<char *>(m_outputFilePath.c_str()));
     }
 
+    int32_t asyncDumpQueueDepth = m_configMgr->GetAllFramesAttrValue(MediaDbgAttr::attrAsyncDump);
+    if (asyncDumpQueueDepth > 0 && m_asyncWriter == nullptr)
+    {
+        m_asyncWriter = MOS_New(MediaDebugAsyncWriter,
+            (uint32_t)asyncDumpQueueDepth,
+            m_configMgr->AttrIsEnabled(MediaDbgAttr::attrAsyncDumpDropOnFull));
+    }
+
     m_ddiFileName = m_outputFilePath + "ddi.par";
     std::ofstream ofs(m_ddiFileName, std::ios::out);
     ofs << "ParamFilePath"
@@ -925,7 +936,8 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
     lockFlags.ReadOnly     = 1;
     lockFlags.TiledAsTiled = 1;  // Bypass GMM CPU blit due to some issues in GMM CpuBlt function
 
-    uint8_t *lockedAddr = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, &surface->OsResource, &lockFlags);
+    PMOS_RESOURCE lockedResource = &surface->OsResource;
+    uint8_t *     lockedAddr     = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, lockedResource, &lockFlags);
     if (lockedAddr == nullptr)  // Failed to lock. Try to submit copy task and dump another surface
     {
         uint32_t        sizeToBeCopied = 0;
@@ -978,7 +990,8 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
             m_osInterface->pfnFreeResource(m_osInterface, &m_temp2DSurfForCopy.OsResource);
             return MOS_STATUS_NULL_POINTER;
         }
-        lockedAddr = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, &m_temp2DSurfForCopy.OsResource, &lockFlags);
+        lockedResource = &m_temp2DSurfForCopy.OsResource;
+        lockedAddr     = (uint8_t *)m_osInterface->pfnLockResource(m_osInterface, lockedResource, &lockFlags);
         MEDIA_DEBUG_CHK_NULL(lockedAddr);
 
         if (DumpIsEnabled(MediaDbgAttr::attrDisableSwizzleForDumps))
@@ -1007,25 +1020,6 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         }
     }
 
-    uint8_t *surfBaseAddr = (uint8_t *)MOS_AllocMemory(sizeMain);
-    MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
-
-    if (DumpIsEnabled(MediaDbgAttr::attrForceYUVDumpWithMemcpy))
-    {
-        MOS_SecureMemcpy(surfBaseAddr, sizeMain, lockedAddr, sizeMain);  // Firstly, copy to surfBaseAddr to faster unlock resource
-        m_osInterface->pfnUnlockResource(m_osInterface, &surface->OsResource);
-        lockedAddr   = surfBaseAddr;
-        surfBaseAddr = (uint8_t *)MOS_AllocMemory(sizeMain);
-        MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
-    }
-
-    // Always use MOS swizzle instead of GMM Cpu blit
-    MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
-    Mos_SwizzleData(lockedAddr, surfBaseAddr, surface->TileType, MOS_TILE_LINEAR, sizeMain / surface->dwPitch, surface->dwPitch, 0);
-
-    uint8_t *data = surfBaseAddr;
-    data += surface->dwOffset + surface->YPlaneOffset.iYOffset * surface->dwPitch;
-
     uint32_t width  = width_in ? width_in : surface->dwWidth;
     uint32_t height = height_in ? height_in : surface->dwHeight;
 
@@ -1053,11 +1047,7 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
     if (surface->Format == Format_UYVY)
         pitch = width;
 
-    if (CodecHal_PictureIsBottomField(m_currPic))
-    {
-        data += pitch;
-    }
-
+    bool bottomField = CodecHal_PictureIsBottomField(m_currPic);
     if (CodecHal_PictureIsField(m_currPic))
     {
         pitch *= 2;
@@ -1066,11 +1056,69 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
 
     const char *funcName = (m_mediafunction == MEDIA_FUNCTION_VP) ? "_VP" : ((m_mediafunction == MEDIA_FUNCTION_ENCODE) ? "_ENC" : "_DEC");
     std::string bufName  = std::string(surfName) + "_w[" + std::to_string(surface->dwWidth) + "]_h[" + std::to_string(surface->dwHeight) + "]_p[" + std::to_string(pitch) + "]";
-    const char *filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
+    std::string filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    if (m_asyncWriter)
+    {
+        // Snapshot the tiled data so the resource is unlocked right away, swizzle and write run on the writer thread
+        MOS_SURFACE surf = *surface;
+        status = m_asyncWriter->Submit(lockedAddr, sizeMain, [=](const uint8_t *staging, uint32_t size) {
+            return WriteYUVSurface(surf, staging, size, width, height, pitch, bottomField, filePath);
+        });
+        m_osInterface->pfnUnlockResource(m_osInterface, lockedResource);
+    }
+    else if (DumpIsEnabled(MediaDbgAttr::attrForceYUVDumpWithMemcpy))
+    {
+        uint8_t *surfCopy = (uint8_t *)MOS_AllocMemory(sizeMain);
+        MEDIA_DEBUG_CHK_NULL(surfCopy);
+
+        MOS_SecureMemcpy(surfCopy, sizeMain, lockedAddr, sizeMain);  // Firstly, copy to surfCopy to faster unlock resource
+        m_osInterface->pfnUnlockResource(m_osInterface, lockedResource);
+
+        status = WriteYUVSurface(*surface, surfCopy, sizeMain, width, height, pitch, bottomField, filePath);
+        MOS_FreeMemory(surfCopy);
+    }
+    else
+    {
+        status = WriteYUVSurface(*surface, lockedAddr, sizeMain, width, height, pitch, bottomField, filePath);
+        m_osInterface->pfnUnlockResource(m_osInterface, lockedResource);
+    }
+
+    return status;
+}
+
+MOS_STATUS MediaDebugInterface::WriteYUVSurface(
+    const MOS_SURFACE &surface,
+    const uint8_t *    lockedAddr,
+    uint32_t           sizeMain,
+    uint32_t           width,
+    uint32_t           height,
+    uint32_t           pitch,
+    bool               bottomField,
+    const std::string &filePath)
+{
+    MEDIA_DEBUG_CHK_NULL(lockedAddr);
+
+    uint8_t *surfBaseAddr = (uint8_t *)MOS_AllocMemory(sizeMain);
+    MEDIA_DEBUG_CHK_NULL(surfBaseAddr);
+
+    // Always use MOS swizzle instead of GMM Cpu blit
+    Mos_SwizzleData(const_cast<uint8_t *>(lockedAddr), surfBaseAddr, surface.TileType, MOS_TILE_LINEAR, sizeMain / surface.dwPitch, surface.dwPitch, 0);
+
+    uint8_t *data = surfBaseAddr;
+    data += surface.dwOffset + surface.YPlaneOffset.iYOffset * surface.dwPitch;
+
+    if (bottomField)
+    {
+        // pitch is doubled for field pictures
+        data += pitch / 2;
+    }
 
     std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
     if (ofs.fail())
     {
+        MOS_FreeMemory(surfBaseAddr);
         return MOS_STATUS_UNKNOWN;
     }
 
@@ -1081,9 +1129,9 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         data += pitch;
     }
 
-    if (surface->Format != Format_A8B8G8R8)
+    if (surface.Format != Format_A8B8G8R8)
     {
-        switch (surface->Format)
+        switch (surface.Format)
         {
         case Format_NV12:
         case Format_P010:
@@ -1118,16 +1166,16 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
 
         uint8_t *vPlaneData = surfBaseAddr;
 #ifdef LINUX
-        data = surfBaseAddr + surface->UPlaneOffset.iSurfaceOffset;
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        data = surfBaseAddr + surface.UPlaneOffset.iSurfaceOffset;
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
-            vPlaneData = surfBaseAddr + surface->VPlaneOffset.iSurfaceOffset;
+            vPlaneData = surfBaseAddr + surface.VPlaneOffset.iSurfaceOffset;
         }
 #else
-        data = surfBaseAddr + surface->UPlaneOffset.iLockSurfaceOffset;
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        data = surfBaseAddr + surface.UPlaneOffset.iLockSurfaceOffset;
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
-            vPlaneData = surfBaseAddr + surface->VPlaneOffset.iLockSurfaceOffset;
+            vPlaneData = surfBaseAddr + surface.VPlaneOffset.iLockSurfaceOffset;
         }
 
 #endif
@@ -1140,7 +1188,7 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
         }
 
         // write v planar data to file
-        if (surface->Format == Format_422V || surface->Format == Format_IMC3)
+        if (surface.Format == Format_422V || surface.Format == Format_IMC3)
         {
             for (uint32_t h = 0; h < height; h++)
             {
@@ -1151,14 +1199,6 @@ MOS_STATUS MediaDebugInterface::DumpYUVSurface(
     }
     ofs.close();
 
-    if (DumpIsEnabled(MediaDbgAttr::attrForceYUVDumpWithMemcpy))
-    {
-        MOS_FreeMemory(lockedAddr);
-    }
-    else
-    {
-        m_osInterface->pfnUnlockResource(m_osInterface, &surface->OsResource);
-    }
     MOS_FreeMemory(surfBaseAddr);
 
     return MOS_STATUS_SUCCESS;
@@ -1959,19 +1999,11 @@ MOS_STATUS MediaDebugInterface::DumpNotSwizzled(
 
     std::string bufName = std::string(surfName) + "NotSwizzled_format[" + std::to_string((int)surf.Format) + "]_w[" + std::to_string(surf.dwWidth) + "]_h[" + std::to_string(surf.dwHeight) + "]_p[" + std::to_string(surf.dwPitch) + "]_srcTiling[" + std::to_string((int)surf.TileType) + "]_sizeMain[" + std::to_string(size) + "]_YOffset[" + std::to_string(YOffset) + "]_UOffset[" + std::to_string(UOffset) + "]_VOffset[" + std::to_string(VOffset) + "]";
 
-    const char *  filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
-    std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
-    if (ofs.fail())
-    {
-        return MOS_STATUS_UNKNOWN;
-    }
-
-    uint8_t *data = lockedAddr;
-    ofs.write((char *)data, size);
-    ofs.close();
+    const char *filePath = CreateFileName(funcName, bufName.c_str(), MediaDbgExtType::yuv);
+    MOS_STATUS  status   = WriteBufferToFile(filePath, lockedAddr, size);
 
     m_osInterface->pfnUnlockResource(m_osInterface, &surf.OsResource);
-    return MOS_STATUS_SUCCESS;
+    return status;
 }
 
 MOS_STATUS MediaDebugInterface::Dump2DBufferInBinary(
@@ -1982,62 +2014,108 @@ MOS_STATUS MediaDebugInterface::Dump2DBufferInBinary(
 {
     MEDIA_DEBUG_CHK_NULL(data);
 
-    const char *filePath = m_outputFileName.c_str();
-
     if (width == 0 || height == 0 || pitch == 0)
     {
         return MOS_STATUS_UNKNOWN;
     }
 
-    std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
-    if (ofs.fail())
-    {
-        return MOS_STATUS_UNKNOWN;
-    }
+    return Write2DBufferToFile(m_outputFileName, data, width, height, pitch, false);
+}
 
-    for (uint32_t h = 0; h < height; h++)
+MOS_STATUS MediaDebugInterface::DumpBufferInBinary(uint8_t *data, uint32_t size)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
+
+    if (size == 0)
     {
-        ofs.write((char *)data, width);
-        data += pitch;
+        return MOS_STATUS_UNKNOWN;
     }
 
-    ofs.close();
-    return MOS_STATUS_SUCCESS;
+    return WriteBufferToFile(m_outputFileName, data, size);
 }
 
-MOS_STATUS MediaDebugInterface::DumpBufferInBinary(uint8_t *data, uint32_t size)
+MOS_STATUS MediaDebugInterface::Write2DBufferToFile(
+    const std::string &filePath,
+    const uint8_t *    data,
+    uint32_t           width,
+    uint32_t           height,
+    uint32_t           pitch,
+    bool               append)
 {
     MEDIA_DEBUG_CHK_NULL(data);
 
-    const char *filePath = m_outputFileName.c_str();
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary | (append ? std::ios_base::app : std::ios_base::trunc);
 
-    if (size == 0)
+    if (m_asyncWriter)
     {
-        return MOS_STATUS_UNKNOWN;
+        // Jobs are written in submission order, so an appended plane lands after the earlier ones
+        return m_asyncWriter->Submit2D(data, width, height, pitch, [filePath, mode](const uint8_t *staging, uint32_t size) {
+            std::ofstream ofs(filePath, mode);
+            if (ofs.fail())
+            {
+                return MOS_STATUS_UNKNOWN;
+            }
+            ofs.write((const char *)staging, size);
+            return ofs.fail() ? MOS_STATUS_UNKNOWN : MOS_STATUS_SUCCESS;
+        });
     }
 
-    std::ofstream ofs(filePath, std::ios_base::out | std::ios_base::binary);
+    std::ofstream ofs(filePath, mode);
     if (ofs.fail())
     {
         return MOS_STATUS_UNKNOWN;
     }
 
-    ofs.write((char *)data, size);
+    for (uint32_t h = 0; h < height; h++)
+    {
+        ofs.write((const char *)data, width);
+        data += pitch;
+    }
+
     ofs.close();
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS MediaDebugInterface::DumpBufferInHexDwords(uint8_t *data, uint32_t size)
+MOS_STATUS MediaDebugInterface::WriteBufferToFile(
+    const std::string &filePath,
+    const uint8_t *    data,
+    uint32_t           size)
 {
     MEDIA_DEBUG_CHK_NULL(data);
 
-    const char *filePath = m_outputFileName.c_str();
+    if (m_asyncWriter)
+    {
+        return m_asyncWriter->SubmitBinaryFile(filePath, data, size);
+    }
+
+    return MediaDebugAsyncWriter::WriteBinaryFile(filePath, data, size);
+}
+
+MOS_STATUS MediaDebugInterface::DumpBufferInHexDwords(uint8_t *data, uint32_t size)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
 
     if (size == 0)
     {
         return MOS_STATUS_UNKNOWN;
     }
 
+    if (m_asyncWriter)
+    {
+        // The trailing partial dword is read as a whole dword, so keep it in the snapshot
+        std::string filePath = m_outputFileName;
+        return m_asyncWriter->Submit(data, (uint32_t)MOS_ALIGN_CEIL(size, sizeof(uint32_t)), [filePath, size](const uint8_t *staging, uint32_t) {
+            return WriteBufferInHexDwords(filePath, staging, size);
+        });
+    }
+
+    return WriteBufferInHexDwords(m_outputFileName, data, size);
+}
+
+MOS_STATUS MediaDebugInterface::WriteBufferInHexDwords(const std::string &filePath, const uint8_t *data, uint32_t size)
+{
+    MEDIA_DEBUG_CHK_NULL(data);
+
     std::ofstream ofs(filePath);
 
     if (ofs.fail())
@@ -2048,8 +2126,8 @@ MOS_STATUS MediaDebugInterface::DumpBufferInHexDwords(uint8_t *data, uint32_t si
     uint32_t dwordSize  = size / sizeof(uint32_t);
     uint32_t remainSize = size % sizeof(uint32_t);
 
-    uint32_t *dwordData = (uint32_t *)data;
-    uint32_t  i;
+    const uint32_t *dwordData = (const uint32_t *)data;
+    uint32_t        i;
     for (i = 0; i < dwordSize; i++)
     {
         ofs << std::hex << std::setw(8) << std::setfill('0') << +dwordData[i] << " ";
@@ -36,6 +36,7 @@
 #include "mhw_state_heap.h"
 #include "media_debug_config_manager.h"
 #include "media_debug_utils.h"
+#include "media_debug_async_writer.h"
 #include <sstream>
 #include <fstream>
 using GoldenReferences = std::vector<std::vector<uint32_t>>;
@@ -248,11 +249,48 @@ protected:
         uint32_t height,
         uint32_t pitch);
 
+    //!
+    //! \brief    Write rows of a 2D region to a file, on the async writer when enabled
+    //! \details  Only width bytes of each row are written. With append the rows are
+    //!           added to the end of the file, e.g. for the chroma plane after luma.
+    //!
+    MOS_STATUS Write2DBufferToFile(
+        const std::string &filePath,
+        const uint8_t *    data,
+        uint32_t           width,
+        uint32_t           height,
+        uint32_t           pitch,
+        bool               append);
+
+    //!
+    //! \brief    Write a buffer to a file, on the async writer when enabled
+    //!
+    MOS_STATUS WriteBufferToFile(
+        const std::string &filePath,
+        const uint8_t *    data,
+        uint32_t           size);
+
+    static MOS_STATUS WriteBufferInHexDwords(
+        const std::string &filePath,
+        const uint8_t *    data,
+        uint32_t           size);
+
+    static MOS_STATUS WriteYUVSurface(
+        const MOS_SURFACE &surface,
+        const uint8_t *    lockedAddr,
+        uint32_t           sizeMain,
+        uint32_t           width,
+        uint32_t           height,
+        uint32_t           pitch,
+        bool               bottomField,
+        const std::string &filePath);
+
     virtual MOS_USER_FEATURE_VALUE_ID SetOutputPathKey()  = 0;
     virtual MOS_USER_FEATURE_VALUE_ID InitDefaultOutput() = 0;
 
-    std::string          m_outputFileName;
-    MediaDebugConfigMgr *m_configMgr = nullptr;
+    std::string            m_outputFileName;
+    MediaDebugConfigMgr *  m_configMgr   = nullptr;
+    MediaDebugAsyncWriter *m_asyncWriter = nullptr;  //!< Writes dumps on a background thread when AsyncDump is enabled
 };
 
 #else
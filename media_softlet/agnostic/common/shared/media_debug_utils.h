@@ -39,9 +39,11 @@ typedef CODECHAL_MEDIA_STATE_TYPE MEDIA_DEBUG_STATE_TYPE;
 namespace MediaDbgAttr
 {
 //Common Attr
-static const char *attrDumpBufferInBinary = "DumpBufferInBinary";
-static const char *attrDumpToThreadFolder = "DumpToThreadFolder";
-static const char *attrDumpCmdBufInBinary = "DumpCmdBufInBinary";
+static const char *attrDumpBufferInBinary  = "DumpBufferInBinary";
+static const char *attrDumpToThreadFolder  = "DumpToThreadFolder";
+static const char *attrDumpCmdBufInBinary  = "DumpCmdBufInBinary";
+static const char *attrAsyncDump           = "AsyncDump";  // value is the max number of queued dumps
+static const char *attrAsyncDumpDropOnFull = "AsyncDumpDropOnFull";
 
 //Codec Attr 
 static const char *attrPicParams              = "PicParams";
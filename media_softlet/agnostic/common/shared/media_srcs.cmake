@@ -36,6 +36,7 @@ media_include_subdirectory(profiler)
 
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
+    ${CMAKE_CURRENT_LIST_DIR}/media_debug_async_writer.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_config_manager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_interface.cpp
 )
@@ -46,6 +47,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_common_defs.h
     ${CMAKE_CURRENT_LIST_DIR}/media_factory.h
     ${CMAKE_CURRENT_LIST_DIR}/media_capstable.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_debug_async_writer.h
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_config_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_interface.h
     ${CMAKE_CURRENT_LIST_DIR}/media_debug_utils.h
@@ -60,6 +60,10 @@ MediaContext::MediaContext(uint8_t componentType, void *hwInterface, PMOS_INTERF
 
     m_streamId = m_osInterface->streamIndex;
     m_gpuContextAttributeTable.clear();
+    for (auto &funcIndex : m_gpuContextAttributeIndex)
+    {
+        funcIndex.clear();
+    }
 }
 
 MediaContext::~MediaContext()
@@ -138,6 +142,10 @@ MediaContext::~MediaContext()
     }
 
     m_gpuContextAttributeTable.clear();
+    for (auto &funcIndex : m_gpuContextAttributeIndex)
+    {
+        funcIndex.clear();
+    }
 }
 
 MOS_STATUS MediaContext::SwitchContext(MediaFunction func, ContextRequirement *requirement, MediaScalability **scalabilityState)
@@ -221,36 +229,39 @@ MOS_STATUS MediaContext::SearchContext(MediaFunction func, T params, uint32_t& i
     MOS_OS_CHK_NULL_RETURN(m_osInterface);
 
     indexFound = m_invalidContextAttribute;
-    uint32_t index = 0;
 
-    for (auto& curAttribute : m_gpuContextAttributeTable)
+    if (func >= INVALID_MEDIA_FUNCTION)
     {
-        if (curAttribute.func == func)
+        MOS_OS_ASSERTMESSAGE("Func required is invalid");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    // Scalability options are matched by the scalability state (e.g. any entry matches an mdf request),
+    // so only the media function is indexed and its entries are still compared in table order
+    for (auto index : m_gpuContextAttributeIndex[func])
+    {
+        auto &curAttribute = m_gpuContextAttributeTable[index];
+        MOS_OS_CHK_NULL_RETURN(curAttribute.scalabilityState);
+
+        if (curAttribute.scalabilityState->IsScalabilityModeMatched(params))
         {
-            MOS_OS_CHK_NULL_RETURN(curAttribute.scalabilityState);
+            // Found the matching GPU context and scalability state
+            indexFound = index;
 
-            if (curAttribute.scalabilityState->IsScalabilityModeMatched(params))
+            // Be compatible to legacy MOS
+            MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnSetGpuContextHandle(m_osInterface, curAttribute.gpuContext, curAttribute.ctxForLegacyMos));
+            // set legacy MOS ve interface to current reused scalability state's ve interface
+            m_osInterface->pVEInterf = curAttribute.scalabilityState->m_veInterface;
+            if (m_osInterface->apoMosEnabled)
             {
-                // Found the matching GPU context and scalability state
-                indexFound = index;
-
-                // Be compatible to legacy MOS
-                MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnSetGpuContextHandle(m_osInterface, curAttribute.gpuContext, curAttribute.ctxForLegacyMos));
-                // set legacy MOS ve interface to current reused scalability state's ve interface
-                m_osInterface->pVEInterf = curAttribute.scalabilityState->m_veInterface;
-                if (m_osInterface->apoMosEnabled)
+                if (curAttribute.scalabilityState->m_veState)
                 {
-                    if (curAttribute.scalabilityState->m_veState)
-                    {
-                        MOS_OS_CHK_STATUS_RETURN(MosInterface::SetVirtualEngineState(
-                            m_osInterface->osStreamState, curAttribute.scalabilityState->m_veState));
-                    }
+                    MOS_OS_CHK_STATUS_RETURN(MosInterface::SetVirtualEngineState(
+                        m_osInterface->osStreamState, curAttribute.scalabilityState->m_veState));
                 }
-                break;
             }
+            break;
         }
-
-        index++;
     }
 
     return MOS_STATUS_SUCCESS;
@@ -313,6 +324,7 @@ MOS_STATUS MediaContext::CreateContext(MediaFunction func, T params, uint32_t& i
     // Add entry to the table
     indexReturn = m_gpuContextAttributeTable.size();
     m_gpuContextAttributeTable.push_back(newAttr);
+    m_gpuContextAttributeIndex[func].push_back(indexReturn);
 
     return MOS_STATUS_SUCCESS;
 }
@@ -125,6 +125,7 @@ protected:
     uint32_t                          m_streamId                = m_invalidStreamId; //!< Stream id of this media context
 
     std::vector<GpuContextAttribute>  m_gpuContextAttributeTable;                    //!< Gpu Context Attribute Table to store the contexts to reuse
+    std::vector<uint32_t>             m_gpuContextAttributeIndex[MediaFuncMax];      //!< Table indices per media function, in table order
 
     static const uint32_t             m_invalidContextAttribute = 0xffffffdf;        //!< Index value to indicate invalid Context Attribute
     static const uint32_t             m_invalidStreamId         = 0xffffffcb;        //!< Id to indicate invalid Stream
@@ -132,6 +133,7 @@ protected:
 
     //!
     //! \brief  Search the ContextAttributeTable to reuse or create gpu Context and scalabilty state meeting the requirements
+    //! \detail Only the entries of the media function are compared, first match in table order wins
     //! \param  [in] func
     //!         Indicate the media function of the context
     //! \param  [in] params
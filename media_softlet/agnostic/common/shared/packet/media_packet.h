@@ -46,13 +46,10 @@
     }                                                                                   \
     if (m_featureManager)                                                               \
     {                                                                                   \
-        for (auto feature : *m_featureManager)                                          \
+        for (auto setting : m_featureManager->template GetParSettings<setting_t>())     \
         {                                                                               \
-            p = dynamic_cast<const setting_t *>(feature);                               \
-            if (p)                                                                      \
-            {                                                                           \
-                MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                       \
-            }                                                                           \
+            p = static_cast<const setting_t *>(setting);                                \
+            MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                           \
         }                                                                               \
     }
 
@@ -163,6 +160,17 @@ public:
         return m_task;
     }
 
+    //!
+    //! \brief  Indicates whether the packet can be recorded and submitted together with later frames
+    //! \details Packet which locks resources by CPU or checks status during submit is not batchable
+    //! \return bool
+    //!         true if batchable, else false
+    //!
+    virtual bool IsBatchable()
+    {
+        return false;
+    }
+
 
     //!
     //! \brief  Dump output resources or infomation after submit
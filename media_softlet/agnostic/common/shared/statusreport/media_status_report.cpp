@@ -49,43 +49,51 @@ MOS_STATUS MediaStatusReport::GetAddress(uint32_t statusReportType, PMOS_RESOURC
     return eStatus;
 }
 
-MOS_STATUS MediaStatusReport::GetReport(uint16_t requireNum, void *status)
+thread_local const MediaStatusReport *MediaStatusReport::m_parsingReport = nullptr;
+thread_local uint32_t                 MediaStatusReport::m_parsingIndex  = 0;
 
+MOS_STATUS MediaStatusReport::GetReport(uint16_t requireNum, void *status)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
-    uint32_t completedCount = *m_completedCount;
-    uint32_t reportedCount = m_reportedCount;
-    uint32_t reportedCountOrigin = m_reportedCount;
-    uint32_t availableCount = m_submittedCount - reportedCount;
-    uint32_t generatedReportCount = 0;
-    uint32_t reportIndex = 0;
-    bool reverseOrder = (requireNum > 1);
+    if (m_completedCount == nullptr || status == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
 
-    while (reportedCount != completedCount && generatedReportCount < requireNum){
+    uint32_t completedCount = GetCompletedCount();
+    uint32_t reportedCount  = m_reportedCount.load(std::memory_order_acquire);
+    uint32_t claimedNum     = 0;
 
+    // Claim all newly completed entries, up to requireNum, for this caller
+    do
+    {
+        claimedNum = MOS_MIN(completedCount - reportedCount, (uint32_t)requireNum);
+    } while (claimedNum > 0 &&
+             !m_reportedCount.compare_exchange_weak(reportedCount, reportedCount + claimedNum, std::memory_order_acq_rel));
+
+    uint32_t availableCount = m_submittedCount.load(std::memory_order_acquire) - reportedCount;
+    bool     reverseOrder   = (requireNum > 1);
+
+    m_parsingReport = this;
+    for (uint32_t i = 0; i < claimedNum; i++)
+    {
         // Get reverse order index to temporally fix application get status report size bigger than 2 case.
-        reportIndex = reverseOrder ? CounterToIndex(completedCount + reportedCountOrigin - reportedCount -1) :
-                                     CounterToIndex(reportedCount);
-        // m_reportedCount is used by component. Need to assign actual index before call ParseStatus
-        m_reportedCount = reportIndex;
-        eStatus = ParseStatus(((uint8_t*)status + m_sizeOfReport * generatedReportCount), reportIndex);
-
-        reportedCount++;
-        generatedReportCount++;
+        uint32_t reportIndex = reverseOrder ? CounterToIndex(reportedCount + claimedNum - 1 - i) :
+                                              CounterToIndex(reportedCount + i);
+        // Observers query the reported count to get the index being parsed
+        m_parsingIndex = reportIndex;
+        eStatus = ParseStatus(((uint8_t *)status + m_sizeOfReport * i), reportIndex);
     }
-    if (generatedReportCount < requireNum)
+    m_parsingReport = nullptr;
+
+    for (uint32_t i = claimedNum; i < requireNum; i++)
     {
-        for (auto i = generatedReportCount; i < requireNum; i++)
-        {
-            eStatus = SetStatus(((uint8_t *)status + m_sizeOfReport * i),
-                                CounterToIndex(reportedCount),
-                                i >= availableCount);
-        }
+        eStatus = SetStatus(((uint8_t *)status + m_sizeOfReport * i),
+                            CounterToIndex(reportedCount + claimedNum),
+                            i >= availableCount);
     }
 
-    m_reportedCount = reportedCount;
-
     return eStatus;
 }
 
@@ -93,6 +101,7 @@ MOS_STATUS MediaStatusReport::RegistObserver(MediaStatusReportObserver *observer
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
     std::vector<MediaStatusReportObserver *>::iterator it;
+    std::lock_guard<std::mutex> lock(m_observerMutex);
 
     it = std::find(m_completeObservers.begin(), m_completeObservers.end(), observer);
     if (it != m_completeObservers.end())
@@ -110,6 +119,7 @@ MOS_STATUS MediaStatusReport::UnregistObserver(MediaStatusReportObserver *observ
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
     std::vector<MediaStatusReportObserver *>::iterator it;
+    std::lock_guard<std::mutex> lock(m_observerMutex);
 
     it = std::find(m_completeObservers.begin(), m_completeObservers.end(), observer);
     if (it == m_completeObservers.end())
@@ -126,15 +136,17 @@ MOS_STATUS MediaStatusReport::UnregistObserver(MediaStatusReportObserver *observ
 MOS_STATUS MediaStatusReport::NotifyObservers(void *mfxStatus, void *rcsStatus, void *statusReport)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
-    std::vector<MediaStatusReportObserver *>::iterator it;
+    std::vector<MediaStatusReportObserver *> observers;
 
-    for (it = m_completeObservers.begin(); it != m_completeObservers.end(); it++)
     {
-        eStatus = (*it)->Completed(mfxStatus, rcsStatus, statusReport);
+        std::lock_guard<std::mutex> lock(m_observerMutex);
+        observers = m_completeObservers;
+    }
+
+    for (auto observer : observers)
+    {
+        eStatus = observer->Completed(mfxStatus, rcsStatus, statusReport);
     }
 
     return eStatus;
 }
-
-
-
@@ -27,6 +27,8 @@
 #ifndef __MEDIA_STATUS_REPORT_H__
 #define __MEDIA_STATUS_REPORT_H__
 
+#include <atomic>
+#include <mutex>
 #include "mos_os_specific.h"
 #include "media_status_report_observer.h"
 
@@ -86,6 +88,9 @@ public:
     virtual MOS_STATUS Reset() = 0;
     //!
     //! \brief  The entry to get status report.
+    //! \details Safe to be called from several threads. Each caller claims a
+    //!          batch of completed entries with a CAS on the reported count and
+    //!          parses the whole batch in one pass without taking a lock.
     //! \param  [in] numStatus
     //!         The requested number of status reports
     //! \param  [out] status
@@ -112,7 +117,7 @@ public:
     //! \brief  Get submitted count of status report.
     //! \return m_submittedCount
     //!
-    uint32_t GetSubmittedCount() const { return m_submittedCount; }
+    uint32_t GetSubmittedCount() const { return m_submittedCount.load(std::memory_order_acquire); }
 
     //!
     //! \brief  Get completed count of status report.
@@ -124,14 +129,19 @@ public:
         {
             return 0;
         } 
-        return (*m_completedCount); 
+        return *(volatile uint32_t *)m_completedCount;
     }
 
     //!
     //! \brief  Get reported count of status report.
+    //! \details While called from an observer during ParseStatus, returns the
+    //!          index of the entry being parsed on the calling thread.
     //! \return m_reportedCount
     //!
-    uint32_t GetReportedCount() const { return m_reportedCount; }
+    uint32_t GetReportedCount() const
+    {
+        return m_parsingReport == this ? m_parsingIndex : m_reportedCount.load(std::memory_order_acquire);
+    }
 
     uint32_t GetIndex(uint32_t count) { return CounterToIndex(count); }
     //!
@@ -174,6 +184,8 @@ protected:
     virtual MOS_STATUS SetStatus(void *report, uint32_t index, bool outOfRange = false) = 0;
     //!
     //! \brief  Notify observers that the frame has been completed.
+    //! \details The observer list is copied under m_observerMutex and the
+    //!          observers are called after the mutex is released.
     //! \param  [in] statusBuffer
     //!         The point to status buffer
     //! \param  [in,out] statusReport
@@ -190,15 +202,19 @@ protected:
 
     static const uint32_t m_statusNum        = 512;
 
-    PMOS_RESOURCE    m_completedCountBuf     = nullptr;
-    uint32_t         *m_completedCount       = nullptr;
-    uint32_t         m_submittedCount        = 0;
-    uint32_t         m_reportedCount         = 0;
-    uint32_t         m_sizeOfReport          = 0;
+    PMOS_RESOURCE           m_completedCountBuf = nullptr;
+    uint32_t                *m_completedCount   = nullptr;
+    std::atomic<uint32_t>   m_submittedCount{0};    //!< Only advanced by the submission thread
+    std::atomic<uint32_t>   m_reportedCount{0};     //!< Claimed by status query threads with CAS
+    uint32_t                m_sizeOfReport      = 0;
 
     StatusBufAddr    *m_statusBufAddr        = nullptr;
 
     std::vector<MediaStatusReportObserver *>  m_completeObservers;
+    std::mutex                                m_observerMutex;
+
+    static thread_local const MediaStatusReport *m_parsingReport;   //!< Report being parsed on this thread
+    static thread_local uint32_t                 m_parsingIndex;    //!< Index being parsed on this thread
 };
 
 #endif // !__MEDIA_STATUS_REPORT_H__
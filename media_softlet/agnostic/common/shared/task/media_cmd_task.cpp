@@ -28,6 +28,7 @@
 #include "media_cmd_task.h"
 #include "media_packet.h"
 #include "media_utils.h"
+#include "mos_cpu_profiler.h"
 
 CmdTask::CmdTask(PMOS_INTERFACE osInterface)
     : m_osInterface(osInterface)
@@ -72,6 +73,16 @@ MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability,
     bool singleTaskPhaseSupportedInPak = false;
     MEDIA_CHK_STATUS_RETURN(CalculateCmdBufferSizeFromActivePackets());
 
+    if (m_pendingCount > 0 && !IsPendingSpaceAvailable(scalability))
+    {
+        // The pending command buffer can not be resized, so it is submitted and the packets start a new one
+        std::vector<PacketProperty> packets;
+        packets.swap(m_packets);
+        MOS_STATUS status = SubmitPending();
+        packets.swap(m_packets);
+        MEDIA_CHK_STATUS_RETURN(status);
+    }
+
     // prepare cmd buffer
     MOS_COMMAND_BUFFER cmdBuffer;
     // initialize the command buffer struct
@@ -83,7 +94,10 @@ MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability,
 
         // VerifyCmdBuffer could be called for duplicated times for singleTaskPhase mult-pass cases
         // Each task submit verify only once
-        MEDIA_CHK_STATUS_RETURN(scalability->VerifyCmdBuffer(m_cmdBufSize, m_patchListSize, singleTaskPhaseSupportedInPak));
+        MEDIA_CHK_STATUS_RETURN(scalability->VerifyCmdBuffer(
+            m_pendingCmdBufSize + m_cmdBufSize,
+            m_pendingPatchListSize + m_patchListSize,
+            singleTaskPhaseSupportedInPak));
     }
     else
     {
@@ -118,15 +132,38 @@ MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability,
 
         curPipe = scalability->GetCurrentPipe();
 
-        MEDIA_CHK_STATUS_RETURN(packet->Submit(&cmdBuffer, packetPhase));
+        {
+            MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_PACKET_SUBMIT);
+            MEDIA_CHK_STATUS_RETURN(packet->Submit(&cmdBuffer, packetPhase));
+        }
 
         MEDIA_CHK_STATUS_RETURN(scalability->ReturnCmdBuffer(&cmdBuffer));
     }
 
+    if (!immediateSubmit)
+    {
+        // Keep the command sequence in the command buffer, later packets are appended to it.
+        // Packet outputs are not dumped since the commands have not been executed.
+        m_pendingScalability    = scalability;
+        m_pendingDebugInterface = debugInterface;
+        m_pendingCmdBufSize    += m_cmdBufSize;
+        m_pendingPatchListSize += m_patchListSize;
+        m_pendingCount++;
+        m_packets.clear();
+        return MOS_STATUS_SUCCESS;
+    }
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     MEDIA_CHK_STATUS_RETURN(DumpCmdBufferAllPipes(&cmdBuffer, debugInterface, scalability));
 #endif  // _DEBUG || _RELEASE_INTERNAL
 
+    // the pending command sequence is submitted together with the packets
+    m_pendingScalability    = nullptr;
+    m_pendingDebugInterface = nullptr;
+    m_pendingCmdBufSize     = 0;
+    m_pendingPatchListSize  = 0;
+    m_pendingCount          = 0;
+
     // submit cmd buffer
     MEDIA_CHK_STATUS_RETURN(scalability->SubmitCmdBuffer(&cmdBuffer));
 
@@ -147,6 +184,55 @@ MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability,
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS CmdTask::SubmitPending()
+{
+    // Packets being added belong to the Submit() call which will submit them
+    if (m_pendingCount == 0 || !m_packets.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MediaScalability *scalability = m_pendingScalability;
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    MOS_COMMAND_BUFFER cmdBuffer;
+    MOS_ZeroMemory(&cmdBuffer, sizeof(MOS_COMMAND_BUFFER));
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MEDIA_CHK_STATUS_RETURN(DumpCmdBufferAllPipes(&cmdBuffer, m_pendingDebugInterface, scalability));
+#endif  // _DEBUG || _RELEASE_INTERNAL
+
+    m_pendingScalability    = nullptr;
+    m_pendingDebugInterface = nullptr;
+    m_pendingCmdBufSize     = 0;
+    m_pendingPatchListSize  = 0;
+    m_pendingCount          = 0;
+
+    return scalability->SubmitCmdBuffer(&cmdBuffer);
+}
+
+bool CmdTask::IsPendingSpaceAvailable(MediaScalability *scalability)
+{
+    if (m_osInterface == nullptr || scalability != m_pendingScalability)
+    {
+        return false;
+    }
+
+    // Only check the sizes, resizing would not grow the command buffer already in use
+    if (m_osInterface->pfnVerifyCommandBufferSize(m_osInterface, m_pendingCmdBufSize + m_cmdBufSize, 0) != MOS_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    if (m_patchListSize > 0 &&
+        m_osInterface->pfnVerifyPatchListSize(m_osInterface, m_pendingPatchListSize + m_patchListSize) != MOS_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    return true;
+}
+
 #if (_DEBUG || _RELEASE_INTERNAL)
 MOS_STATUS CmdTask::DumpCmdBuffer(PMOS_COMMAND_BUFFER cmdBuffer, CodechalDebugInterface *debugInterface, uint8_t pipeIdx)
 {
@@ -45,6 +45,10 @@ public:
 
     virtual MOS_STATUS Submit(bool immediateSubmit, MediaScalability *scalability, CodechalDebugInterface *debugInterface) override;
 
+    virtual MOS_STATUS SubmitPending() override;
+
+    virtual uint32_t GetPendingCount() override { return m_pendingCount; }
+
 protected:
 #if (_DEBUG || _RELEASE_INTERNAL)
     virtual MOS_STATUS DumpCmdBuffer(PMOS_COMMAND_BUFFER cmdBuffer, CodechalDebugInterface *debugInterface, uint8_t pipeIdx = 0);
@@ -58,8 +62,22 @@ protected:
     //!
     MOS_STATUS CalculateCmdBufferSizeFromActivePackets();
 
+    //! \brief  Check whether the active packets fit in the command buffer after the pending command sequence
+    //! \param  [in] scalability
+    //!         Media scalability state instance for task submit
+    //! \return bool
+    //!         true if the active packets can be appended to the pending command sequence
+    //!
+    bool IsPendingSpaceAvailable(MediaScalability *scalability);
+
     PMOS_INTERFACE m_osInterface = nullptr;        //!< PMOS_INTERFACE
 
+    MediaScalability       *m_pendingScalability    = nullptr;  //!< Scalability state holding the pending command sequence
+    CodechalDebugInterface *m_pendingDebugInterface = nullptr;  //!< Debug interface for the pending command sequence
+    uint32_t                m_pendingCount          = 0;        //!< Submit() calls built but not submitted
+    uint32_t                m_pendingCmdBufSize     = 0;        //!< Cmd buffer size used by the pending command sequence
+    uint32_t                m_pendingPatchListSize  = 0;        //!< Patch list size used by the pending command sequence
+
 };
 
 
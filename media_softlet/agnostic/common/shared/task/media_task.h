@@ -78,6 +78,20 @@ public:
     //!
     virtual MOS_STATUS Clear();
 
+    //!
+    //! \brief  Submit the command sequence built by earlier Submit() calls without immediate submission
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS SubmitPending() { return MOS_STATUS_SUCCESS; }
+
+    //!
+    //! \brief  Get the number of Submit() calls whose command sequence is built but not submitted
+    //! \return uint32_t
+    //!         Number of pending submissions
+    //!
+    virtual uint32_t GetPendingCount() { return 0; }
+
     virtual void SetupCmdBufSize(uint32_t cmdBufSize, uint32_t patchListSize)
     { 
         m_cmdBufSize = cmdBufSize;
@@ -597,11 +597,17 @@ bool VPFeatureManager::IsSfcOutputFeasible(PVP_PIPELINE_PARAMS params)
     if (MEDIA_IS_SKU(m_hwInterface->m_skuTable, FtrSFCPipe))
     {
         // Read user feature key to Disable SFC
+        if (m_disableSfcSettingId == MediaUserSetting::InvalidSettingId)
+        {
+            m_disableSfcSettingId = GetUserSettingId(
+                m_userSettingPtr,
+                __VPHAL_VEBOX_DISABLE_SFC,
+                MediaUserSetting::Group::Sequence);
+        }
         ReadUserSetting(
             m_userSettingPtr,
             disableSFC,
-            __VPHAL_VEBOX_DISABLE_SFC,
-            MediaUserSetting::Group::Sequence);
+            m_disableSfcSettingId);
 
         if (disableSFC)
         {
@@ -166,6 +166,7 @@ protected:
 protected:
     PVP_MHWINTERFACE        m_hwInterface       = nullptr;
     PMOS_INTERFACE          m_pOsInterface      = nullptr;
+    MediaUserSetting::SettingId m_disableSfcSettingId = MediaUserSetting::InvalidSettingId;  //!< read once per frame, looked up on first use
 
 MEDIA_CLASS_DEFINE_END(VPFeatureManager)
 };
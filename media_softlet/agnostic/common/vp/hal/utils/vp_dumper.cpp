@@ -1106,7 +1106,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
 
                 VpDumperTool::GetOsFilePath(sPlanePath, sPlaneOsPath);
 
-                VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sPlaneOsPath, pDst + dstPlaneOffset[j], dstPlaneOffset[j + 1]));
+                VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sPlaneOsPath, pDst + dstPlaneOffset[j], dstPlaneOffset[j + 1]));
             }
             else
             {
@@ -1115,7 +1115,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
         }
     }
 
-    VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sOsPath, pDst, dwSize));
+    VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sOsPath, pDst, dwSize));
 
 #if !EMUL
     // Dump Aux surface data
@@ -1175,7 +1175,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
             auxDataY,
             auxSizeY);
 
-        VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sOsPath, pDstAux, auxSizeY));
+        VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sOsPath, pDstAux, auxSizeY));
         MOS_SafeFreeMemory(pDstAux);
 
         if (auxSizeUV && isPlanar)
@@ -1203,7 +1203,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
                 auxDataUV,
                 auxSizeUV);
 
-            VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sOsPath, pDstUVAux, auxSizeUV));
+            VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sOsPath, pDstUVAux, auxSizeUV));
             MOS_SafeFreeMemory(pDstUVAux);
         }
     }
@@ -1399,7 +1399,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
 
                 VpDumperTool::GetOsFilePath(sPlanePath, sPlaneOsPath);
 
-                VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sPlaneOsPath, pDst + dstPlaneOffset[j], dstPlaneOffset[j + 1]));
+                VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sPlaneOsPath, pDst + dstPlaneOffset[j], dstPlaneOffset[j + 1]));
             }
             else
             {
@@ -1408,7 +1408,7 @@ MOS_STATUS VpSurfaceDumper::DumpSurfaceToFile(
         }
     }
 
-    VPHAL_DEBUG_CHK_STATUS(MosUtilities::MosWriteFileFromPtr(sOsPath, pDst, dwSize));
+    VPHAL_DEBUG_CHK_STATUS(WriteDumpFile(sOsPath, pDst, dwSize));
 
 finish:
     MOS_SafeFreeMemory(pDst);
@@ -1853,6 +1853,20 @@ void VpSurfaceDumper::GetSurfaceDumpSpec()
         m_osInterface->pOsContext));
     pDumpSpec->enablePlaneDump = UserFeatureData.u32Data;
 
+    // Get async dump queue depth
+    MOS_ZeroMemory(&UserFeatureData, sizeof(UserFeatureData));
+    MOS_USER_FEATURE_INVALID_KEY_ASSERT(MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __VPHAL_DBG_SURF_DUMP_ASYNC_QUEUE_DEPTH_ID,
+        &UserFeatureData,
+        m_osInterface->pOsContext));
+    pDumpSpec->asyncDumpQueueDepth = UserFeatureData.u32Data;
+
+    if (bDumpEnabled && pDumpSpec->asyncDumpQueueDepth > 0 && m_asyncWriter == nullptr)
+    {
+        m_asyncWriter = MOS_New(MediaDebugAsyncWriter, pDumpSpec->asyncDumpQueueDepth, false);
+    }
+
 finish:
     if ((eStatus != MOS_STATUS_SUCCESS) || (!bDumpEnabled))
     {
@@ -1864,9 +1878,27 @@ finish:
 
 VpSurfaceDumper::~VpSurfaceDumper()
 {
+    // Write out all queued dumps before the dumper goes away
+    MOS_Delete(m_asyncWriter);
     MOS_SafeFreeMemory(m_dumpSpec.pDumpLocations);
 }
 
+MOS_STATUS VpSurfaceDumper::WriteDumpFile(
+    const char                      *filePath,
+    uint8_t                         *data,
+    uint32_t                        size)
+{
+    VP_DEBUG_CHK_NULL_RETURN(filePath);
+    VP_DEBUG_CHK_NULL_RETURN(data);
+
+    if (m_asyncWriter)
+    {
+        return m_asyncWriter->SubmitBinaryFile(filePath, data, size);
+    }
+
+    return MosUtilities::MosWriteFileFromPtr(filePath, data, size);
+}
+
 
 MOS_STATUS VpSurfaceDumper::DumpSurface(
     PVPHAL_SURFACE                  pSurf,
@@ -35,6 +35,8 @@
 #include "mhw_vebox.h"
 #include "vp_common.h"       // Common interfaces and structures
 #include "vp_pipeline_common.h"
+#include "media_debug_interface.h"
+#include "media_debug_async_writer.h"
 
 #if !defined(LINUX) && !defined(ANDROID)
 #include "UmdStateSeparation.h"
@@ -194,6 +196,7 @@ struct VPHAL_SURF_DUMP_SPEC
     int32_t                       iNumDumpLocs;                                 //!< Number of pipe stage dump locations
     bool                          enableAuxDump;                                //!< Enable aux data dump for compressed surface
     bool                          enablePlaneDump;                              //!< Enable surface dump by plane
+    uint32_t                      asyncDumpQueueDepth;                          //!< Max dumps queued for the background writer, 0 writes synchronously
 };
 
 //!
@@ -387,7 +390,26 @@ protected:
     bool HasAuxSurf(
         PMOS_RESOURCE                   osResource);
 
+    //!
+    //! \brief    Write dump data to a file
+    //! \details  Queued to the background writer when async dump is enabled,
+    //!           data may be released by caller once the function returns
+    //! \param    [in] filePath
+    //!           Path of the file to be written
+    //! \param    [in] data
+    //!           Pointer to the data
+    //! \param    [in] size
+    //!           Size of the data
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS WriteDumpFile(
+        const char                      *filePath,
+        uint8_t                         *data,
+        uint32_t                        size);
+
     PMOS_INTERFACE              m_osInterface;
+    MediaDebugAsyncWriter      *m_asyncWriter = nullptr;    // Writes dumps on a background thread when asyncDumpQueueDepth is set
     char                        m_dumpPrefix[MAX_PATH];     // Called frequently, so avoid repeated stack resizing with member data
     char                        m_dumpLoc[MAX_PATH];        // to avoid recursive call from diff owner but sharing the same buffer
 
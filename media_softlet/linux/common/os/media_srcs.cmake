@@ -29,6 +29,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_specific_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_trace_ring_specific.cpp
 )
 
 set(TMP_HEADERS_
@@ -41,6 +42,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_specific_next.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.h
     ${CMAKE_CURRENT_LIST_DIR}/media_skuwa_specific.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_trace_ring_specific.h
 )
 
 if(${Media_Scalability_Supported} STREQUAL "yes")
@@ -24,6 +24,7 @@
 //! \brief   Container class for the Linux specific gpu context
 //!
 #include "mos_gpucontext_specific_next.h"
+#include "mos_cpu_profiler.h"
 #include "mos_context_specific_next.h"
 #include "mos_graphicsresource_specific_next.h"
 #include "mos_commandbuffer_specific_next.h"
@@ -146,6 +147,9 @@ MOS_STATUS GpuContextSpecificNext::Init(OsContextNext *osContext,
     m_attachedResources = (PMOS_RESOURCE)MOS_AllocAndZeroMemory(sizeof(MOS_RESOURCE) * ALLOCATIONLIST_SIZE);
     MOS_OS_CHK_NULL_RETURN(m_attachedResources);
 
+    m_attachedBos = (MOS_LINUX_BO **)MOS_AllocAndZeroMemory(sizeof(MOS_LINUX_BO *) * ALLOCATIONLIST_SIZE);
+    MOS_OS_CHK_NULL_RETURN(m_attachedBos);
+
     m_writeModeList = (bool *)MOS_AllocAndZeroMemory(sizeof(bool) * ALLOCATIONLIST_SIZE);
     MOS_OS_CHK_NULL_RETURN(m_writeModeList);
 
@@ -443,6 +447,7 @@ void GpuContextSpecificNext::Clear()
     MOS_SafeFreeMemory(m_allocationList);
     MOS_SafeFreeMemory(m_patchLocationList);
     MOS_SafeFreeMemory(m_attachedResources);
+    MOS_SafeFreeMemory(m_attachedBos);
     MOS_SafeFreeMemory(m_writeModeList);
     MOS_SafeFreeMemory(m_createOptionEnhanced);
 
@@ -467,13 +472,14 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
     MOS_OS_CHK_NULL_RETURN(osResource);
 
     MOS_OS_CHK_NULL_RETURN(m_attachedResources);
+    MOS_OS_CHK_NULL_RETURN(m_attachedBos);
 
-    PMOS_RESOURCE registeredResources = m_attachedResources;
-    uint32_t      allocationIndex     = 0;
+    uint32_t allocationIndex = 0;
 
-    for ( allocationIndex = 0; allocationIndex < m_resCount; allocationIndex++, registeredResources++)
+    // Scan the packed bo list rather than the much larger resource copies
+    for (allocationIndex = 0; allocationIndex < m_resCount; allocationIndex++)
     {
-        if (osResource->bo == registeredResources->bo)
+        if (osResource->bo == m_attachedBos[allocationIndex])
         {
             break;
         }
@@ -497,6 +503,7 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
 
         osResource->iAllocationIndex[m_gpuContext] = (allocationIndex);
         m_attachedResources[allocationIndex]           = *osResource;
+        m_attachedBos[allocationIndex]                 = osResource->bo;
         m_writeModeList[allocationIndex] |= writeFlag;
         m_allocationList[allocationIndex].hAllocation = &m_attachedResources[allocationIndex];
         m_allocationList[allocationIndex].WriteOperation |= writeFlag;
@@ -528,6 +535,37 @@ MOS_STATUS GpuContextSpecificNext::SetPatchEntry(
     m_patchLocationList[m_currentNumPatchLocations].cmdBo            =
                 params->cmdBuffer != nullptr ? params->cmdBuffer->OsResource.bo : nullptr;
 
+    // Group patches by the command buffer they are written to, so that the
+    // per command buffer work in SubmitCommandBuffer is done once per bucket.
+    // Patches of one command buffer are added back to back, check the last bucket first.
+    auto     cmdBo       = m_patchLocationList[m_currentNumPatchLocations].cmdBo;
+    uint32_t bucketIndex = m_numPatchBuckets;
+    if (m_numPatchBuckets > 0 && m_patchBuckets[m_numPatchBuckets - 1].cmdBo == cmdBo)
+    {
+        bucketIndex = m_numPatchBuckets - 1;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < m_numPatchBuckets; i++)
+        {
+            if (m_patchBuckets[i].cmdBo == cmdBo)
+            {
+                bucketIndex = i;
+                break;
+            }
+        }
+    }
+    if (bucketIndex == m_numPatchBuckets)
+    {
+        if (m_numPatchBuckets == m_patchBuckets.size())
+        {
+            m_patchBuckets.emplace_back();
+        }
+        m_patchBuckets[bucketIndex].cmdBo = cmdBo;
+        m_numPatchBuckets++;
+    }
+    m_patchBuckets[bucketIndex].patchIndexes.push_back(m_currentNumPatchLocations);
+
     if (streamState->osCpInterface &&
         streamState->osCpInterface->IsHMEnabled())
     {
@@ -1011,15 +1049,22 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
     std::vector<PMOS_RESOURCE> mappedResList;
     std::vector<MOS_LINUX_BO *> skipSyncBoList;
 
+    // Offsets of non softpin bos recorded for this context, looked up by target bo.
+    // Built on first use since most platforms softpin every bo.
+    std::unordered_map<MOS_LINUX_BO *, uint64_t> contextOffsets;
+    bool                                         contextOffsetsBuilt = false;
+
     // Now, the patching will be done, based on the patch list.
-    for (uint32_t patchIndex = 0; patchIndex < m_currentNumPatchLocations; patchIndex++)
+    // Patches are bucketed by command buffer at SetPatchEntry, so the nested BB
+    // lookup, the skip sync check and softpin target registration are done
+    // once per command buffer instead of once per patch.
+    for (uint32_t bucketIndex = 0; bucketIndex < m_numPatchBuckets; bucketIndex++)
     {
-        auto currentPatch = &m_patchLocationList[patchIndex];
-        MOS_OS_CHK_NULL_RETURN(currentPatch);
-
-        auto tempCmdBo = currentPatch->cmdBo == nullptr ? cmd_bo : currentPatch->cmdBo;
+        auto &bucket    = m_patchBuckets[bucketIndex];
+        auto  tempCmdBo = bucket.cmdBo == nullptr ? cmd_bo : bucket.cmdBo;
 
         // Following are for Nested BB buffer, if it's nested BB, we need to ensure it's locked.
+        bool isSlaveCmdBuf = false;
         if (tempCmdBo != cmd_bo)
         {
             bool isSecondaryCmdBuf = false;
@@ -1029,6 +1074,7 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
                 if (it->second->OsResource.bo == tempCmdBo)
                 {
                     isSecondaryCmdBuf = true;
+                    isSlaveCmdBuf     = scalaEnabled && (it->second->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_SLAVE);
                     break;
                 }
                 it++;
@@ -1047,109 +1093,150 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
                 }
             }
         }
-
-        // This is the resource for which patching will be done
-        auto resource = (PMOS_RESOURCE)m_allocationList[currentPatch->AllocationIndex].hAllocation;
-        MOS_OS_CHK_NULL_RETURN(resource);
-
-        // For now, we'll assume the system memory's DRM bo pointer
-        // is NULL.  If nullptr is detected, then the resource has been
-        // placed inside the command buffer's indirect state area.
-        // We'll simply set alloc_bo to the command buffer's bo pointer.
-        MOS_OS_ASSERT(resource->bo);
-
-        auto alloc_bo = (resource->bo) ? resource->bo : tempCmdBo;
-
-        MOS_OS_CHK_STATUS_RETURN(streamState->osCpInterface->PermeatePatchForHM(
-            tempCmdBo->virt,
-            currentPatch,
-            resource));
-
-        uint64_t boOffset = alloc_bo->offset64;
-        if (!mos_gem_bo_is_softpin(alloc_bo))
+        else if (scalaEnabled)
         {
-            if (alloc_bo != tempCmdBo)
+            // The primary command buffer may also be registered as a secondary one
+            it = m_secondaryCmdBufs.begin();
+            while(it != m_secondaryCmdBufs.end())
             {
-                auto item_ctx = perStreamParameters->contextOffsetList.begin();
-                for (; item_ctx != perStreamParameters->contextOffsetList.end(); item_ctx++)
+                if (it->second->OsResource.bo == tempCmdBo)
                 {
-                    if (item_ctx->intel_context == perStreamParameters->intel_context && item_ctx->target_bo == alloc_bo)
-                    {
-                        boOffset = item_ctx->offset64;
-                        break;
-                    }
+                    isSlaveCmdBuf = (it->second->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_SLAVE);
+                    break;
                 }
+                it++;
             }
         }
 
-        if (perStreamParameters->bUse64BitRelocs)
+        if (!scalaEnabled)
         {
-            *((uint64_t *)((uint8_t *)tempCmdBo->virt + currentPatch->PatchOffset)) =
-                    boOffset + currentPatch->AllocationOffset;
-        }
-        else
-        {
-            *((uint32_t *)((uint8_t *)tempCmdBo->virt + currentPatch->PatchOffset)) =
-                    boOffset + currentPatch->AllocationOffset;
+            isSlaveCmdBuf = (cmdBuffer->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_SLAVE);
         }
 
-        if (scalaEnabled)
+        for (auto patchIndex : bucket.patchIndexes)
         {
-            it = m_secondaryCmdBufs.begin();
-            while(it != m_secondaryCmdBufs.end())
+            auto currentPatch = &m_patchLocationList[patchIndex];
+            MOS_OS_CHK_NULL_RETURN(currentPatch);
+
+            // This is the resource for which patching will be done
+            auto resource = (PMOS_RESOURCE)m_allocationList[currentPatch->AllocationIndex].hAllocation;
+            MOS_OS_CHK_NULL_RETURN(resource);
+
+            // For now, we'll assume the system memory's DRM bo pointer
+            // is NULL.  If nullptr is detected, then the resource has been
+            // placed inside the command buffer's indirect state area.
+            // We'll simply set alloc_bo to the command buffer's bo pointer.
+            MOS_OS_ASSERT(resource->bo);
+
+            auto alloc_bo = (resource->bo) ? resource->bo : tempCmdBo;
+
+            MOS_OS_CHK_STATUS_RETURN(streamState->osCpInterface->PermeatePatchForHM(
+                tempCmdBo->virt,
+                currentPatch,
+                resource));
+
+            uint64_t boOffset  = alloc_bo->offset64;
+            bool     isSoftpin = mos_gem_bo_is_softpin(alloc_bo);
+            if (!isSoftpin && alloc_bo != tempCmdBo)
             {
-                if (it->second->OsResource.bo == tempCmdBo &&
-                    it->second->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_SLAVE &&
-                    !mos_gem_bo_is_exec_object_async(alloc_bo))
+                if (!contextOffsetsBuilt)
                 {
-                    skipSyncBoList.push_back(alloc_bo);
-                    break;
+                    // Keep the first match to preserve the former linear search result
+                    for (auto &item_ctx : perStreamParameters->contextOffsetList)
+                    {
+                        if (item_ctx.intel_context == perStreamParameters->intel_context)
+                        {
+                            contextOffsets.emplace(item_ctx.target_bo, item_ctx.offset64);
+                        }
+                    }
+                    contextOffsetsBuilt = true;
+                }
+                auto item = contextOffsets.find(alloc_bo);
+                if (item != contextOffsets.end())
+                {
+                    boOffset = item->second;
                 }
-                it++;
             }
-        }
-        else if (cmdBuffer->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_SLAVE &&
-                 !mos_gem_bo_is_exec_object_async(alloc_bo))
-        {
-            skipSyncBoList.push_back(alloc_bo);
-        }
+
+            if (perStreamParameters->bUse64BitRelocs)
+            {
+                *((uint64_t *)((uint8_t *)tempCmdBo->virt + currentPatch->PatchOffset)) =
+                        boOffset + currentPatch->AllocationOffset;
+            }
+            else
+            {
+                *((uint32_t *)((uint8_t *)tempCmdBo->virt + currentPatch->PatchOffset)) =
+                        boOffset + currentPatch->AllocationOffset;
+            }
+
+            if (isSlaveCmdBuf && !mos_gem_bo_is_exec_object_async(alloc_bo))
+            {
+                skipSyncBoList.push_back(alloc_bo);
+            }
 
 #if (_DEBUG || _RELEASE_INTERNAL)
-        {
-            uint32_t evtData[] = {alloc_bo->handle, currentPatch->uiWriteOperation, currentPatch->AllocationOffset};
-            MOS_TraceEventExt(EVENT_MOS_BATCH_SUBMIT, EVENT_TYPE_INFO,
-                              evtData, sizeof(evtData),
-                              &boOffset, sizeof(boOffset));
-        }
+            {
+                uint32_t evtData[] = {alloc_bo->handle, currentPatch->uiWriteOperation, currentPatch->AllocationOffset};
+                MOS_TraceEventExt(EVENT_MOS_BATCH_SUBMIT, EVENT_TYPE_INFO,
+                                  evtData, sizeof(evtData),
+                                  &boOffset, sizeof(boOffset));
+            }
 #endif
 
-        if(mos_gem_bo_is_softpin(alloc_bo))
-        {
-            if (alloc_bo != tempCmdBo)
+            if (isSoftpin)
             {
-                ret = mos_bo_add_softpin_target(tempCmdBo, alloc_bo, currentPatch->uiWriteOperation);
+                // Softpin targets are added once per command buffer after all its patches are written
+                if (alloc_bo != tempCmdBo)
+                {
+                    auto target = m_softpinTargetIndex.find(alloc_bo);
+                    if (target == m_softpinTargetIndex.end())
+                    {
+                        m_softpinTargetIndex.emplace(alloc_bo, (uint32_t)m_softpinTargets.size());
+                        m_softpinTargets.emplace_back(alloc_bo, currentPatch->uiWriteOperation ? true : false);
+                    }
+                    else if (currentPatch->uiWriteOperation)
+                    {
+                        m_softpinTargets[target->second].second = true;
+                    }
+                }
+            }
+            else
+            {
+                // This call will patch the command buffer with the offsets of the indirect state region of the command buffer
+                ret = mos_bo_emit_reloc2(
+                    tempCmdBo,                                                         // Command buffer
+                    currentPatch->PatchOffset,                                         // Offset in the command buffer
+                    alloc_bo,                                                          // Allocation object for which the patch will be made.
+                    currentPatch->AllocationOffset,                                    // Offset to the indirect state
+                    I915_GEM_DOMAIN_RENDER,                                            // Read domain
+                    (currentPatch->uiWriteOperation) ? I915_GEM_DOMAIN_RENDER : 0x0,   // Write domain
+                    boOffset);
+
+                if (ret != 0)
+                {
+                    MOS_OS_ASSERTMESSAGE("Error patching alloc_bo = 0x%x, cmd_bo = 0x%x.",
+                        (uintptr_t)alloc_bo,
+                        (uintptr_t)tempCmdBo);
+                    return MOS_STATUS_UNKNOWN;
+                }
             }
-        }
-        else
-        {
-            // This call will patch the command buffer with the offsets of the indirect state region of the command buffer
-            ret = mos_bo_emit_reloc2(
-                tempCmdBo,                                                         // Command buffer
-                currentPatch->PatchOffset,                                         // Offset in the command buffer
-                alloc_bo,                                                          // Allocation object for which the patch will be made.
-                currentPatch->AllocationOffset,                                    // Offset to the indirect state
-                I915_GEM_DOMAIN_RENDER,                                            // Read domain
-                (currentPatch->uiWriteOperation) ? I915_GEM_DOMAIN_RENDER : 0x0,   // Write domain
-                boOffset);
         }
 
-        if (ret != 0)
+        for (auto &target : m_softpinTargets)
         {
-            MOS_OS_ASSERTMESSAGE("Error patching alloc_bo = 0x%x, cmd_bo = 0x%x.",
-                (uintptr_t)alloc_bo,
-                (uintptr_t)tempCmdBo);
-            return MOS_STATUS_UNKNOWN;
+            ret = mos_bo_add_softpin_target(tempCmdBo, target.first, target.second);
+            if (ret != 0)
+            {
+                MOS_OS_ASSERTMESSAGE("Error adding softpin target alloc_bo = 0x%x, cmd_bo = 0x%x.",
+                    (uintptr_t)target.first,
+                    (uintptr_t)tempCmdBo);
+                m_softpinTargets.clear();
+                m_softpinTargetIndex.clear();
+                return MOS_STATUS_UNKNOWN;
+            }
         }
+        m_softpinTargets.clear();
+        m_softpinTargetIndex.clear();
     }
 
     for(auto res: mappedResList)
@@ -1331,6 +1418,7 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
             }
             else
             {
+                MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_KMD_EXEC);
                 ret = mos_gem_bo_context_exec2(cmd_bo,
                     m_commandBufferSize,
                     m_i915Context[0],
@@ -1343,6 +1431,7 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
         }
         else
         {
+            MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_KMD_EXEC);
             ret = mos_gem_bo_context_exec2(cmd_bo,
                 m_commandBufferSize,
                 perStreamParameters->intel_context,
@@ -1398,13 +1487,12 @@ if (streamState->dumpCommandBuffer)
 #endif  //(_DEBUG || _RELEASE_INTERNAL)
 
     //clear command buffer relocations to fix memory leak issue
-    for (uint32_t patchIndex = 0; patchIndex < m_currentNumPatchLocations; patchIndex++)
+    for (uint32_t bucketIndex = 0; bucketIndex < m_numPatchBuckets; bucketIndex++)
     {
-        auto currentPatch = &m_patchLocationList[patchIndex];
-        MOS_OS_CHK_NULL_RETURN(currentPatch);
-
-        if(currentPatch->cmdBo)
-            mos_gem_bo_clear_relocs(currentPatch->cmdBo, 0);
+        if (m_patchBuckets[bucketIndex].cmdBo)
+        {
+            mos_gem_bo_clear_relocs(m_patchBuckets[bucketIndex].cmdBo, 0);
+        }
     }
 
     it = m_secondaryCmdBufs.begin();
@@ -1418,13 +1506,7 @@ if (streamState->dumpCommandBuffer)
     skipSyncBoList.clear();
 
     // Reset resource allocation
-    m_numAllocations = 0;
-    MosUtilities::MosZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * m_maxNumAllocations);
-    m_currentNumPatchLocations = 0;
-    MosUtilities::MosZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * m_maxNumAllocations);
-    m_resCount = 0;
-
-    MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * m_maxNumAllocations);
+    ResetRegistrations();
 finish:
     MOS_TraceEventExt(EVENT_MOS_BATCH_SUBMIT, EVENT_TYPE_END, &eStatus, sizeof(eStatus), nullptr, 0);
     return eStatus;
@@ -1493,14 +1575,17 @@ int32_t GpuContextSpecificNext::SubmitPipeCommands(
         queue = m_i915Context[1];
     }
 
-    ret = mos_gem_bo_context_exec2(cmdBo,
-                                  cmdBo->size,
-                                  queue,
-                                  nullptr,
-                                  0,
-                                  dr4,
-                                  execFlag | fence_flag,
-                                  &fence);
+    {
+        MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_KMD_EXEC);
+        ret = mos_gem_bo_context_exec2(cmdBo,
+                                      cmdBo->size,
+                                      queue,
+                                      nullptr,
+                                      0,
+                                      dr4,
+                                      execFlag | fence_flag,
+                                      &fence);
+    }
 
     if(cmdBuffer->iSubmissionType & SUBMISSION_TYPE_MULTI_PIPE_MASTER)
     {
@@ -1548,14 +1633,17 @@ int32_t GpuContextSpecificNext::ParallelSubmitCommands(
             fenceFlag = I915_EXEC_FENCE_OUT;
             queue = m_i915Context[0];
 
-            ret = mos_gem_bo_context_exec2(it->second->OsResource.bo,
-                                  it->second->OsResource.bo->size,
-                                  queue,
-                                  nullptr,
-                                  0,
-                                  dr4,
-                                  execFlag | fenceFlag,
-                                  &fence);
+            {
+                MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_KMD_EXEC);
+                ret = mos_gem_bo_context_exec2(it->second->OsResource.bo,
+                                      it->second->OsResource.bo->size,
+                                      queue,
+                                      nullptr,
+                                      0,
+                                      dr4,
+                                      execFlag | fenceFlag,
+                                      &fence);
+            }
 
             osContext->submit_fence = fence;
         }
@@ -1633,17 +1721,34 @@ void GpuContextSpecificNext::UpdatePriority(int32_t priority)
     m_currCtxPriority = priority;
 }
 
-void GpuContextSpecificNext::ResetGpuContextStatus()
+void GpuContextSpecificNext::ResetPatchList()
 {
-    MosUtilities::MosZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * ALLOCATIONLIST_SIZE);
+    // Keep the buckets and their storage for the next submission
+    for (uint32_t bucketIndex = 0; bucketIndex < m_numPatchBuckets; bucketIndex++)
+    {
+        m_patchBuckets[bucketIndex].cmdBo = nullptr;
+        m_patchBuckets[bucketIndex].patchIndexes.clear();
+    }
+    m_numPatchBuckets = 0;
+}
+
+void GpuContextSpecificNext::ResetRegistrations()
+{
+    MosUtilities::MosZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * m_numAllocations);
     m_numAllocations = 0;
-    MosUtilities::MosZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * PATCHLOCATIONLIST_SIZE);
+    MosUtilities::MosZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * MOS_MIN(m_currentNumPatchLocations, m_maxPatchLocationsize));
     m_currentNumPatchLocations = 0;
+    ResetPatchList();
 
-    MosUtilities::MosZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * ALLOCATIONLIST_SIZE);
+    MosUtilities::MosZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * m_resCount);
+    MosUtilities::MosZeroMemory(m_attachedBos, sizeof(MOS_LINUX_BO *) * m_resCount);
+    MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * m_resCount);
     m_resCount = 0;
+}
 
-    MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * ALLOCATIONLIST_SIZE);
+void GpuContextSpecificNext::ResetGpuContextStatus()
+{
+    ResetRegistrations();
 
     if ((m_cmdBufFlushed == true) && m_commandBuffer->OsResource.bo)
     {
@@ -30,6 +30,7 @@
 #include "mos_gpucontext_next.h"
 #include "mos_graphicsresource_specific_next.h"
 #include "mos_oca_interface_specific.h"
+#include <unordered_map>
 
 #define ENGINE_INSTANCE_SELECT_ENABLE_MASK                   0xFF
 #define ENGINE_INSTANCE_SELECT_COMPUTE_INSTANCE_SHIFT        16
@@ -208,6 +209,18 @@ protected:
     //!
     MOS_STATUS MapResourcesToAuxTable(mos_linux_bo *cmd_bo);
 
+    //!
+    //! \brief    Clear patch buckets after submission
+    //!
+    void ResetPatchList();
+
+    //!
+    //! \brief    Clear resource registrations and patch list of the current submission
+    //! \details  Entries past the registered counts are never written, so only the
+    //!           used entries are zeroed rather than the whole lists
+    //!
+    void ResetRegistrations();
+
     MOS_VDBOX_NODE_IND GetVdboxNodeId(
         PMOS_COMMAND_BUFFER cmdBuffer);
 
@@ -293,9 +306,23 @@ private:
     uint32_t           m_currentNumPatchLocations = 0; //!< number of registered patch list
     uint32_t           m_maxPatchLocationsize; //!< max number of patch list
 
+    //! \brief    Patch list indexes grouped by target command buffer bo at SetPatchEntry
+    struct PatchBucket
+    {
+        MOS_LINUX_BO          *cmdBo = nullptr;    //!< nullptr for the primary command buffer
+        std::vector<uint32_t>  patchIndexes;
+    };
+    std::vector<PatchBucket> m_patchBuckets;            //!< Buckets kept across submissions to reuse storage
+    uint32_t                 m_numPatchBuckets = 0;     //!< number of buckets used by the current submission
+
+    //! \brief    Softpin targets of one command buffer bo, deduplicated by target bo
+    std::vector<std::pair<MOS_LINUX_BO *, bool>>  m_softpinTargets;
+    std::unordered_map<MOS_LINUX_BO *, uint32_t>  m_softpinTargetIndex;
+
    //! \brief    Resource registrations
     uint32_t      m_resCount = 0;  //!< number of resources registered
     PMOS_RESOURCE m_attachedResources = nullptr;  //!< Pointer to resources list
+    MOS_LINUX_BO **m_attachedBos      = nullptr;  //!< Bo of each registered resource, scanned on registration
     bool         *m_writeModeList     = nullptr;  //!< Write mode
 
     //! \brief    GPU Status tag
@@ -31,6 +31,7 @@
 #include "mos_context_specific_next.h"
 #include "mos_os_specific_next.h"
 #include "memory_policy_manager.h"
+#include "mos_cpu_profiler.h"
 
 GraphicsResourceSpecificNext::GraphicsResourceSpecificNext()
 {
@@ -40,6 +41,9 @@ GraphicsResourceSpecificNext::GraphicsResourceSpecificNext()
 GraphicsResourceSpecificNext::~GraphicsResourceSpecificNext()
 {
     MOS_OS_FUNCTION_ENTER;
+
+    MOS_FreeMemory(m_systemShadow);
+    m_systemShadow = nullptr;
 }
 
 bool GraphicsResourceSpecificNext::ResourceIsNull()
@@ -296,6 +300,11 @@ MOS_STATUS GraphicsResourceSpecificNext::Allocate(OsContextNext* osContextPtr, C
         m_mapped        = false;
         m_mmapOperation = MOS_MMAP_OPERATION_NONE;
 
+        m_persistentMap  = params.m_flags.bPersistentMap &&
+                           tileFormatLinux == I915_TILING_NONE &&
+                           params.m_pSystemMemory == nullptr;
+        m_persistentData = nullptr;
+
         m_arraySize = 1;
         m_depth     = MOS_MAX(1, gmmResourceInfoPtr->GetBaseDepth());
         m_size      = (uint32_t)gmmResourceInfoPtr->GetSizeSurface();
@@ -368,8 +377,16 @@ void GraphicsResourceSpecificNext::Free(OsContextNext* osContextPtr, uint32_t  f
         {
             auxTableMgr->UnmapResource(m_gmmResInfo, boPtr);
         }
+        if (m_persistentData)
+        {
+            mos_gem_bo_unmap_wc(boPtr);
+            m_persistentData = nullptr;
+        }
         mos_bo_unreference(boPtr);
         m_bo = nullptr;
+        MOS_FreeMemory(m_systemShadow);
+        m_systemShadow = nullptr;
+        m_shadowTileRows.Clear();
         if (nullptr != m_gmmResInfo)
         {
             pOsContextSpecific->GetGmmClientContext()->DestroyResInfoObject(m_gmmResInfo);
@@ -430,9 +447,41 @@ MOS_STATUS GraphicsResourceSpecificNext::ConvertToMosResource(MOS_RESOURCE* pMos
     return  MOS_STATUS_SUCCESS;
 }
 
+bool GraphicsResourceSpecificNext::LockPersistent()
+{
+    if (m_persistentData == nullptr)
+    {
+        // WC keeps CPU accesses coherent with the GPU, so no later lock needs a domain change
+        if (mos_gem_bo_map_wc(m_bo) != 0 || m_bo->virt == nullptr)
+        {
+            // e.g. no WC mmap support, stay on the regular map path which counts the map
+            m_persistentMap = false;
+            return false;
+        }
+        MosCpuProfiler::Count(MOS_CPU_PROFILE_COUNTER_LOCK_MAP);
+        m_persistentData = (uint8_t *)m_bo->virt;
+    }
+    else
+    {
+        // answered from the bufmgr idle flag without an ioctl unless the BO was submitted since
+        MosCpuProfiler::Count(MOS_CPU_PROFILE_COUNTER_LOCK_BUSY_CHECK);
+        if (mos_bo_busy(m_bo))
+        {
+            MosCpuProfiler::Count(MOS_CPU_PROFILE_COUNTER_LOCK_WAIT);
+            mos_gem_bo_wait(m_bo, -1);
+        }
+    }
+
+    m_mmapOperation = MOS_MMAP_OPERATION_MMAP_WC;
+    m_mapped        = true;
+    m_pData         = m_persistentData;
+    return true;
+}
+
 void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams& params)
 {
     MOS_OS_FUNCTION_ENTER;
+    MOS_CPU_PROFILE_SCOPE(MOS_CPU_PROFILE_RESOURCE_LOCK);
 
     if (osContextPtr == nullptr)
     {
@@ -474,8 +523,14 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
             mosDecompression->MemoryDecompress(&mosResource);
         }
 
+        if (false == m_mapped && m_persistentMap && !pOsContextSpecific->IsAtomSoc())
+        {
+            LockPersistent();
+        }
+
         if(false == m_mapped)
         {
+            MosCpuProfiler::Count(MOS_CPU_PROFILE_COUNTER_LOCK_MAP);
             if (pOsContextSpecific->IsAtomSoc())
             {
                 mos_gem_bo_map_gtt(boPtr);
@@ -495,13 +550,14 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                         }
                         if (m_systemShadow)
                         {
-                            int32_t flags = pOsContextSpecific->GetTileYFlag() ? 0 : 1;
                             uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
                             MOS_OS_CHECK_CONDITION((m_tileType != MOS_TILE_Y), "Unsupported tile type", nullptr);
                             MOS_OS_CHECK_CONDITION((boPtr->size <= 0 || m_pitch <= 0), "Invalid BO size or pitch", nullptr);
-                            MosUtilities::MosSwizzleData((uint8_t*)boPtr->virt, m_systemShadow,
-                                            MOS_TILE_Y, MOS_TILE_LINEAR,
-                                            (int32_t)(surfSize / m_pitch), m_pitch, flags);
+                            // The BO may have been written by GPU since the last map, so every tile row
+                            // starts invalid and only the rows covering locked regions are de-swizzled
+                            m_shadowTileRows.Reset((uint8_t *)boPtr->virt, m_systemShadow,
+                                (uint32_t)(surfSize / m_pitch), m_pitch,
+                                pOsContextSpecific->GetTileYFlag() ? 0 : 1);
                         }
                     }
                     else
@@ -522,7 +578,15 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                 }
             }
             m_mapped = true;
-            m_pData  = m_systemShadow ? m_systemShadow : (uint8_t *)boPtr->virt;
+            // the shadow is kept across map cycles, so tile row state tells whether this cycle uses it
+            m_pData  = m_shadowTileRows.IsActive() ? m_systemShadow : (uint8_t *)boPtr->virt;
+        }
+
+        if (m_shadowTileRows.IsActive())
+        {
+            // lock without read/write hint is taken as read-write
+            m_shadowTileRows.Prepare(params.m_rowStart, params.m_rowNum,
+                params.m_writeRequest || !params.m_readRequest);
         }
 
         dataPtr = m_pData;
@@ -553,7 +617,13 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
     MOS_LINUX_BO* boPtr = m_bo;
     if (boPtr)
     {
-        if (m_mapped)
+        if (m_mapped && m_persistentData)
+        {
+            // the mapping stays for the next lock
+            m_mapped        = false;
+            m_mmapOperation = MOS_MMAP_OPERATION_NONE;
+        }
+        else if (m_mapped)
         {
            if (pOsContextSpecific->IsAtomSoc())
            {
@@ -562,15 +632,11 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
            else
            {
 
-               if (m_systemShadow)
+               if (m_systemShadow && m_shadowTileRows.IsActive())
                {
-                   int32_t flags = pOsContextSpecific->GetTileYFlag() ? 0 : 1;
-                   uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
-                   MosUtilities::MosSwizzleData(m_systemShadow, (uint8_t*)boPtr->virt,
-                                   MOS_TILE_LINEAR, MOS_TILE_Y,
-                                   (int32_t)(surfSize / m_pitch), m_pitch, flags);
-                   MOS_FreeMemory(m_systemShadow);
-                   m_systemShadow = nullptr;
+                   // the shadow allocation is kept for the next lock, only its content is dropped
+                   m_shadowTileRows.Flush();
+                   m_shadowTileRows.Clear();
                }
 
                switch(m_mmapOperation)
@@ -603,6 +669,112 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
     return MOS_STATUS_SUCCESS;
 }
 
+void MosShadowTileRows::Reset(uint8_t *tiled, uint8_t *linear, uint32_t rowNum, uint32_t pitch, int32_t swizzleFlags)
+{
+    m_tiled        = tiled;
+    m_linear       = linear;
+    m_rowNum       = rowNum;
+    m_pitch        = pitch;
+    m_swizzleFlags = swizzleFlags;
+    m_state.assign(MOS_ROUNDUP_DIVIDE(rowNum, m_tileRowHeight), 0);
+}
+
+void MosShadowTileRows::Clear()
+{
+    m_state.clear();
+}
+
+void MosShadowTileRows::Prepare(uint32_t rowStart, uint32_t rowNum, bool write)
+{
+    uint32_t rowEnd = m_rowNum;
+    if (rowNum)
+    {
+        rowStart = MOS_MIN(rowStart, m_rowNum);
+        rowEnd   = MOS_MIN(rowStart + rowNum, m_rowNum);
+    }
+    else
+    {
+        rowStart = 0;
+    }
+    uint32_t tileRowStart = rowStart / m_tileRowHeight;
+    uint32_t tileRowEnd   = MOS_ROUNDUP_DIVIDE(rowEnd, m_tileRowHeight);
+
+    // de-swizzle each run of invalid tile rows with one call
+    uint32_t tileRow = tileRowStart;
+    while (tileRow < tileRowEnd)
+    {
+        if (m_state[tileRow] & m_tileRowValid)
+        {
+            tileRow++;
+            continue;
+        }
+        uint32_t runEnd = tileRow + 1;
+        while (runEnd < tileRowEnd && !(m_state[runEnd] & m_tileRowValid))
+        {
+            runEnd++;
+        }
+        Swizzle(tileRow, runEnd, true);
+        for (; tileRow < runEnd; tileRow++)
+        {
+            m_state[tileRow] |= m_tileRowValid;
+        }
+    }
+
+    if (write)
+    {
+        for (tileRow = tileRowStart; tileRow < tileRowEnd; tileRow++)
+        {
+            m_state[tileRow] |= m_tileRowDirty;
+        }
+    }
+}
+
+void MosShadowTileRows::Flush()
+{
+    uint32_t tileRowNum = (uint32_t)m_state.size();
+    uint32_t tileRow    = 0;
+    while (tileRow < tileRowNum)
+    {
+        if (!(m_state[tileRow] & m_tileRowDirty))
+        {
+            tileRow++;
+            continue;
+        }
+        uint32_t runEnd = tileRow + 1;
+        while (runEnd < tileRowNum && (m_state[runEnd] & m_tileRowDirty))
+        {
+            runEnd++;
+        }
+        Swizzle(tileRow, runEnd, false);
+        for (; tileRow < runEnd; tileRow++)
+        {
+            m_state[tileRow] &= ~m_tileRowDirty;
+        }
+    }
+}
+
+void MosShadowTileRows::Swizzle(uint32_t tileRowStart, uint32_t tileRowEnd, bool toShadow)
+{
+    // tile rows are laid out one after another in the tiled surface, so a run of them is
+    // swizzled as a standalone surface starting at the same offset in both surfaces
+    uint32_t rowStart = tileRowStart * m_tileRowHeight;
+    uint32_t rowEnd   = MOS_MIN(tileRowEnd * m_tileRowHeight, m_rowNum);
+    uint64_t offset   = (uint64_t)rowStart * m_pitch;
+    uint8_t *tiled    = m_tiled + offset;
+    uint8_t *linear   = m_linear + offset;
+
+    if (toShadow)
+    {
+        MosUtilities::MosSwizzleData(tiled, linear, MOS_TILE_Y, MOS_TILE_LINEAR,
+                        (int32_t)(rowEnd - rowStart), m_pitch, m_swizzleFlags);
+    }
+    else
+    {
+        MosUtilities::MosSwizzleData(linear, tiled, MOS_TILE_LINEAR, MOS_TILE_Y,
+                        (int32_t)(rowEnd - rowStart), m_pitch, m_swizzleFlags);
+    }
+}
+
 MOS_STATUS GraphicsResourceSpecificNext::AllocateExternalResource(
     MOS_STREAM_HANDLE streamState,
     PMOS_ALLOC_GFXRES_PARAMS params,
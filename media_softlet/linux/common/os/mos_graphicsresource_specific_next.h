@@ -27,8 +27,78 @@
 #ifndef __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
 #define __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
 
+#include <vector>
 #include "mos_graphicsresource_next.h"
 
+//!
+//! \brief  Valid/dirty state of the tile rows of a s/w untiling shadow
+//! \details The linear shadow is converted from and to the TileY surface one run of
+//!          tile rows at a time, so only the tile rows covering locked rows are
+//!          de-swizzled, and only the written ones are swizzled back.
+//!
+class MosShadowTileRows
+{
+public:
+    //!
+    //! \brief  Start a map cycle with every tile row invalid
+    //! \param  [in] tiled
+    //!         TileY surface
+    //! \param  [in] linear
+    //!         Linear shadow of the same size
+    //! \param  [in] rowNum
+    //!         Rows of the surface
+    //! \param  [in] pitch
+    //!         Pitch of the surface
+    //! \param  [in] swizzleFlags
+    //!         Flags passed to MosSwizzleData
+    //!
+    void Reset(uint8_t *tiled, uint8_t *linear, uint32_t rowNum, uint32_t pitch, int32_t swizzleFlags);
+
+    //!
+    //! \brief  End the map cycle without writing back
+    //!
+    void Clear();
+
+    //!
+    //! \brief  Check whether a map cycle is in progress
+    //!
+    bool IsActive() const { return !m_state.empty(); }
+
+    //!
+    //! \brief  De-swizzle the tile rows covering rows [rowStart, rowStart + rowNum)
+    //! \details Tile rows already de-swizzled in this map cycle are skipped
+    //! \param  [in] rowStart
+    //!         First row locked
+    //! \param  [in] rowNum
+    //!         Number of rows locked, 0 for the whole surface
+    //! \param  [in] write
+    //!         Mark the tile rows dirty for Flush
+    //!
+    void Prepare(uint32_t rowStart, uint32_t rowNum, bool write);
+
+    //!
+    //! \brief  Swizzle the dirty tile rows back to the TileY surface
+    //!
+    void Flush();
+
+private:
+    //!
+    //! \brief  Convert a run of tile rows between the TileY surface and the shadow
+    //!
+    void Swizzle(uint32_t tileRowStart, uint32_t tileRowEnd, bool toShadow);
+
+    static const uint32_t m_tileRowHeight = 32;     //!< Rows of one TileY tile row
+    static const uint8_t  m_tileRowValid  = 0x1;    //!< Tile row de-swizzled into the shadow
+    static const uint8_t  m_tileRowDirty  = 0x2;    //!< Tile row to be swizzled back on flush
+
+    std::vector<uint8_t> m_state;                   //!< Valid/dirty state of each tile row
+    uint8_t  *m_tiled        = nullptr;             //!< TileY surface
+    uint8_t  *m_linear       = nullptr;             //!< Linear shadow
+    uint32_t  m_rowNum       = 0;                   //!< Rows of the surface
+    uint32_t  m_pitch        = 0;                   //!< Pitch of the surface
+    int32_t   m_swizzleFlags = 0;                   //!< Swizzle flags of the current map cycle
+};
+
 class GraphicsResourceSpecificNext : public GraphicsResourceNext
 {
 public:
@@ -242,7 +312,19 @@ private:
     //!
     HybridSem m_hybridSem = {};
 
-    uint8_t*  m_systemShadow = nullptr;     //!< System shadow surface for s/w untiling
+    //!
+    //! \brief  Lock through the persistent WC mapping of a bPersistentMap resource
+    //! \details The mapping is created on the first lock and kept until Free. Later locks
+    //!          only wait for the BO to be idle instead of moving it to the CPU domain.
+    //! \return true if locked, false to fall back to the regular map
+    //!
+    bool LockPersistent();
+
+    bool      m_persistentMap  = false;     //!< Allocated with bPersistentMap
+    uint8_t*  m_persistentData = nullptr;   //!< Persistent WC mapping, kept until Free
+
+    uint8_t*  m_systemShadow = nullptr;     //!< System shadow surface for s/w untiling, kept until Free
+    MosShadowTileRows m_shadowTileRows;     //!< Tile rows of the system shadow in the current map cycle
 };
 #endif // #ifndef __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
 
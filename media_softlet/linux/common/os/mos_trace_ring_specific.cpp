@@ -0,0 +1,433 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_trace_ring_specific.cpp
+//! \brief       Per-thread ring buffer backend for MOS trace events on Linux.
+//!
+
+#include "mos_trace_ring_specific.h"
+#include "mos_utilities.h"
+#include "mos_util_debug.h"
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+const uint32_t c_ringSize        = 1 << 20;             //!< Per-thread ring size, power of 2
+const uint32_t c_maxRecordSize   = c_ringSize / 4;
+const uint64_t c_fileChunkSize   = 64ull << 20;         //!< Output file grows in this granularity
+const uint32_t c_drainIntervalMs = 10;
+const uint32_t c_calibrationUs   = 5000;                //!< Interval used to measure the tick rate at init
+
+//!
+//! \brief Single producer single consumer ring owned by one tracing thread
+//!
+struct TraceRing
+{
+    alignas(64) std::atomic<uint64_t> head{0};  //!< Written by the owner thread only
+    alignas(64) std::atomic<uint64_t> tail{0};  //!< Written by the drain thread only
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool>     exited{false};
+    uint32_t              tid = 0;
+    uint8_t               buf[c_ringSize];
+};
+
+struct TraceRingRegistry
+{
+    std::mutex                  ringMutex;      //!< Protects rings, taken on thread registration and drain
+    std::vector<TraceRing *>    rings;
+
+    std::mutex                  drainMutex;
+    std::condition_variable     drainCond;
+    bool                        stop = false;
+    std::thread                 drainThread;
+
+    int                         fd      = -1;
+    uint8_t                     *map    = nullptr;
+    uint64_t                    mapSize = 0;
+    uint64_t                    offset  = 0;
+    uint64_t                    dropped = 0;
+    MOS_TRACE_RING_FILE_HEADER  header  = {};
+};
+
+// Trivially destructible so they stay valid for the whole thread exit sequence
+thread_local TraceRing *t_ring         = nullptr;
+thread_local bool       t_ringReleased = false;
+
+//!
+//! \brief Releases the ring when its owner thread exits
+//! \details Events written by thread_local destructors running after this one
+//!          are dropped instead of touching a ring the drain thread may free.
+//!
+struct TraceRingHolder
+{
+    ~TraceRingHolder()
+    {
+        t_ringReleased = true;
+        if (t_ring)
+        {
+            t_ring->exited.store(true, std::memory_order_release);
+            t_ring = nullptr;
+        }
+    }
+};
+
+thread_local TraceRingHolder t_ringHolder;
+
+TraceRingRegistry &GetRegistry()
+{
+    // Intentionally never destroyed, threads may still exit after static destruction.
+    static TraceRingRegistry *registry = new TraceRingRegistry;
+    return *registry;
+}
+
+inline uint64_t GetTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+inline uint64_t GetMonotonicNs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+//!
+//! \brief Measure the timestamp counter frequency so that an unfinalized file can still be decoded
+//!
+uint64_t CalibrateTicksPerSec()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t startNs    = GetMonotonicNs();
+    uint64_t startTicks = GetTicks();
+    usleep(c_calibrationUs);
+    uint64_t endTicks   = GetTicks();
+    uint64_t endNs      = GetMonotonicNs();
+    if (endNs <= startNs)
+    {
+        return 0;
+    }
+    return (endTicks - startTicks) * 1000000000ull / (endNs - startNs);
+#else
+    return 1000000000ull;
+#endif
+}
+
+inline void CopyToRing(TraceRing *ring, uint64_t pos, const void *src, uint32_t size)
+{
+    uint32_t offset = pos & (c_ringSize - 1);
+    uint32_t first  = MOS_MIN(size, c_ringSize - offset);
+    memcpy(ring->buf + offset, src, first);
+    if (first < size)
+    {
+        memcpy(ring->buf, (const uint8_t *)src + first, size - first);
+    }
+}
+
+TraceRing *RegisterThread()
+{
+    if (t_ringReleased)
+    {
+        return nullptr;
+    }
+
+    TraceRing *ring = new (std::nothrow) TraceRing;
+    if (ring == nullptr)
+    {
+        return nullptr;
+    }
+    ring->tid = (uint32_t)syscall(SYS_gettid);
+
+    TraceRingRegistry &reg = GetRegistry();
+    std::lock_guard<std::mutex> lock(reg.ringMutex);
+    reg.rings.push_back(ring);
+    // Touch the holder so its destructor is registered for this thread
+    (void)&t_ringHolder;
+    t_ring = ring;
+    return ring;
+}
+
+bool EnsureFileCapacity(TraceRingRegistry &reg, uint64_t required)
+{
+    if (required <= reg.mapSize)
+    {
+        return true;
+    }
+
+    uint64_t newSize = MOS_ALIGN_CEIL(required, c_fileChunkSize);
+    if (reg.map)
+    {
+        munmap(reg.map, reg.mapSize);
+        reg.map     = nullptr;
+        reg.mapSize = 0;
+    }
+    if (ftruncate(reg.fd, newSize) != 0)
+    {
+        return false;
+    }
+    void *map = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, reg.fd, 0);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+    reg.map     = (uint8_t *)map;
+    reg.mapSize = newSize;
+    return true;
+}
+
+//!
+//! \brief Move all pending records to the output file and free rings of exited threads
+//!
+void DrainRings(TraceRingRegistry &reg)
+{
+    std::lock_guard<std::mutex> lock(reg.ringMutex);
+
+    for (auto it = reg.rings.begin(); it != reg.rings.end();)
+    {
+        TraceRing *ring = *it;
+        // Read the exit flag before head so no record written before exit is missed
+        bool     exited = ring->exited.load(std::memory_order_acquire);
+        uint64_t head   = ring->head.load(std::memory_order_acquire);
+        uint64_t tail   = ring->tail.load(std::memory_order_relaxed);
+        uint64_t size   = head - tail;
+
+        if (size > 0 && EnsureFileCapacity(reg, reg.offset + size))
+        {
+            uint32_t offset = tail & (c_ringSize - 1);
+            uint32_t first  = (uint32_t)MOS_MIN(size, (uint64_t)(c_ringSize - offset));
+            memcpy(reg.map + reg.offset, ring->buf + offset, first);
+            if (first < size)
+            {
+                memcpy(reg.map + reg.offset + first, ring->buf, size - first);
+            }
+            reg.offset += size;
+        }
+        ring->tail.store(head, std::memory_order_release);
+
+        if (exited)
+        {
+            reg.dropped += ring->dropped.load(std::memory_order_relaxed);
+            delete ring;
+            it = reg.rings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void DrainThreadFunc()
+{
+    TraceRingRegistry &reg = GetRegistry();
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(reg.drainMutex);
+            reg.drainCond.wait_for(lock, std::chrono::milliseconds(c_drainIntervalMs), [&reg] { return reg.stop; });
+            if (reg.stop)
+            {
+                break;
+            }
+        }
+        DrainRings(reg);
+    }
+}
+}  // namespace
+
+std::atomic<bool> MosTraceRing::m_enabled(false);
+
+bool MosTraceRing::Init(const char *filePath)
+{
+    if (filePath == nullptr || IsEnabled())
+    {
+        return IsEnabled();
+    }
+
+    TraceRingRegistry &reg = GetRegistry();
+    std::string        path;
+
+    // Never overwrite the file of an earlier Init in this process (or of a
+    // previous process with the same pid), the first free sequence number wins.
+    for (uint32_t seq = 0; ; seq++)
+    {
+        path = std::string(filePath) + "." + std::to_string(getpid());
+        if (seq)
+        {
+            path += "." + std::to_string(seq);
+        }
+        reg.fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (reg.fd >= 0 || errno != EEXIST)
+        {
+            break;
+        }
+    }
+    if (reg.fd < 0)
+    {
+        MOS_OS_ASSERTMESSAGE("Failed to open trace ring file '%s'. Error = %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    MOS_ZeroMemory(&reg.header, sizeof(reg.header));
+    reg.header.magic       = MOS_TRACE_RING_FILE_MAGIC;
+    reg.header.version     = MOS_TRACE_RING_FILE_VERSION;
+    reg.header.headerSize  = sizeof(MOS_TRACE_RING_FILE_HEADER);
+    reg.header.pid         = (uint32_t)getpid();
+    reg.header.ticksPerSec = CalibrateTicksPerSec();
+    reg.header.baseNs      = GetMonotonicNs();
+    reg.header.baseTicks   = GetTicks();
+    reg.offset             = sizeof(MOS_TRACE_RING_FILE_HEADER);
+    reg.dropped            = 0;
+
+    if (!EnsureFileCapacity(reg, reg.offset))
+    {
+        close(reg.fd);
+        reg.fd = -1;
+        return false;
+    }
+    // Header is rewritten at close, the early copy lets a crashed process' file be decoded
+    memcpy(reg.map, &reg.header, sizeof(reg.header));
+
+    {
+        // Rings of live threads survive a previous Close, discard what they hold
+        std::lock_guard<std::mutex> lock(reg.ringMutex);
+        for (auto ring : reg.rings)
+        {
+            ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+            ring->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    reg.stop        = false;
+    reg.drainThread = std::thread(DrainThreadFunc);
+    m_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void MosTraceRing::Close()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+    m_enabled.store(false, std::memory_order_release);
+
+    TraceRingRegistry &reg = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(reg.drainMutex);
+        reg.stop = true;
+    }
+    reg.drainCond.notify_all();
+    if (reg.drainThread.joinable())
+    {
+        reg.drainThread.join();
+    }
+
+    DrainRings(reg);
+    {
+        std::lock_guard<std::mutex> lock(reg.ringMutex);
+        for (auto ring : reg.rings)
+        {
+            reg.dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    reg.header.endTicks = GetTicks();
+    reg.header.endNs    = GetMonotonicNs();
+    reg.header.dataSize = reg.offset - sizeof(MOS_TRACE_RING_FILE_HEADER);
+    reg.header.dropped  = reg.dropped;
+
+    if (reg.map)
+    {
+        munmap(reg.map, reg.mapSize);
+        reg.map     = nullptr;
+        reg.mapSize = 0;
+    }
+    if (ftruncate(reg.fd, reg.offset) != 0 ||
+        pwrite(reg.fd, &reg.header, sizeof(reg.header), 0) != sizeof(reg.header))
+    {
+        MOS_OS_ASSERTMESSAGE("Failed to finalize trace ring file. Error = %s", strerror(errno));
+    }
+    close(reg.fd);
+    reg.fd = -1;
+
+    if (reg.dropped)
+    {
+        MOS_OS_NORMALMESSAGE("Trace ring dropped %lu events.", (unsigned long)reg.dropped);
+    }
+}
+
+void MosTraceRing::Write(const void *data, uint32_t size)
+{
+    uint32_t recordSize = MOS_ALIGN_CEIL(sizeof(MOS_TRACE_RING_RECORD_HEADER) + size, 8);
+    if (data == nullptr || recordSize > c_maxRecordSize)
+    {
+        return;
+    }
+
+    TraceRing *ring = t_ring;
+    if (ring == nullptr)
+    {
+        ring = RegisterThread();
+        if (ring == nullptr)
+        {
+            return;
+        }
+    }
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head + recordSize - tail > c_ringSize)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    MOS_TRACE_RING_RECORD_HEADER record = {};
+    record.ticks = GetTicks();
+    record.tid   = ring->tid;
+    record.size  = size;
+    CopyToRing(ring, head, &record, sizeof(record));
+    CopyToRing(ring, head + sizeof(record), data, size);
+    ring->head.store(head + recordSize, std::memory_order_release);
+}
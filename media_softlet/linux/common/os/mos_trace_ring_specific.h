@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_trace_ring_specific.h
+//! \brief       Per-thread ring buffer backend for MOS trace events on Linux.
+//! \details     Each tracing thread owns a single producer ring which is drained
+//!              by a background thread into a memory mapped binary file. The file
+//!              can be converted to Chrome trace / Perfetto JSON with
+//!              Tools/MediaDriverTools/MediaTraceDecoder.
+//!
+#ifndef __MOS_TRACE_RING_SPECIFIC_H__
+#define __MOS_TRACE_RING_SPECIFIC_H__
+
+#include <atomic>
+#include <stdint.h>
+
+#define MOS_TRACE_RING_FILE_MAGIC       0x52544D49  // "IMTR"
+#define MOS_TRACE_RING_FILE_VERSION     2
+
+//!
+//! \brief Header at the start of the ring trace file
+//!
+struct MOS_TRACE_RING_FILE_HEADER
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t pid;
+    uint32_t reserved;
+    uint64_t baseTicks;     //!< Timestamp counter value at init
+    uint64_t baseNs;        //!< CLOCK_MONOTONIC in ns at init
+    uint64_t endTicks;      //!< Timestamp counter value at close
+    uint64_t endNs;         //!< CLOCK_MONOTONIC in ns at close
+    uint64_t dataSize;      //!< Bytes of records following the header
+    uint64_t dropped;       //!< Events dropped because a ring was full
+    uint64_t ticksPerSec;   //!< Timestamp counter frequency measured at init
+};
+
+//!
+//! \brief Header of each record, followed by the IMTE event bytes padded to 8 bytes
+//!
+struct MOS_TRACE_RING_RECORD_HEADER
+{
+    uint64_t ticks;
+    uint32_t tid;
+    uint32_t size;
+};
+
+class MosTraceRing
+{
+public:
+    //!
+    //! \brief    Create the output file and start the drain thread
+    //! \param    [in] filePath
+    //!           Output file prefix, the process id and for a re-init a
+    //!           sequence number are appended
+    //! \return   bool
+    //!           true if the backend is enabled
+    //!
+    static bool Init(const char *filePath);
+
+    //!
+    //! \brief    Drain all rings, finalize the output file and stop the drain thread
+    //!
+    static void Close();
+
+    //!
+    //! \brief    Check whether the ring backend is active
+    //!
+    static bool IsEnabled()
+    {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    //!
+    //! \brief    Append one event to the calling thread's ring
+    //! \details  Never blocks and never issues a syscall except on the first
+    //!           event of a thread. The event is dropped if the ring is full.
+    //! \param    [in] data
+    //!           IMTE formatted event
+    //! \param    [in] size
+    //!           Event size in bytes
+    //!
+    static void Write(const void *data, uint32_t size);
+
+private:
+    static std::atomic<bool> m_enabled;
+};
+
+#endif // __MOS_TRACE_RING_SPECIFIC_H__
@@ -34,6 +34,7 @@
 #include <time.h>      // get_clocktime
 #include <sys/stat.h>  // fstat
 #include <dlfcn.h>     // dlopen, dlsym, dlclose
+#include <sys/inotify.h> // inotify_init1, inotify_add_watch
 #include <sys/types.h>
 #include <unistd.h>
 #if _MEDIA_RESERVED
@@ -41,6 +42,7 @@
 #include "vphal_user_settings_mgr_ext.h"
 #endif // _MEDIA_RESERVED
 #include "mos_user_setting.h"
+#include "mos_trace_ring_specific.h"
 
 #include <sys/ipc.h>  // System V IPC
 #include <sys/types.h>
@@ -91,6 +93,30 @@ MosMutex          MosUtilitiesSpecificNext::m_userSettingMutex;
 #define TRACE_EVENT_HEADER_SIZE        (sizeof(uint32_t)*3)
 #define TRACE_EVENT_MAX_DATA_SIZE      (TRACE_EVENT_MAX_SIZE - TRACE_EVENT_HEADER_SIZE - sizeof(uint16_t)) // Trace info data size section is in uint16_t
 
+//!
+//! \brief Check whether any trace backend, ftrace marker or ring buffer, is active
+//!
+static inline bool MosTraceEnabled()
+{
+    return MosUtilitiesSpecificNext::m_mosTraceFd >= 0 || MosTraceRing::IsEnabled();
+}
+
+//!
+//! \brief Send one IMTE formatted event to the active trace backend
+//!
+static inline void MosTraceWriteEvent(const void *buf, uint32_t size)
+{
+    if (MosTraceRing::IsEnabled())
+    {
+        MosTraceRing::Write(buf, size);
+    }
+    else if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0)
+    {
+        size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, buf, size);
+        MOS_UNUSED(writeSize);
+    }
+}
+
 //!
 //! \brief for int64_t/uint64_t format print warning
 //!
@@ -1610,6 +1636,90 @@ MOS_STATUS MosUtilities::MosUninitializeReg(RegBufferMap &regBufferMap)
     return status;
 }
 
+//!
+//! \brief    Watch the reg file itself
+//! \details  A watch follows the inode, so it has to be added again after
+//!           the file is deleted or replaced by a rename
+//!
+static int32_t MosAddRegFileWatch(int32_t watchHandle)
+{
+    return inotify_add_watch(watchHandle, USER_FEATURE_FILE_NEXT, IN_CLOSE_WRITE | IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF);
+}
+
+int32_t MosUtilities::MosWatchRegFile()
+{
+    int32_t fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (MosAddRegFileWatch(fd) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool MosUtilities::MosIsRegFileChanged(int32_t watchHandle)
+{
+    if (watchHandle < 0)
+    {
+        return false;
+    }
+
+    const std::string filePath = USER_FEATURE_FILE_NEXT;
+    const std::string dirPath  = filePath.substr(0, filePath.find_last_of('/') + 1);
+    const std::string fileName = filePath.substr(dirPath.size());
+
+    bool    changed = false;
+    bool    rearm   = false;
+    char    events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t size    = 0;
+    while ((size = read(watchHandle, events, sizeof(events))) > 0)
+    {
+        for (char *ptr = events; ptr < events + size; ptr += sizeof(struct inotify_event) + ((struct inotify_event *)ptr)->len)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)ptr;
+            if (event->len > 0)
+            {
+                // Event of the directory watch waiting for the file to come back
+                if (fileName == event->name)
+                {
+                    inotify_rm_watch(watchHandle, event->wd);
+                    changed = true;
+                    rearm   = true;
+                }
+                continue;
+            }
+
+            changed = true;
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_Q_OVERFLOW))
+            {
+                rearm = true;
+            }
+        }
+    }
+
+    if (rearm && MosAddRegFileWatch(watchHandle) < 0)
+    {
+        // The file is gone for now, get notified when it is created again
+        inotify_add_watch(watchHandle, dirPath.c_str(), IN_CREATE | IN_MOVED_TO);
+    }
+
+    return changed;
+}
+
+void MosUtilities::MosUnwatchRegFile(int32_t watchHandle)
+{
+    if (watchHandle >= 0)
+    {
+        close(watchHandle);
+    }
+}
+
 MOS_STATUS MosUtilities::MosCreateRegKey(
     UFKEY_NEXT keyHandle,
     const std::string &subKey,
@@ -2343,12 +2453,20 @@ void MosUtilities::MosTraceEventInit()
         close(MosUtilitiesSpecificNext::m_mosTraceFd);
         MosUtilitiesSpecificNext::m_mosTraceFd = -1;
     }
+    MosTraceRing::Close();
+    // GFX_MEDIA_TRACE_RING selects the low overhead ring buffer backend instead of ftrace
+    char *ringPath = getenv("GFX_MEDIA_TRACE_RING");
+    if (ringPath && MosTraceRing::Init(ringPath))
+    {
+        return;
+    }
     MosUtilitiesSpecificNext::m_mosTraceFd = open(MosUtilitiesSpecificNext::m_mosTracePath, O_WRONLY);
     return;
 }
 
 void MosUtilities::MosTraceEventClose()
 {
+    MosTraceRing::Close();
     if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0)
     {
         close(MosUtilitiesSpecificNext::m_mosTraceFd);
@@ -2364,7 +2482,7 @@ void MosUtilities::MosTraceSetupInfo(uint32_t DrvVer, uint32_t PlatFamily, uint3
 
 uint64_t MosUtilities::GetTraceEventKeyword()
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0)
+    if (MosTraceEnabled())
     {
         return MosUtilitiesSpecificNext::m_traceKeyword;
     }
@@ -2379,7 +2497,7 @@ void MosUtilities::MosTraceEvent(
     const void       *pArg2,
     uint32_t         dwSize2)
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 &&
+    if (MosTraceEnabled() &&
         TRACE_EVENT_MAX_SIZE > dwSize1 + dwSize2 + TRACE_EVENT_HEADER_SIZE)
     {
         uint8_t traceBuf[256];
@@ -2424,7 +2542,7 @@ void MosUtilities::MosTraceEvent(
                 memcpy(pTraceBuf+nLen, pArg2, dwSize2);
                 nLen += dwSize2;
             }
-            size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+            MosTraceWriteEvent(pTraceBuf, nLen);
             if (traceBuf != pTraceBuf)
             {
                 MOS_FreeMemory(pTraceBuf);
@@ -2449,11 +2567,9 @@ void MosUtilities::MosTraceDataDump(
     const void *pBuf,
     uint32_t    dwSize)
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 && pBuf && pcName && (MosUtilitiesSpecificNext::m_traceKeyword & DATA_DUMP_KEYWORD))
+    if (MosTraceEnabled() && pBuf && pcName && (MosUtilitiesSpecificNext::m_traceKeyword & DATA_DUMP_KEYWORD))
     {
         uint8_t *pTraceBuf = (uint8_t *)MOS_AllocAndZeroMemory(TRACE_EVENT_MAX_SIZE);
-        size_t writeSize = 0;
-
         if (pTraceBuf)
         {
             // trace header
@@ -2467,7 +2583,7 @@ void MosUtilities::MosTraceDataDump(
             header[4] = flags;
             memcpy(&header[5], pcName, nLen);
             nLen += TRACE_EVENT_HEADER_SIZE + 8 + 1;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+            MosTraceWriteEvent(pTraceBuf, nLen);
             // send dump data
             header[2] = EVENT_TYPE_INFO;
             const uint8_t *pData = static_cast<const uint8_t *>(pBuf);
@@ -2485,14 +2601,14 @@ void MosUtilities::MosTraceDataDump(
                 memcpy(pDst, &len, sizeof(len));
                 memcpy(pDst+sizeof(len), pData, size);
                 nLen = TRACE_EVENT_HEADER_SIZE + size + sizeof(len);
-                writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+                MosTraceWriteEvent(pTraceBuf, nLen);
                 dwSize -= size;
                 pData += size;
             }
             // send dump end
             header[1] = EVENT_DATA_DUMP << 16;
             header[2] = EVENT_TYPE_END;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, TRACE_EVENT_HEADER_SIZE);
+            MosTraceWriteEvent(pTraceBuf, TRACE_EVENT_HEADER_SIZE);
 
             MOS_FreeMemory(pTraceBuf);
         }